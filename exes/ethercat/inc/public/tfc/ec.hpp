@@ -2,19 +2,34 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <cassert>
 #include <chrono>
+#include <functional>
+#include <stop_token>
+#include <thread>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 #include <fmt/chrono.h>
+#include <sdbusplus/asio/object_server.hpp>
 #include <tfc/confman.hpp>
 #include <tfc/dbus/sd_bus.hpp>
 #include <tfc/dbus/string_maker.hpp>
+#include <tfc/ec/bus.hpp>
 #include <tfc/ec/common.hpp>
 #include <tfc/ec/config/bus.hpp>
 #include <tfc/ec/devices/device.hpp>
+#include <tfc/ec/realtime.hpp>
 #include <tfc/ec/soem_interface.hpp>
+#include <tfc/ec/supervisor.hpp>
 #include <tfc/motor/dbus_tags.hpp>
 
 namespace tfc::ec {
@@ -25,9 +40,32 @@ using std::chrono::microseconds;
 using std::chrono::milliseconds;
 using std::chrono::nanoseconds;
 
-template <size_t pdo_buffer_size = 4096>
+namespace statistics {
+static constexpr std::string_view interface{ "Ethercat.Statistics" };
+static constexpr std::string_view realtime{ "Realtime" };
+// bucket n counts cycles in [2^(n-1), 2^n) microseconds, see realtime::cycle_histogram
+static constexpr std::string_view roundtrip_histogram{ "RoundtripHistogram" };
+static constexpr std::string_view roundtrip_min{ "RoundtripMin_Nanosecond" };
+static constexpr std::string_view roundtrip_max{ "RoundtripMax_Nanosecond" };
+static constexpr std::string_view period_histogram{ "PeriodHistogram" };
+static constexpr std::string_view period_min{ "PeriodMin_Nanosecond" };
+static constexpr std::string_view period_max{ "PeriodMax_Nanosecond" };
+static constexpr std::string_view cycle_count{ "CycleCount" };
+static constexpr std::string_view cycle_time{ "CycleTime_Nanosecond" };
+// (slave index, device name, publish divisor, publish rate in Hz) of every slave
+static constexpr std::string_view publish_rates{ "PublishRates" };
+static constexpr std::string_view overruns{ "Overruns" };
+static constexpr std::string_view missed_deadlines{ "MissedDeadlines" };
+// (slave index, device name, phase, recoveries, last, max and current time out of OP in nanoseconds) of every slave
+static constexpr std::string_view slave_recovery{ "SlaveRecovery" };
+}  // namespace statistics
+
+template <size_t pdo_buffer_size = 4096, bus::bus_c bus_t = bus::soem>
 class context_t {
 public:
+  /// \brief process image, the slave pointers of SOEM point into one of these
+  using image_t = std::array<std::byte, pdo_buffer_size>;
+
   static constexpr std::string_view dbus_name{
     motor::dbus::detail::service
   };  // needs to match the name in motor/dbus_tags.hpp
@@ -41,8 +79,12 @@ public:
   // are to be addressed when our code is
   // interacting with groups.
 
-  explicit context_t(boost::asio::io_context& ctx) : ctx_(ctx), client_(ctx_) {
+  /// \param bus_args arguments of the segment backend, the virtual slaves of bus::simulated
+  template <typename... bus_args_t>
+  explicit context_t(boost::asio::io_context& ctx, bus_args_t&&... bus_args)
+      : ctx_(ctx), bus_{ std::forward<bus_args_t>(bus_args)... }, client_(ctx_) {
     dbus_->request_name(dbus::make_dbus_name(dbus_name).c_str());
+    register_statistics();
     context_.userdata = static_cast<void*>(this);
     context_.port = &port_;
     context_.slavecount = &slave_count_;
@@ -74,6 +116,10 @@ public:
       config_.make_change()->primary_interface = config::network_interface{ interfaces[0] };
     }
     logger_.trace("Network interface used: {}", config_->primary_interface.value);
+
+    apply_cycle_time(config_->cycle_time.value());
+    config_->cycle_time.observe([this](auto const& new_value, auto const&) { apply_cycle_time(new_value); });
+    config_->publish_intervals.observe([this](auto const&, auto const&) { update_publish_divisors(); });
   }
 
   context_t(const context_t&) = delete;
@@ -81,52 +127,45 @@ public:
   auto operator=(const context_t&) -> context_t& = delete;
 
   ~context_t() {
-    running_ = false;
-    if (check_thread_ != nullptr) {
-      check_thread_->join();
+    if (cycle_thread_.joinable()) {
+      cycle_thread_.request_stop();
+      cycle_thread_.join();
     }
     // Use slave 0 -> virtual for all
     // Set state to init
     slavelist_[0].state = EC_STATE_INIT;
     // Write the state
-    ecx_writestate(&context_, 0);
+    bus_.write_state(&context_, 0);
 
     // Close the context
-    ecx_close(&context_);
+    bus_.close(&context_);
   }
 
   auto processdata(std::chrono::microseconds timeout) -> ecx::working_counter_t {
-    ecx_send_overlap_processdata(&context_);
-    auto wkc = ecx::recieve_processdata(&context_, timeout);
-    std::span<std::uint8_t> input;
-    std::span<std::uint8_t> output;
-    for (size_t i = 1; i < slave_count() + 1; i++) {
-      auto& slave{ slavelist_[i] };
-      if (slave.inputs != nullptr) {
-        std::size_t input_size{ slave.Ibytes == 0 ? !!slave.Ibits : slave.Ibytes };
-        input = std::span{ slave.inputs, input_size };
-      }
-      if (slave.outputs != nullptr) {
-        std::size_t output_size{ slave.Obytes == 0 ? !!slave.Obits : slave.Obytes };
-        output = std::span{ slave.outputs, output_size };
-      }
-      if (slave.islost) {
-        slaves_[i].process_data({}, {});
-      } else {
-        slaves_[i].process_data(input, output);
-      }
-    }
-
+    auto wkc = exchange_processdata(timeout);
+    process_devices(io_);
     return wkc;
   }
 
+  /// \brief send the outputs and receive the inputs of the process image without running the devices
+  auto exchange_processdata(std::chrono::microseconds timeout) -> ecx::working_counter_t {
+    bus_.send_processdata(&context_);
+    return bus_.receive_processdata(&context_, timeout);
+  }
+
+  /// \brief run every device on a process image laid out like io_, either io_ itself or the io_context copy of it
+  void process_devices(image_t& image) {
+    dispatch_.run(reinterpret_cast<std::uint8_t*>(image.data()),
+                  [this](std::uint16_t slave) { return slavelist_[slave].islost != 0U; });
+  }
+
   /**
    * Scans the ethercat network and populates the slaves.
    * @param use_config_table bool whether to use config table or not
    * @return returns true for success
    */
   [[nodiscard]] auto config_init(bool use_config_table) -> bool {
-    if (!ecx::config_init(&context_, use_config_table)) {
+    if (!bus_.config_init(&context_, use_config_table)) {
       return false;
     }
     // Insert the base device into the vector.
@@ -139,24 +178,46 @@ public:
           devices::get(dbus_, client_, static_cast<uint16_t>(i), slavelist_[i].eep_man, slavelist_[i].eep_id));
       slaves_.back().set_sdo_write_cb([this, i](ecx::index_t idx, ecx::complete_access_t acc, std::span<std::byte> data,
                                                 std::chrono::microseconds microsec) -> ecx::working_counter_t {
-        return ecx::sdo_write(&context_, static_cast<uint16_t>(i), idx, acc, data, microsec);
+        return bus_.sdo_write(&context_, static_cast<uint16_t>(i), idx, acc, data, microsec);
       });
       slavelist_[i].PO2SOconfigx = slave_config_callback;
     }
+    update_publish_divisors();
     slave_list_as_span_with_master()[0].state = EC_STATE_PRE_OP | EC_STATE_ACK;
-    ecx_writestate(&context_, 0);
-    auto lowest = ecx::statecheck(&context_, 0, EC_STATE_PRE_OP, milliseconds(100));
+    bus_.write_state(&context_, 0);
+    auto lowest = bus_.statecheck(&context_, 0, EC_STATE_PRE_OP, milliseconds(100));
     return lowest == EC_STATE_PRE_OP || lowest == (EC_STATE_ACK | EC_STATE_PRE_OP);
   }
 
   [[nodiscard]] auto slave_count() const -> size_t { return static_cast<size_t>(slave_count_); }
 
-  auto configdc() -> bool { return ecx::configdc(&context_); }
+  /// \return whether the fieldbus cycle runs on its own thread, the same as the Realtime property
+  [[nodiscard]] auto realtime() const noexcept -> bool { return realtime_mode_; }
+
+  /// \return the current time between fieldbus cycles
+  [[nodiscard]] auto cycle_time() const noexcept -> nanoseconds { return nanoseconds{ cycle_time_.load() }; }
+
+  /// \return working counter of the last completed cycle
+  [[nodiscard]] auto working_counter() const noexcept -> ecx::working_counter_t { return wkc_; }
+  /// \return working counter of a cycle with every slave in OP
+  [[nodiscard]] auto expected_working_counter() const noexcept -> ecx::working_counter_t { return expected_wkc_; }
+
+  /// \return time between the start of consecutive cycles, the same as the PeriodHistogram property
+  [[nodiscard]] auto period_histogram() const noexcept -> realtime::cycle_histogram const& { return period_histogram_; }
+  /// \return time of the frame exchange each cycle, the same as the RoundtripHistogram property
+  [[nodiscard]] auto roundtrip_histogram() const noexcept -> realtime::cycle_histogram const& {
+    return roundtrip_histogram_;
+  }
+
+  /// \return the segment backend, to script bus::simulated
+  [[nodiscard]] auto segment() noexcept -> bus_t& { return bus_; }
+
+  auto configdc() -> bool { return bus_.configdc(&context_); }
 
   auto statecheck(uint16_t slave_index,
                   ec_state requested_state,
                   std::chrono::microseconds timeout = ecx::constants::timeout_safe) {
-    return ecx::statecheck(&context_, slave_index, requested_state, timeout);
+    return bus_.statecheck(&context_, slave_index, requested_state, timeout);
   }
 
   /**
@@ -165,7 +226,7 @@ public:
    */
   auto async_start() -> std::error_code {
     /// Config might have changed since last run
-    if (!ecx::init(&context_, config_->primary_interface.value)) {
+    if (!bus_.init(&context_, config_->primary_interface.value)) {
       // TODO: switch for error_code
       throw std::runtime_error(fmt::format("Failed to connect to interface: {}", config_->primary_interface.value));
     }
@@ -190,14 +251,15 @@ public:
       logger_.trace("Slave count is correct, current slave count: {}", slave_count());
     }
 
-    ecx::config_overlap_map_group(&context_, std::span(io_.data(), io_.size()), 0);
+    bus_.config_overlap_map_group(&context_, std::span(io_.data(), io_.size()));
+    build_dispatch_table();
 
     if (!configdc()) {
       throw std::runtime_error("Failed to configure dc");
     }
 
     slave_list_as_span_with_master()[0].state = EC_STATE_SAFE_OP;
-    ecx::write_state(&context_, 0);
+    bus_.write_state(&context_, 0);
     auto start = high_resolution_clock::now();
     auto found_state = statecheck(0, EC_STATE_SAFE_OP, milliseconds(2000));
     if (found_state != EC_STATE_SAFE_OP) {
@@ -211,29 +273,33 @@ public:
     }
 
     context_.slavelist[0].state = EC_STATE_OPERATIONAL;
-    ecx::write_state(&context_, 0);
+    bus_.write_state(&context_, 0);
 
     processdata(milliseconds{ 2000 });
     // Start async loop
     expected_wkc_ = context_.grouplist->outputsWKC * 2 + context_.grouplist->inputsWKC;
     // Start in ok
     wkc_ = expected_wkc_;
-    async_wait(true);
-    check_thread_ = std::make_unique<std::thread>(&context_t::check_state, this, 0);
+    supervisor_.reset(slave_count());
+    realtime_mode_ = config_->realtime.enabled;
+    if (realtime_mode_) {
+      start_cycle_thread(config_->realtime.priority, config_->realtime.cpu);
+    } else {
+      async_wait(true);
+    }
     return {};
   }
 
 private:
   auto async_wait(bool first_iteration = false) -> void {
-    auto timer = std::make_shared<boost::asio::steady_timer>(ctx_);
     if (first_iteration) {
-      timer->expires_after(std::chrono::microseconds(0));
+      cycle_timer_.expires_after(std::chrono::microseconds(0));
     } else {
-      auto sleep_time = ec::common::cycle_time() - (std::chrono::high_resolution_clock::now() - cycle_start_);
-      timer->expires_after(sleep_time);
+      auto sleep_time = cycle_time() - (std::chrono::high_resolution_clock::now() - cycle_start_);
+      cycle_timer_.expires_after(sleep_time);
     }
     cycle_start_with_sleep_ = std::chrono::high_resolution_clock::now();
-    timer->async_wait([this, timer](auto&& PH1) { fieldbus_roundtrip(std::forward<decltype(PH1)>(PH1)); });
+    cycle_timer_.async_wait([this](std::error_code err) { fieldbus_roundtrip(err); });
   }
 
   auto fieldbus_roundtrip(std::error_code err) -> void {
@@ -241,96 +307,335 @@ private:
     if (err) {
       return;
     }
+    auto const wkc{ processdata(microseconds{ 100 }) };
+    while (ecx_iserror(&context_) != 0U) {
+      logger_.error("Ethercat context error: {}", ecx_elist2string(&context_));
+    }
+    record_cycle(wkc, std::chrono::high_resolution_clock::now() - cycle_start_,
+                 std::chrono::high_resolution_clock::now() - cycle_start_with_sleep_);
+    supervisor_.on_cycle(wkc_, expected_wkc_,
+                         [this](auto&& operation, auto&& completion) { off_cycle(operation, completion); });
+    async_wait();
+  }
+
+  /// \brief bookkeeping of a completed cycle, runs on the io_context in both modes
+  void record_cycle(ecx::working_counter_t wkc, nanoseconds roundtrip, nanoseconds period) {
     int32_t last_wkc = wkc_;
-    wkc_ = processdata(microseconds{ 100 });
+    wkc_ = wkc;
     if (wkc_ < expected_wkc_ && wkc_ != last_wkc) {  // Don't wot over an already logged fault.
       logger_.warn("Working counter got {} expected {}", wkc_, expected_wkc_);
     }
-    while (ecx_iserror(&context_) != 0U) {
-      logger_.error("Ethercat context error: {}", ecx_elist2string(&context_));
-    }
     // Update counter and timers now that this cycle is complete
-    last_cycle_with_sleep_ = std::chrono::high_resolution_clock::now() - cycle_start_with_sleep_;
-    min_cycle_with_sleep_ = std::min(min_cycle_with_sleep_, last_cycle_with_sleep_);
-    max_cycle_with_sleep_ = std::max(max_cycle_with_sleep_, last_cycle_with_sleep_);
-
-    last_cycle_ = std::chrono::high_resolution_clock::now() - cycle_start_;
-    min_cycle_ = std::min(min_cycle_, last_cycle_);
-    max_cycle_ = std::max(max_cycle_, last_cycle_);
+    last_cycle_with_sleep_ = period;
+    period_histogram_.add(period);
+    last_cycle_ = roundtrip;
+    roundtrip_histogram_.add(roundtrip);
 
     if (cycle_count_ % 10'000 == 0 and false) {
       // log the max cycle time
-      logger_.trace("Ethercat max cycle time: {} us", max_cycle_.count());
-      logger_.trace("Ethercat max cycle time with sleep: {} us", max_cycle_with_sleep_.count());
-      logger_.trace("Ethercat min cycle time: {} us", min_cycle_.count());
-      logger_.trace("Ethercat min cycle time with sleep: {} us", min_cycle_with_sleep_.count());
+      logger_.trace("Ethercat max cycle time: {}", roundtrip_histogram_.max());
+      logger_.trace("Ethercat max cycle time with sleep: {}", period_histogram_.max());
+      logger_.trace("Ethercat min cycle time: {}", roundtrip_histogram_.min());
+      logger_.trace("Ethercat min cycle time with sleep: {}", period_histogram_.min());
     }
 
     cycle_count_++;
 
-    if (last_cycle_with_sleep_ > std::chrono::milliseconds(100)) {
+    if (last_cycle_with_sleep_ > cycle_time() + std::chrono::milliseconds(100)) {
       logger_.warn("Ethercat cycle time is too long: {}",
                    std::chrono::duration_cast<std::chrono::microseconds>(last_cycle_with_sleep_));
     }
-    async_wait();
   }
 
   /**
-   * Check the state of attached slaves.
-   * If the slaves are no longer in operational mode. Attempt to
-   * switch them to operational mode. And if the slaves have
-   * been lost attempt to add them again.
-   * @param group_index 0 for all groups
+   * Real-time mode, the fieldbus cycle runs on its own SCHED_FIFO thread which only exchanges
+   * the process image with the slaves. The devices keep running on the io_context on a copy of
+   * the image, shadow_, inputs are handed over through from_bus_ and outputs come back through to_bus_.
+   * @param priority SCHED_FIFO priority of the cycle thread
+   * @param cpu core to pin the cycle thread to
    */
-  auto check_state(uint8_t group_index = 0) -> void {
-    auto& grp = group_list_as_span()[group_index];
-    while (running_) {
-      if (grp.docheckstate == 1 || wkc_ < expected_wkc_) {
-        grp.docheckstate = FALSE;
-        ecx_readstate(&context_);
-        auto slaves = slave_list_as_span();
-        uint16_t slave_index = 1;
-        for (ec_slave& slave : slaves) {
-          if (slave.state != EC_STATE_OPERATIONAL) {
-            grp.docheckstate = TRUE;
-            if (slave.state == EC_STATE_SAFE_OP + EC_STATE_ERROR) {
-              logger_.warn("Slave {}, {} is in SAFE_OP+ERROR, attempting ACK", slave_index, slave.name);
-              slave.state = EC_STATE_SAFE_OP + EC_STATE_ACK;
-              ecx_writestate(&context_, slave_index);
-            } else if (slave.state == EC_STATE_SAFE_OP) {
-              logger_.warn("Slave {}, {} is in SAFE_OP, change to OPERATIONAL", slave_index, slave.name);
-              slave.state = EC_STATE_OPERATIONAL;
-              ecx_writestate(&context_, slave_index);
-            } else if (slave.state > EC_STATE_NONE) {
-              if (ecx_reconfig_slave(&context_, slave_index, EC_TIMEOUTRET) != 0) {
-                slave.islost = FALSE;
-                logger_.warn("Slave {}, {} reconfigured", slave_index, slave.name);
-              }
-            } else if (slave.islost == 0) {
-              ecx_statecheck(&context_, slave_index, EC_STATE_OPERATIONAL, EC_TIMEOUTRET);
-              if (slave.state == EC_STATE_NONE) {
-                slave.islost = TRUE;
-                logger_.warn("Slave {}, {} lost", slave_index, slave.name);
-              }
-            }
-          }
-          if (slave.islost == 1) {
-            if (slave.state != EC_STATE_NONE) {
-              slave.islost = FALSE;
-              logger_.info("Slave {}, {} found", slave_index, slave.name);
-            } else if (ecx_recover_slave(&context_, slave_index, EC_TIMEOUTRET) != 0) {
-              slave.islost = FALSE;
-              logger_.info("Slave {}, {} recovered", slave_index, slave.name);
-            }
-          }
-          slave_index++;
-        }
-        if (context_.grouplist->docheckstate == 0) {
-          logger_.info("All slaves resumed OPERATIONAL");
-        }
+  void start_cycle_thread(int priority, std::optional<std::size_t> cpu) {
+    shadow_ = io_;
+    bus_notify_.assign(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+    async_wait_bus();
+    cycle_thread_ =
+        std::jthread{ [this, priority, cpu](std::stop_token const& stop) { realtime_cycle(stop, priority, cpu); } };
+  }
+
+  void realtime_cycle(std::stop_token const& stop, int priority, std::optional<std::size_t> cpu) {
+    if (auto const err{ realtime::make_current_thread_realtime(priority, cpu) }; err) {
+      logger_.warn("Cycle thread runs without real-time scheduling: {}", err.message());
+    }
+    auto const notify{ bus_notify_.native_handle() };
+    auto deadline{ std::chrono::steady_clock::now() };
+    auto last_start{ deadline };
+    while (!stop.stop_requested()) {
+      deadline += cycle_time();
+      realtime::sleep_until(deadline);
+      auto const start{ std::chrono::steady_clock::now() };
+      // Apply outputs in the order the io_context produced them, the newest one wins
+      for (auto* outputs{ to_bus_.read_slot() }; outputs != nullptr; outputs = to_bus_.read_slot()) {
+        copy_outputs(outputs->io, io_);
+        to_bus_.pop();
       }
-      std::this_thread::sleep_for(milliseconds(10));
+      auto const wkc{ exchange_processdata(microseconds{ 100 }) };
+      auto const finished{ std::chrono::steady_clock::now() };
+      if (auto* image{ from_bus_.write_slot() }; image != nullptr) {
+        copy_inputs(io_, image->io);
+        image->wkc = wkc;
+        image->roundtrip = finished - start;
+        image->period = start - last_start;
+        from_bus_.push();
+        std::uint64_t const one{ 1 };
+        std::ignore = ::write(notify, &one, sizeof(one));
+      } else {
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (supervision_.load(std::memory_order_acquire) == supervision_e::requested) {
+        // Between two frames, the next one waits for the operation, see off_cycle
+        supervision_operation_();
+        supervision_.store(supervision_e::done, std::memory_order_release);
+      }
+      // Errors are rare, logging them here is cheaper than handing the error list over
+      while (ecx_iserror(&context_) != 0U) {
+        logger_.error("Ethercat context error: {}", ecx_elist2string(&context_));
+      }
+      last_start = start;
+      // Don't burst through missed cycles to catch up, continue a full cycle from now
+      if (auto const done{ std::chrono::steady_clock::now() }; done - deadline > cycle_time()) {
+        missed_deadlines_.fetch_add(1, std::memory_order_relaxed);
+        deadline = done;
+      }
+    }
+  }
+
+  /**
+   * Run a supervisor operation between two cycles on the thread exchanging the frames. The frames, the error list and
+   * the index stack of SOEM are not shared with another thread, so the operation never races the process data.
+   * In real-time mode the operation is handed to the cycle thread, which runs it after its next frame and holds the
+   * following one off until it is done. drain_bus calls the completion on the io_context afterwards.
+   * Otherwise the io_context runs the cycle, the operation and completion run right away and the next cycle is only
+   * scheduled afterwards.
+   * State reads and writes take a frame, reconfiguring or recovering a slave takes up to seconds of mailbox traffic
+   * during which no process data is exchanged.
+   * @param operation the state or mailbox operation
+   * @param completion called on the io_context once the operation is done
+   */
+  template <typename operation_t, typename completion_t>
+  void off_cycle(operation_t& operation, completion_t& completion) {
+    if (!realtime_mode_) {
+      operation();
+      completion();
+      return;
     }
+    // The supervisor only starts an operation after the completion of the last one, the cycle thread is done with it
+    supervision_operation_ = std::move(operation);
+    supervision_completion_ = std::move(completion);
+    supervision_.store(supervision_e::requested, std::memory_order_release);
+  }
+
+  /**
+   * Devices are only touched on the io_context. The PO2SO hook of a slave reconfigured by the cycle thread hands the
+   * setup to drain_bus and waits for it, the cycle thread does not exchange frames meanwhile.
+   * @return result of the setup, 0 if the cycle thread is stopped before it ran
+   */
+  auto setup_on_io_context(std::uint16_t slave_index) -> int {
+    setup_request_.store(slave_index, std::memory_order_release);
+    std::uint64_t const one{ 1 };
+    std::ignore = ::write(bus_notify_.native_handle(), &one, sizeof(one));
+    auto const stop{ cycle_thread_.get_stop_token() };
+    while (setup_request_.load(std::memory_order_acquire) != 0) {
+      if (stop.stop_requested()) {
+        return 0;
+      }
+      std::this_thread::sleep_for(microseconds{ 100 });
+    }
+    return setup_result_.load(std::memory_order_relaxed);
+  }
+
+  void async_wait_bus() {
+    bus_notify_.async_read_some(boost::asio::buffer(&bus_notify_count_, sizeof(bus_notify_count_)),
+                                [this](std::error_code err, std::size_t) {
+                                  if (err) {
+                                    return;
+                                  }
+                                  drain_bus();
+                                  async_wait_bus();
+                                });
+  }
+
+  /// \brief record every cycle the cycle thread completed and run the devices once on the newest inputs
+  void drain_bus() {
+    if (auto const slave_index{ setup_request_.load(std::memory_order_acquire) }; slave_index != 0) {
+      setup_result_.store(slaves_[slave_index].setup(), std::memory_order_relaxed);
+      setup_request_.store(0, std::memory_order_release);
+    }
+    if (supervision_.load(std::memory_order_acquire) == supervision_e::done) {
+      supervision_.store(supervision_e::idle, std::memory_order_relaxed);
+      std::exchange(supervision_completion_, {})();
+    }
+    bool received{ false };
+    for (auto* image{ from_bus_.read_slot() }; image != nullptr; image = from_bus_.read_slot()) {
+      copy_inputs(image->io, shadow_);
+      record_cycle(image->wkc, image->roundtrip, image->period);
+      from_bus_.pop();
+      received = true;
+    }
+    if (!received) {
+      return;
+    }
+    process_devices(shadow_);
+    if (auto* outputs{ to_bus_.write_slot() }; outputs != nullptr) {
+      copy_outputs(shadow_, outputs->io);
+      to_bus_.push();
+    } else {
+      overruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+    supervisor_.on_cycle(wkc_, expected_wkc_,
+                         [this](auto&& operation, auto&& completion) { off_cycle(operation, completion); });
+  }
+
+  /// \brief resolve where the process data of every slave lives, the mapping does not move after config_overlap_map_group
+  void build_dispatch_table() {
+    dispatch_.clear();
+    dispatch_.reserve(slave_count());
+    for (size_t i = 1; i < slave_count() + 1; i++) {
+      auto const& slave{ slavelist_[i] };
+      std::size_t const input_size{ slave.Ibytes == 0 ? !!slave.Ibits : slave.Ibytes };
+      std::size_t const output_size{ slave.Obytes == 0 ? !!slave.Obits : slave.Obytes };
+      auto const input{ image_region(slave.inputs, input_size) };
+      auto const output{ image_region(slave.outputs, output_size) };
+      auto entry{ slaves_[i].dispatch_entry(static_cast<std::uint16_t>(i), input, output) };
+      if (entry.process == entry.checked) {
+        logger_.warn("Slave {} ({}) does not accept {} input and {} output bytes, its size is checked every cycle", i,
+                     slaves_[i].name(), input.size, output.size);
+      }
+      dispatch_.push_back(entry);
+    }
+  }
+
+  /// \return where pointer lies in io_, an empty region for slaves without that direction
+  [[nodiscard]] auto image_region(std::uint8_t const* pointer, std::size_t size) const -> devices::dispatch_table::region {
+    if (pointer == nullptr) {
+      return {};
+    }
+    auto const offset{ pointer - reinterpret_cast<std::uint8_t const*>(io_.data()) };
+    return { .offset = static_cast<std::uint32_t>(offset), .size = static_cast<std::uint32_t>(size) };
+  }
+
+  /// \return bytes of image at the offset pointer has in io_, the slave and group pointers of SOEM all point into io_
+  [[nodiscard]] auto mirror(image_t& image, std::uint8_t const* pointer, std::size_t size) const -> std::span<std::uint8_t> {
+    if (pointer == nullptr) {
+      return {};
+    }
+    auto const offset{ pointer - reinterpret_cast<std::uint8_t const*>(io_.data()) };
+    return { reinterpret_cast<std::uint8_t*>(image.data()) + offset, size };
+  }
+
+  void copy_inputs(image_t& from, image_t& to) const {
+    auto const& group{ grouplist_[0] };
+    std::ranges::copy(mirror(from, group.inputs, group.Ibytes), mirror(to, group.inputs, group.Ibytes).begin());
+  }
+
+  void copy_outputs(image_t& from, image_t& to) const {
+    auto const& group{ grouplist_[0] };
+    std::ranges::copy(mirror(from, group.outputs, group.Obytes), mirror(to, group.outputs, group.Obytes).begin());
+  }
+
+  using publish_rate_t = std::tuple<std::uint16_t, std::string, std::uint32_t, double>;
+
+  [[nodiscard]] auto publish_rates() const -> std::vector<publish_rate_t> {
+    std::vector<publish_rate_t> rates{};
+    rates.reserve(slaves_.size());
+    auto const cycle{ std::chrono::duration<double>{ cycle_time() } };
+    for (std::size_t idx = 1; idx < slaves_.size(); idx++) {
+      auto const divisor{ slaves_[idx].publish_divisor() };
+      rates.emplace_back(static_cast<std::uint16_t>(idx), slaves_[idx].name(), static_cast<std::uint32_t>(divisor),
+                         1.0 / (cycle.count() * static_cast<double>(divisor)));
+    }
+    return rates;
+  }
+
+  using slave_recovery_t =
+      std::tuple<std::uint16_t, std::string, std::string, std::uint64_t, std::int64_t, std::int64_t, std::int64_t>;
+
+  [[nodiscard]] auto slave_recovery() const -> std::vector<slave_recovery_t> {
+    std::vector<slave_recovery_t> recovery{};
+    auto const slaves{ supervisor_.slaves() };
+    recovery.reserve(slaves.size());
+    auto const now{ std::chrono::steady_clock::now() };
+    for (std::size_t idx = 0; idx < slaves.size(); idx++) {
+      auto const& slave{ slaves[idx] };
+      auto const degraded{ slave.phase == slave_phase_e::operational ? nanoseconds{} : now - slave.degraded_since };
+      recovery.emplace_back(static_cast<std::uint16_t>(idx + 1), slaves_[idx + 1].name(),
+                            std::string{ format_as(slave.phase) }, slave.recoveries, slave.last.count(), slave.max.count(),
+                            degraded.count());
+    }
+    return recovery;
+  }
+
+  /// \brief takes effect from the next cycle in both modes, the publish divisors are recalculated to keep the intervals
+  void apply_cycle_time(microseconds requested) {
+    auto const bounded{ std::clamp(requested, common::min_cycle_time, common::max_cycle_time) };
+    if (bounded != requested) {
+      logger_.warn("Cycle time {} is out of bounds, using {}", requested, bounded);
+    }
+    cycle_time_.store(nanoseconds{ bounded }.count());
+    logger_.info("Cycle time {}", bounded);
+    update_publish_divisors();
+  }
+
+  /// \brief divisor of every slave from its configured publish interval, or the default of the device
+  void update_publish_divisors() {
+    auto const& configured{ config_->publish_intervals.value() };
+    auto const cycle{ cycle_time() };
+    for (std::size_t idx = 1; idx < slaves_.size(); idx++) {
+      auto& slave{ slaves_[idx] };
+      nanoseconds interval{ slave.default_publish_interval() };
+      if (auto const found{ configured.find(fmt::format("s{}", idx)) }; found != configured.end()) {
+        interval = found->second;
+      }
+      // round up, a slave is never published more often than its interval
+      auto const divisor{ std::max<nanoseconds::rep>((interval + cycle - nanoseconds{ 1 }) / cycle, 1) };
+      slave.set_publish_divisor(static_cast<std::size_t>(divisor));
+    }
+  }
+
+  void register_statistics() {
+    using histogram_t = std::vector<std::uint64_t>;
+    auto const buckets{ [](realtime::cycle_histogram const& histogram) {
+      return histogram_t{ histogram.buckets().begin(), histogram.buckets().end() };
+    } };
+    auto const none{ sdbusplus::vtable::property_::none };
+    statistics_ = std::make_unique<sdbusplus::asio::dbus_interface>(dbus_, dbus::make_dbus_path(dbus_name),
+                                                                    dbus::make_dbus_name(statistics::interface));
+    statistics_->register_property_r<bool>(std::string{ statistics::realtime }, none,
+                                           [this](auto const&) { return realtime_mode_; });
+    statistics_->register_property_r<histogram_t>(std::string{ statistics::roundtrip_histogram }, none,
+                                                  [this, buckets](auto const&) { return buckets(roundtrip_histogram_); });
+    statistics_->register_property_r<std::int64_t>(std::string{ statistics::roundtrip_min }, none,
+                                                   [this](auto const&) { return roundtrip_histogram_.min().count(); });
+    statistics_->register_property_r<std::int64_t>(std::string{ statistics::roundtrip_max }, none,
+                                                   [this](auto const&) { return roundtrip_histogram_.max().count(); });
+    statistics_->register_property_r<histogram_t>(std::string{ statistics::period_histogram }, none,
+                                                  [this, buckets](auto const&) { return buckets(period_histogram_); });
+    statistics_->register_property_r<std::int64_t>(std::string{ statistics::period_min }, none,
+                                                   [this](auto const&) { return period_histogram_.min().count(); });
+    statistics_->register_property_r<std::int64_t>(std::string{ statistics::period_max }, none,
+                                                   [this](auto const&) { return period_histogram_.max().count(); });
+    statistics_->register_property_r<std::uint64_t>(std::string{ statistics::cycle_count }, none,
+                                                    [this](auto const&) { return std::uint64_t{ cycle_count_ }; });
+    statistics_->register_property_r<std::int64_t>(std::string{ statistics::cycle_time }, none,
+                                                   [this](auto const&) { return cycle_time().count(); });
+    statistics_->register_property_r<std::vector<publish_rate_t>>(std::string{ statistics::publish_rates }, none,
+                                                                  [this](auto const&) { return publish_rates(); });
+    statistics_->register_property_r<std::uint64_t>(std::string{ statistics::overruns }, none,
+                                                    [this](auto const&) { return overruns_.load(); });
+    statistics_->register_property_r<std::uint64_t>(std::string{ statistics::missed_deadlines }, none,
+                                                    [this](auto const&) { return missed_deadlines_.load(); });
+    statistics_->register_property_r<std::vector<slave_recovery_t>>(std::string{ statistics::slave_recovery }, none,
+                                                                    [this](auto const&) { return slave_recovery(); });
+    statistics_->initialize();
   }
 
   /**
@@ -352,6 +657,10 @@ private:
         "{}\nSupportes CoE Complete access: {}\n",
         sl.eep_id, sl.eep_man, slave_index, sl.name, sl.aliasadr, sl.hasdc, sl.state,
         (sl.CoEdetails & ECT_COEDET_SDOCA) != 0);
+    // in real-time mode a slave is only reconfigured by a supervisor operation on the cycle thread, see off_cycle
+    if (self->realtime_mode_) {
+      return self->setup_on_io_context(slave_index);
+    }
     return self->slaves_[slave_index].setup();
   }
 
@@ -368,7 +677,9 @@ private:
 
   boost::asio::io_context& ctx_;
   ecx_contextt context_{};
+  bus_t bus_;
   std::vector<devices::device<ipc_ruler::ipc_manager_client>> slaves_;
+  devices::dispatch_table dispatch_{};
 
   // Stack allocations for pointers inside ec_contextt.
   ecx_portt port_;
@@ -386,27 +697,55 @@ private:
   std::array<ec_PDOdesct, ecx::constants::max_concurrent_map_thread> PDOdesc_;
   ec_eepromSMt eep_SM_;
   ec_eepromFMMUt eepFMMU_;
-  bool running_ = true;
 
   tfc::ipc_ruler::ipc_manager_client client_;
 
   // Timing related variables
-  std::chrono::nanoseconds min_cycle_with_sleep_ = std::chrono::nanoseconds::max();
-  std::chrono::nanoseconds max_cycle_with_sleep_ = std::chrono::nanoseconds::min();
   std::chrono::nanoseconds last_cycle_with_sleep_ = std::chrono::nanoseconds::zero();
   std::chrono::nanoseconds last_cycle_ = std::chrono::nanoseconds::zero();
-  std::chrono::nanoseconds min_cycle_ = std::chrono::nanoseconds::max();
-  std::chrono::nanoseconds max_cycle_ = std::chrono::nanoseconds::min();
+  realtime::cycle_histogram period_histogram_{};
+  realtime::cycle_histogram roundtrip_histogram_{};
   std::chrono::time_point<std::chrono::high_resolution_clock> cycle_start_with_sleep_;
   std::chrono::time_point<std::chrono::high_resolution_clock> cycle_start_;
   size_t cycle_count_ = 0;
+  // read by the cycle thread in real-time mode
+  std::atomic<nanoseconds::rep> cycle_time_{ nanoseconds{ common::default_cycle_time }.count() };
   int32_t expected_wkc_ = 0;
   int32_t wkc_ = 0;
   std::array<std::byte, pdo_buffer_size> io_;
-  std::unique_ptr<std::thread> check_thread_;
+  boost::asio::steady_timer cycle_timer_{ ctx_ };
+
+  // Real-time mode, see start_cycle_thread
+  struct cycle_image {
+    image_t io{};
+    ecx::working_counter_t wkc{};
+    std::chrono::nanoseconds roundtrip{};
+    std::chrono::nanoseconds period{};
+  };
+  static constexpr std::size_t image_queue_depth{ 4 };
+  bool realtime_mode_{ false };
+  realtime::spsc_queue<cycle_image, image_queue_depth> from_bus_{};
+  realtime::spsc_queue<cycle_image, image_queue_depth> to_bus_{};
+  image_t shadow_{};
+  boost::asio::posix::stream_descriptor bus_notify_{ ctx_ };
+  std::uint64_t bus_notify_count_{};
+  std::atomic<std::uint64_t> overruns_{};
+  std::atomic<std::uint64_t> missed_deadlines_{};
+  std::jthread cycle_thread_;
+  // state or mailbox operation of the supervisor handed to the cycle thread, see off_cycle
+  enum struct supervision_e : std::uint8_t { idle, requested, done };
+  std::atomic<supervision_e> supervision_{ supervision_e::idle };
+  std::function<void()> supervision_operation_{};
+  std::function<void()> supervision_completion_{};
+  // PO2SO hook of a slave the cycle thread reconfigures, run by drain_bus, see setup_on_io_context
+  std::atomic<std::uint16_t> setup_request_{};
+  std::atomic<int> setup_result_{};
+  supervisor<bus_t> supervisor_{ bus_, &context_ };
+
   std::shared_ptr<sdbusplus::asio::connection> dbus_{
     std::make_shared<sdbusplus::asio::connection>(ctx_, dbus::sd_bus_open_system())
   };
+  std::unique_ptr<sdbusplus::asio::dbus_interface> statistics_;
   tfc::confman::config<config::ethercat> config_{ dbus_, "ethercat" };
   tfc::logger::logger logger_{ "ethercat" };
 };
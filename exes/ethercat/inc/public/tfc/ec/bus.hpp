@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include <tfc/ec/soem_interface.hpp>
+
+namespace tfc::ec::bus {
+
+/**@brief
+ * Everything context_t asks of the segment, all on the SOEM context so the slave and group lists stay the single
+ * source of truth whichever backend fills them. soem talks to real slaves through a NIC, simulated to a virtual slave
+ * list, see simulated_bus.hpp.
+ * */
+template <typename bus_t>
+concept bus_c = requires(bus_t bus,
+                         ecx_contextt* context,
+                         std::string_view iface,
+                         std::span<std::byte> image,
+                         std::uint16_t slave,
+                         ec_state state,
+                         std::chrono::microseconds timeout,
+                         ecx::index_t index,
+                         std::span<std::byte> data) {
+  { bus.init(context, iface) } -> std::same_as<bool>;
+  { bus.config_init(context, bool{}) } -> std::same_as<bool>;
+  { bus.config_overlap_map_group(context, image) } -> std::same_as<std::size_t>;
+  { bus.configdc(context) } -> std::same_as<bool>;
+  { bus.write_state(context, slave) } -> std::same_as<ecx::working_counter_t>;
+  { bus.read_state(context) } -> std::same_as<ec_state>;
+  { bus.statecheck(context, slave, state, timeout) } -> std::same_as<ec_state>;
+  bus.send_processdata(context);
+  { bus.receive_processdata(context, timeout) } -> std::same_as<ecx::working_counter_t>;
+  { bus.sdo_write(context, slave, index, bool{}, data, timeout) } -> std::same_as<ecx::working_counter_t>;
+  { bus.reconfig_slave(context, slave, timeout) } -> std::same_as<int>;
+  { bus.recover_slave(context, slave, timeout) } -> std::same_as<int>;
+  bus.close(context);
+};
+
+/// \brief the real segment, forwards to SOEM
+struct soem {
+  auto init(ecx_contextt* context, std::string_view iface) -> bool { return ecx::init(context, iface); }
+  auto config_init(ecx_contextt* context, bool use_config_table) -> bool {
+    return ecx::config_init(context, use_config_table);
+  }
+  auto config_overlap_map_group(ecx_contextt* context, std::span<std::byte> image) -> std::size_t {
+    return ecx::config_overlap_map_group(context, image, 0);
+  }
+  auto configdc(ecx_contextt* context) -> bool { return ecx::configdc(context); }
+  auto write_state(ecx_contextt* context, std::uint16_t slave) -> ecx::working_counter_t {
+    return ecx::write_state(context, slave);
+  }
+  auto read_state(ecx_contextt* context) -> ec_state { return ecx::readstate(context); }
+  auto statecheck(ecx_contextt* context, std::uint16_t slave, ec_state requested, std::chrono::microseconds timeout)
+      -> ec_state {
+    return ecx::statecheck(context, slave, requested, timeout);
+  }
+  void send_processdata(ecx_contextt* context) { ecx_send_overlap_processdata(context); }
+  auto receive_processdata(ecx_contextt* context, std::chrono::microseconds timeout) -> ecx::working_counter_t {
+    return ecx::recieve_processdata(context, timeout);
+  }
+  auto sdo_write(ecx_contextt* context,
+                 std::uint16_t slave,
+                 ecx::index_t index,
+                 ecx::complete_access_t complete_access,
+                 std::span<std::byte> data,
+                 std::chrono::microseconds timeout) -> ecx::working_counter_t {
+    return ecx::sdo_write(context, slave, index, complete_access, data, timeout);
+  }
+  auto reconfig_slave(ecx_contextt* context, std::uint16_t slave, std::chrono::microseconds timeout) -> int {
+    return ecx_reconfig_slave(context, slave, static_cast<int>(timeout.count()));
+  }
+  auto recover_slave(ecx_contextt* context, std::uint16_t slave, std::chrono::microseconds timeout) -> int {
+    return ecx_recover_slave(context, slave, static_cast<int>(timeout.count()));
+  }
+  void close(ecx_contextt* context) { ecx_close(context); }
+};
+
+static_assert(bus_c<soem>);
+
+}  // namespace tfc::ec::bus
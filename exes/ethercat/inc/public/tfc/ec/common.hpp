@@ -6,11 +6,11 @@
 
 namespace tfc::ec::common {
 
-/// \brief The scan time for the ethercat network, between each poll.
-static constexpr auto cycle_time() {
-  // todo make a compile option
-  return std::chrono::milliseconds(1);
-};
+/// \brief The scan time for the ethercat network, between each poll, unless configured otherwise.
+static constexpr std::chrono::microseconds default_cycle_time{ std::chrono::milliseconds{ 1 } };
+/// \brief Bounds of the configured scan time
+static constexpr std::chrono::microseconds min_cycle_time{ 100 };
+static constexpr std::chrono::microseconds max_cycle_time{ std::chrono::milliseconds{ 100 } };
 
 /// \return The network interfaces on the running hardware.
 auto get_interfaces() -> std::vector<std::string> const&;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <map>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -39,13 +41,48 @@ struct glz::detail::to_json_schema<tfc::ec::config::network_interface> {
 };
 
 namespace tfc::ec::config {
+struct realtime {
+  bool enabled{ false };
+  int priority{ 80 };
+  std::optional<std::size_t> cpu{ std::nullopt };
+  struct glaze {
+    // clang-format off
+    static constexpr auto value{ glz::object(
+      "enabled", &realtime::enabled, "Run the fieldbus cycle on a dedicated SCHED_FIFO thread instead of the main event loop, "
+                                     "takes effect on restart",
+      "priority", &realtime::priority, tfc::json::schema{
+        .description = "SCHED_FIFO priority of the cycle thread",
+        .defaultValue = 80L,
+        .minimum = 1L,
+        .maximum = 99L,
+      },
+      "cpu", &realtime::cpu, "CPU core the cycle thread is pinned to, preferably one isolated from the scheduler") };
+    // clang-format on
+    static constexpr std::string_view name{ "config::ethercat::realtime" };
+  };
+};
+
 struct ethercat {
   network_interface primary_interface{ common::get_interfaces().at(0) };
   confman::observable<std::optional<std::size_t>> required_slave_count{ std::nullopt };
+  config::realtime realtime{};
+  confman::observable<std::chrono::microseconds> cycle_time{ std::chrono::microseconds{ common::default_cycle_time } };
+  // key is the slave index prefixed with s, like in the signal names, f.e. s3
+  confman::observable<std::map<std::string, std::chrono::microseconds>> publish_intervals{};
   struct glaze {
     // clang-format off
     static constexpr auto value{ glz::object("primary_interface", &ethercat::primary_interface, "Primary interface",
-                                             "required_slave_count", &ethercat::required_slave_count, "Required slave count") };
+                                             "required_slave_count", &ethercat::required_slave_count, "Required slave count",
+                                             "realtime", &ethercat::realtime, "Dedicated real-time cycle thread",
+                                             "cycle_time", &ethercat::cycle_time, tfc::json::schema{
+                                               .description = "Time between fieldbus cycles, every device exchanges process data once per cycle",
+                                               .defaultValue = common::default_cycle_time.count(),
+                                               .minimum = common::min_cycle_time.count(),
+                                               .maximum = common::max_cycle_time.count(),
+                                             },
+                                             "publish_intervals", &ethercat::publish_intervals,
+                                             "Minimum interval between publishing the values of a slave, keyed by s<slave index>. "
+                                             "The slave still exchanges process data every cycle, omitted slaves use the device default") };
     // clang-format on
     static constexpr std::string_view name{ "config::ethercat" };
   };
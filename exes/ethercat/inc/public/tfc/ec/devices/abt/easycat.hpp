@@ -34,6 +34,19 @@ public:
   static constexpr size_t ai_count = 2;  // Number of analog inputs
 
   auto pdo_cycle(std::span<std::uint8_t> input, std::span<std::uint8_t> output) noexcept -> void {
+    if (this->publish_due()) {
+      transmit_inputs(input);
+    }
+    output[0] = output_states_.to_ulong() & 0x0f;
+    if (auto const servo_value = servo_.value(); servo_value.has_value()) {
+      output[1] = static_cast<std::uint8_t>(servo_value.value());
+    } else {
+      output[1] = 0;
+    }
+  }
+
+private:
+  void transmit_inputs(std::span<std::uint8_t> input) {
     std::bitset<di_count> const in_bits(input[6]);
     for (size_t i = 0; i < di_count; i++) {
       bool const value = in_bits.test(i);
@@ -57,15 +70,8 @@ public:
       }
       last_analog_value_[i] = value;
     }
-    output[0] = output_states_.to_ulong() & 0x0f;
-    if (auto const servo_value = servo_.value(); servo_value.has_value()) {
-      output[1] = static_cast<std::uint8_t>(servo_value.value());
-    } else {
-      output[1] = 0;
-    }
   }
 
-private:
   std::bitset<do_count> output_states_;
   std::array<std::optional<bool>, di_count> last_bool_value_;
   std::array<std::optional<uint8_t>, ai_count> last_analog_value_;
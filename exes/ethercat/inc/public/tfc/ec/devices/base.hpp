@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <functional>
@@ -90,6 +91,11 @@ using pdo_error_t = decltype(std::declval<some_t>().pdo_error());
 template <typename some_t>
 using setup_driver_t = decltype(std::declval<some_t>().setup_driver());
 
+template <typename impl_t>
+using input_pdo_t = std::decay_t<first_arg_t<decltype(&impl_t::pdo_cycle)>>;
+template <typename impl_t>
+using output_pdo_t = std::decay_t<second_arg_t<decltype(&impl_t::pdo_cycle)>>;
+
 struct Foo {
   void foo(int, double) {}
   void bar(int&, double&) {}
@@ -122,10 +128,12 @@ public:
 
   // Default behaviour no data processing
   void process_data(default_t input, default_t output) {
+    advance_publish_phase();
+
     static_assert(std::is_member_function_pointer_v<decltype(&impl_t::pdo_cycle)>, "impl_t must have method pdo_cycle");
     using pdo_cycle_func_t = decltype(&impl_t::pdo_cycle);  // is function pointer
-    using input_pdo = std::decay_t<details::first_arg_t<pdo_cycle_func_t>>;
-    using output_pdo = std::decay_t<details::second_arg_t<pdo_cycle_func_t>>;
+    using input_pdo = details::input_pdo_t<impl_t>;
+    using output_pdo = details::output_pdo_t<impl_t>;
 
     // Verify that the declaration of arguments are correct
     if constexpr (!std::same_as<input_pdo, default_t>) {
@@ -189,6 +197,41 @@ public:
     static_cast<impl_t*>(this)->pdo_cycle(*input_data, *output_data);
   }
 
+  /// \return whether buffers of these sizes can be handed to pdo_cycle, the check process_data does every cycle
+  static constexpr auto pdo_sizes_match(std::size_t input_size, std::size_t output_size) noexcept -> bool {
+    using input_pdo = details::input_pdo_t<impl_t>;
+    using output_pdo = details::output_pdo_t<impl_t>;
+    return (std::same_as<input_pdo, default_t> || input_size == sizeof(input_pdo)) &&
+           (std::same_as<output_pdo, default_t> || output_size == sizeof(output_pdo));
+  }
+
+  /// \brief process_data without the size checks, only for buffers validated once with pdo_sizes_match
+  void unchecked_process_data(default_t input, default_t output) {
+    advance_publish_phase();
+    input_buffer_valid_ = true;
+    output_buffer_valid_ = true;
+
+    using input_pdo = details::input_pdo_t<impl_t>;
+    using output_pdo = details::output_pdo_t<impl_t>;
+    input_pdo* input_data{ nullptr };
+    output_pdo* output_data{ nullptr };
+    // clang-format off
+    PRAGMA_CLANG_WARNING_PUSH_OFF(-Wunsafe-buffer-usage)
+    // clang-format on
+    if constexpr (std::same_as<input_pdo, default_t>) {
+      input_data = &input;
+    } else {
+      input_data = reinterpret_cast<input_pdo*>(input.data());
+    }
+    if constexpr (std::same_as<output_pdo, default_t>) {
+      output_data = &output;
+    } else {
+      output_data = reinterpret_cast<output_pdo*>(output.data());
+    }
+    PRAGMA_CLANG_WARNING_POP
+    static_cast<impl_t*>(this)->pdo_cycle(*input_data, *output_data);
+  }
+
   // Default behaviour, no setup
   auto setup() -> int {
     // If impl_t has method setup_driver, call it
@@ -200,6 +243,21 @@ public:
 
   void set_sdo_write_cb(auto&& cb) { sdo_write_ = std::forward<decltype(cb)>(cb); }
 
+  /// \brief publish to ipc and do heavy computation only every divisor-th cycle, pdo_cycle still sees every frame
+  void set_publish_divisor(std::size_t divisor) noexcept {
+    publish_divisor_ = std::max<std::size_t>(divisor, 1);
+    publish_phase_ = 0;
+  }
+  [[nodiscard]] auto publish_divisor() const noexcept -> std::size_t { return publish_divisor_; }
+
+  /// \return the publish interval of impl_t unless configured otherwise, zero publishes every cycle
+  static constexpr auto default_publish_interval() noexcept -> std::chrono::microseconds {
+    if constexpr (requires { impl_t::publish_interval; }) {
+      return impl_t::publish_interval;
+    }
+    return std::chrono::microseconds{ 0 };
+  }
+
   auto sdo_write(ecx::index_t idx,
                  ecx::complete_access_t acc,
                  std::span<std::byte> const& data,
@@ -257,15 +315,26 @@ public:
 protected:
   explicit base(uint16_t slave_index) : slave_index_(slave_index) {}
 
+  /// \return whether the current pdo_cycle should publish to ipc, see set_publish_divisor
+  [[nodiscard]] auto publish_due() const noexcept -> bool { return publish_due_; }
+
   const uint16_t slave_index_{};
   tfc::logger::logger logger_{ fmt::format("{}.{}", impl_t::name, slave_index_) };
 
 private:
+  void advance_publish_phase() noexcept {
+    publish_due_ = publish_phase_ == 0;
+    publish_phase_ = publish_phase_ + 1 >= publish_divisor_ ? 0 : publish_phase_ + 1;
+  }
+
   std::function<
       ecx::working_counter_t(ecx::index_t, ecx::complete_access_t, std::span<std::byte>, std::chrono::microseconds)>
       sdo_write_{};
   bool output_buffer_valid_{ true };
   bool input_buffer_valid_{ true };
+  std::size_t publish_divisor_{ 1 };
+  std::size_t publish_phase_{ 0 };
+  bool publish_due_{ true };
 };
 
 class default_device final : public base<default_device> {
@@ -8,6 +8,7 @@
 #include <tfc/ec/devices/base.hpp>
 #include <tfc/ipc/details/dbus_client_iface.hpp>
 #include <tfc/ipc/details/type_description.hpp>
+#include <tfc/ipc/publish_group.hpp>
 #include <tfc/ipc_fwd.hpp>
 #include <tfc/stx/basic_fixed_string.hpp>
 #include <tfc/utils/asio_fwd.hpp>
@@ -41,6 +42,9 @@ private:
   std::array<std::optional<bool>, size> last_values_{};
   using bool_signal_t = signal_t<ipc::details::type_bool, manager_client_type&>;
   std::array<std::shared_ptr<bool_signal_t>, size> transmitters_;
+  // changed inputs are staged during the cycle and published together at its end
+  ipc::publish_group publish_;
+  std::array<ipc::publish_group::member<bool_signal_t>*, size> staged_{};
 };
 
 template <typename manager_client_type, template <typename, typename> typename signal_t = ipc::signal>
@@ -15,6 +15,7 @@
 #include <boost/asio.hpp>
 #include <tfc/ec/devices/base.hpp>
 #include <tfc/ipc.hpp>
+#include <tfc/ipc/publish_group.hpp>
 
 namespace tfc::ec::devices::beckhoff {
 
@@ -28,7 +29,8 @@ public:
   static constexpr auto product_code = 0x9234452;
   static constexpr uint32_t vendor_id = 0x2;
 
-  eq2339(asio::io_context& ctx, manager_client_type& client, uint16_t slave_index) : base<eq2339>(slave_index) {
+  eq2339(asio::io_context& ctx, manager_client_type& client, uint16_t slave_index)
+      : base<eq2339>(slave_index), publish_{ ctx } {
     for (size_t i = 0; i < size; i++) {
       receivers_.emplace_back(std::make_shared<tfc::ipc::slot<ipc::details::type_bool, manager_client_type&>>(
           ctx, client, fmt::format("{}.slave{}.out{}", name, slave_index, i), "Digital output",
@@ -36,22 +38,24 @@ public:
 
       transmitters_.emplace_back(std::make_shared<signal_t<ipc::details::type_bool, manager_client_type&>>(
           ctx, client, fmt::format("{}.slave{}.in{}", name, slave_index, i), "Digital input"));
+      staged_[i] = &publish_.add(*transmitters_.back());
     }
   }
 
   void pdo_cycle(std::span<std::uint8_t> input, std::span<std::uint8_t> output) noexcept {
-    for (size_t byte = 0; byte <= 1; byte++) {
-      for (size_t bits = 0; bits < 8 && size - ((byte * 8) + bits) > 0; bits++) {
-        auto const value = static_cast<bool>(input[byte] & (1 << bits));
-        const size_t bit_index = byte * 8 + bits;
-        if (value != last_values_[bit_index]) {
-          transmitters_[bit_index]->async_send(value, [this](std::error_code error, size_t) {
-            if (error) {
-              this->logger_.error("Ethercat {}, error transmitting : {}", name, error.message());
-            }
-          });
+    if (this->publish_due()) {
+      for (size_t byte = 0; byte <= 1; byte++) {
+        for (size_t bits = 0; bits < 8 && size - ((byte * 8) + bits) > 0; bits++) {
+          auto const value = static_cast<bool>(input[byte] & (1 << bits));
+          const size_t bit_index = byte * 8 + bits;
+          if (value != last_values_[bit_index]) {
+            staged_[bit_index]->stage(value);
+          }
+          last_values_[bit_index] = value;
         }
-        last_values_[bit_index] = value;
+      }
+      if (auto error{ publish_.flush() }) {
+        this->logger_.error("Ethercat {}, error transmitting : {}", name, error.message());
       }
     }
 
@@ -68,5 +72,7 @@ private:
   std::array<bool, size> last_values_{};
   std::vector<std::shared_ptr<ipc::slot<ipc::details::type_bool, manager_client_type&>>> receivers_;
   std::vector<std::shared_ptr<signal_t<ipc::details::type_bool, manager_client_type&>>> transmitters_;
+  ipc::publish_group publish_;
+  std::array<ipc::publish_group::member<signal_t<ipc::details::type_bool, manager_client_type&>>*, size> staged_{};
 };
 }  // namespace tfc::ec::devices::beckhoff
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <string>
 #include <utility>
 #include <variant>
 
 #include <fmt/core.h>
 
 #include "abt/easycat.hpp"
+#include "dispatch.hpp"
 #include "beckhoff/EK1xxx.hpp"
 #include "beckhoff/EL1xxx.hpp"
 #include "beckhoff/EL2xxx.hpp"
@@ -88,6 +91,40 @@ struct device {
   auto setup() -> int {
     return std::visit([](auto& impl) { return impl.setup(); }, *device_);
   }
+  /// \return entry running this device on the given regions, the sizes are validated here instead of every cycle
+  [[nodiscard]] auto dispatch_entry(std::uint16_t slave, dispatch_table::region input, dispatch_table::region output)
+      -> dispatch_table::entry {
+    return std::visit(
+        [slave, input, output](auto& impl) -> dispatch_table::entry {
+          using impl_t = std::remove_cvref_t<decltype(impl)>;
+          dispatch_table::thunk_t const checked{ [](void* self, std::span<std::uint8_t> in, std::span<std::uint8_t> out) {
+            static_cast<impl_t*>(self)->process_data(in, out);
+          } };
+          dispatch_table::thunk_t const unchecked{ [](void* self, std::span<std::uint8_t> in, std::span<std::uint8_t> out) {
+            static_cast<impl_t*>(self)->unchecked_process_data(in, out);
+          } };
+          return { .device = &impl,
+                   .process = impl_t::pdo_sizes_match(input.size, output.size) ? unchecked : checked,
+                   .checked = checked,
+                   .input = input,
+                   .output = output,
+                   .slave = slave };
+        },
+        *device_);
+  }
+  void set_publish_divisor(std::size_t divisor) {
+    std::visit([divisor](auto& impl) { impl.set_publish_divisor(divisor); }, *device_);
+  }
+  [[nodiscard]] auto publish_divisor() const -> std::size_t {
+    return std::visit([](auto const& impl) { return impl.publish_divisor(); }, *device_);
+  }
+  [[nodiscard]] auto default_publish_interval() const -> std::chrono::microseconds {
+    return std::visit([](auto const& impl) { return impl.default_publish_interval(); }, *device_);
+  }
+  [[nodiscard]] auto name() const -> std::string {
+    return std::visit([](auto const& impl) { return fmt::format("{}", std::remove_cvref_t<decltype(impl)>::name); },
+                      *device_);
+  }
   // unique_ptr to make this struct movable with non movable items
   std::unique_ptr<device_variant<manager_client_t>> device_{};
 };
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <tfc/utils/pragmas.hpp>
+
+namespace tfc::ec::devices {
+
+/**@brief
+ * Flat table of every slave's place in the process image and the function running its device.
+ * The layout of the process image is fixed once SOEM has mapped it, so the offsets, sizes and the size validation of
+ * each device are resolved once instead of walking the SOEM slave list and visiting the device variant every cycle.
+ * */
+class dispatch_table {
+public:
+  using thunk_t = void (*)(void* device, std::span<std::uint8_t> input, std::span<std::uint8_t> output);
+
+  /// \brief bytes of one slave relative to the start of the process image
+  struct region {
+    std::uint32_t offset{};
+    std::uint32_t size{};
+  };
+
+  struct entry {
+    void* device{ nullptr };
+    /// \brief runs pdo_cycle without size checks when the sizes were validated when the entry was made
+    thunk_t process{ nullptr };
+    /// \brief the size checking process_data, used for lost slaves and sizes the device does not accept
+    thunk_t checked{ nullptr };
+    region input{};
+    region output{};
+    std::uint16_t slave{};
+  };
+
+  void clear() noexcept { entries_.clear(); }
+  void reserve(std::size_t count) { entries_.reserve(count); }
+  void push_back(entry const& item) { entries_.push_back(item); }
+  [[nodiscard]] auto entries() const noexcept -> std::span<entry const> { return entries_; }
+
+  /**
+   * Run every device in slave order on image
+   * @param image start of a process image laid out like the one the regions were taken from
+   * @param is_lost predicate on the slave index, lost slaves get empty buffers like before the table existed
+   */
+  template <typename lost_t>
+  void run(std::uint8_t* image, lost_t&& is_lost) const {
+    for (auto const& item : entries_) {
+      if (is_lost(item.slave)) [[unlikely]] {
+        item.checked(item.device, {}, {});
+        continue;
+      }
+      // clang-format off
+      PRAGMA_CLANG_WARNING_PUSH_OFF(-Wunsafe-buffer-usage)
+      // clang-format on
+      item.process(item.device, { image + item.input.offset, item.input.size },
+                   { image + item.output.offset, item.output.size });
+      PRAGMA_CLANG_WARNING_POP
+    }
+  }
+
+private:
+  std::vector<entry> entries_{};
+};
+
+}  // namespace tfc::ec::devices
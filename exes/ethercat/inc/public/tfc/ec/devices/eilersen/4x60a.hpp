@@ -370,6 +370,10 @@ PRAGMA_GCC_WARNING_POP
   }
 
   void pdo_cycle(pdo_input const& input, [[maybe_unused]] pdo_output& out) {
+    // mass is calculated and published at the publish rate
+    if (!this->publish_due()) {
+      return;
+    }
     // todo support multiple variations
     auto& group_1{ config_->variations.at(0) };
     auto value{ std::visit(
@@ -13,6 +13,7 @@
 #include <tfc/ec/devices/util.hpp>
 #include <tfc/ec/soem_interface.hpp>
 #include <tfc/ipc.hpp>
+#include <tfc/ipc/publish_group.hpp>
 #include <tfc/utils/units_glaze_meta.hpp>
 
 #include <tfc/ec/devices/schneider/atv320/dbus-iface.hpp>
@@ -25,21 +26,14 @@ namespace tfc::ec::devices::schneider::atv320 {
 using tfc::ec::util::setting;
 
 namespace details {
-template <typename signal_t, typename variable_t, typename logger_t>
-inline variable_t async_send_if_new(signal_t& signal,
-                                    const std::optional<variable_t>& old_var,
-                                    const variable_t& new_var,
-                                    logger_t& logger) {
+template <typename staged_t, typename variable_t>
+inline variable_t stage_if_new(staged_t& staged, const std::optional<variable_t>& old_var, const variable_t& new_var) {
   // clang-format off
   PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
   if (!old_var.has_value() || old_var != new_var) {
     PRAGMA_CLANG_WARNING_POP
     // clang-format on
-    signal.async_send(new_var, [&logger](const std::error_code& err, size_t) {
-      if (err) {
-        logger.error("ATV failed to send");
-      }
-    });
+    staged.stage(new_var);
   }
   return new_var;
 }
@@ -51,6 +45,8 @@ public:
   static constexpr uint32_t vendor_id = 0x0800005a;
   static constexpr uint32_t product_code = 0x389;
   static constexpr std::string_view name{ "ATV320" };
+  // status words and drive inputs don't need to be published every cycle
+  static constexpr std::chrono::microseconds publish_interval{ std::chrono::milliseconds{ 10 } };
   static constexpr size_t atv320_di_count = 6;
 
   struct atv_config {
@@ -231,31 +227,37 @@ public:
           }
         });
 
+    di_transmitters_.reserve(atv320_di_count);
     for (size_t i = 0; i < atv320_di_count; i++) {
       di_transmitters_.emplace_back(tfc::ipc::bool_signal(
           connection->get_io_context(), client, fmt::format("atv320.s{}.DI{}", slave_index, i + 1), "Digital Input"));
     }
+    for (auto& transmitter : di_transmitters_) {
+      di_staged_.emplace_back(&publish_.add(transmitter));
+    }
   }
 
-  // Update signals of the current status of the drive
+  // Update signals of the current status of the drive, changes are published as one batch
   void transmit_status(const input_t& input) {
     std::bitset<atv320_di_count> const value(input.digital_inputs);
     for (size_t i = 0; i < atv320_di_count; i++) {
-      last_bool_values_[i] =
-          details::async_send_if_new(di_transmitters_[i], last_bool_values_[i], value.test(i), this->logger_);
+      last_bool_values_[i] = details::stage_if_new(*di_staged_[i], last_bool_values_[i], value.test(i));
     }
 
-    last_hmis_ = static_cast<hmis_e>(details::async_send_if_new(
-        hmis_transmitter_, last_hmis_.has_value() ? static_cast<uint16_t>(last_hmis_.value()) : std::optional<uint16_t>(),
-        static_cast<uint16_t>(input.drive_state), this->logger_));
+    last_hmis_ = static_cast<hmis_e>(details::stage_if_new(
+        hmis_staged_, last_hmis_.has_value() ? static_cast<uint16_t>(last_hmis_.value()) : std::optional<uint16_t>(),
+        static_cast<uint16_t>(input.drive_state)));
     double frequency = static_cast<double>(input.frequency.numerical_value_is_an_implementation_detail_) / 10.0;
-    last_frequency_ = details::async_send_if_new(frequency_transmit_, last_frequency_, frequency, this->logger_);
+    last_frequency_ = details::stage_if_new(frequency_staged_, last_frequency_, frequency);
 
     double current = static_cast<double>(input.current) / 10.0;
-    last_current_ = details::async_send_if_new(current_transmit_, last_current_, current, this->logger_);
+    last_current_ = details::stage_if_new(current_staged_, last_current_, current);
 
-    last_error_ = details::async_send_if_new(last_error_transmit_, last_error_, static_cast<std::uint64_t>(last_errors_[0]),
-                                             this->logger_);
+    last_error_ = details::stage_if_new(last_error_staged_, last_error_, static_cast<std::uint64_t>(last_errors_[0]));
+
+    if (auto err{ publish_.flush() }) {
+      this->logger_.error("ATV failed to send: {}", err.message());
+    }
   }
 
   static constexpr auto errors_to_auto_reset = std::array{ lft_e::no_fault, lft_e::cnf };
@@ -300,8 +302,11 @@ public:
       last_errors_[0] = in.last_error;
     }
 
-    transmit_status(in);
-    dbus_iface_.update_status(in);
+    // Status is published at the publish rate, the controller follows every frame
+    if (this->publish_due()) {
+      transmit_status(in);
+      dbus_iface_.update_status(in);
+    }
     ctrl_.update_status(in);
 
     bool auto_reset_allowed = false;
@@ -442,5 +447,11 @@ private:
   asio::steady_timer reset_timer_{ ctx_ };
   bool no_data_{ false };
   bool allow_reset_{ false };
+  ipc::publish_group publish_{ ctx_ };
+  std::vector<ipc::publish_group::member<ipc::bool_signal>*> di_staged_{};
+  ipc::publish_group::member<ipc::double_signal>& frequency_staged_{ publish_.add(frequency_transmit_) };
+  ipc::publish_group::member<ipc::double_signal>& current_staged_{ publish_.add(current_transmit_) };
+  ipc::publish_group::member<ipc::uint_signal>& last_error_staged_{ publish_.add(last_error_transmit_) };
+  ipc::publish_group::member<ipc::uint_signal>& hmis_staged_{ publish_.add(hmis_transmitter_) };
 };
 }  // namespace tfc::ec::devices::schneider::atv320
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+
+namespace tfc::ec::realtime {
+
+/// \brief size the shared indexes of the queue are padded to, so producer and consumer don't share a cache line
+static constexpr std::size_t cache_line{ 64 };
+
+/**@brief
+ * Single producer single consumer ring of preallocated slots, neither side allocates, locks or makes a system call.
+ * The producer fills write_slot() in place and publishes it with push(), the consumer reads read_slot() in place and
+ * releases it with pop(). Used to hand process images between the cycle thread and the io_context.
+ * */
+template <typename value_t, std::size_t capacity>
+class spsc_queue {
+public:
+  static_assert(std::has_single_bit(capacity), "capacity must be a power of two");
+
+  /// \return the next free slot or nullptr when the consumer has not released any
+  [[nodiscard]] auto write_slot() noexcept -> value_t* {
+    auto const head{ head_.load(std::memory_order_relaxed) };
+    if (head - tail_.load(std::memory_order_acquire) == capacity) {
+      return nullptr;
+    }
+    return &slots_[head & mask];
+  }
+
+  /// \brief publish the slot returned by write_slot()
+  void push() noexcept { head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /// \return the oldest published slot or nullptr when empty
+  [[nodiscard]] auto read_slot() noexcept -> value_t* {
+    auto const tail{ tail_.load(std::memory_order_relaxed) };
+    if (tail == head_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &slots_[tail & mask];
+  }
+
+  /// \brief release the slot returned by read_slot() back to the producer
+  void pop() noexcept { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /// \return number of published slots, only exact when called from one of the two sides
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr std::size_t mask{ capacity - 1 };
+  alignas(cache_line) std::atomic<std::size_t> head_{};
+  alignas(cache_line) std::atomic<std::size_t> tail_{};
+  alignas(cache_line) std::array<value_t, capacity> slots_{};
+};
+
+/**@brief
+ * Histogram of cycle durations with power of two microsecond buckets.
+ * Bucket 0 counts cycles below 1 us, bucket n counts cycles in [2^(n-1), 2^n) us and the last bucket everything above.
+ * */
+class cycle_histogram {
+public:
+  static constexpr std::size_t bucket_count{ 24 };
+
+  void add(std::chrono::nanoseconds duration) noexcept {
+    auto const micro{ std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count(), 0) };
+    auto const bucket{ static_cast<std::size_t>(std::bit_width(static_cast<std::uint64_t>(micro))) };
+    buckets_[std::min(bucket, bucket_count - 1)]++;
+    min_ = std::min(min_, duration);
+    max_ = std::max(max_, duration);
+    count_++;
+  }
+
+  [[nodiscard]] auto buckets() const noexcept -> std::array<std::uint64_t, bucket_count> const& { return buckets_; }
+  /// \return shortest recorded duration, nanoseconds::max() when empty
+  [[nodiscard]] auto min() const noexcept -> std::chrono::nanoseconds { return min_; }
+  /// \return longest recorded duration, nanoseconds::zero() when empty
+  [[nodiscard]] auto max() const noexcept -> std::chrono::nanoseconds { return max_; }
+  [[nodiscard]] auto count() const noexcept -> std::uint64_t { return count_; }
+
+private:
+  std::array<std::uint64_t, bucket_count> buckets_{};
+  std::chrono::nanoseconds min_{ std::chrono::nanoseconds::max() };
+  std::chrono::nanoseconds max_{ std::chrono::nanoseconds::zero() };
+  std::uint64_t count_{};
+};
+
+/// \brief make the calling thread SCHED_FIFO at priority, pin it to cpu if given and lock the process memory
+/// \return error of the first call that failed, the thread keeps whatever was applied before it
+auto make_current_thread_realtime(int priority, std::optional<std::size_t> cpu) -> std::error_code;
+
+/// \brief sleep on CLOCK_MONOTONIC until the absolute deadline, no drift accumulates from the time spent waking up
+void sleep_until(std::chrono::steady_clock::time_point deadline) noexcept;
+
+}  // namespace tfc::ec::realtime
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <tfc/ec/bus.hpp>
+#include <tfc/ec/devices/base.hpp>
+#include <tfc/ec/soem_interface.hpp>
+
+namespace tfc::ec::bus {
+
+/// \brief description of one slave on a simulated segment
+struct virtual_slave {
+  /// \brief fills the inputs the slave returns from the outputs the master sent, the inputs keep their value if empty.
+  /// Called in SAFE_OP and OP on the thread exchanging the frame, it must not call back into the backend.
+  using respond_t = std::function<void(std::span<std::uint8_t const> outputs, std::span<std::uint8_t> inputs)>;
+
+  std::string name{};
+  std::uint32_t vendor_id{};
+  std::uint32_t product_code{};
+  std::uint16_t input_bytes{};
+  std::uint16_t output_bytes{};
+  respond_t respond{};
+
+  /// \return a slave identifying as device_t with the process data sizes its pdo_cycle expects
+  template <typename device_t>
+  static auto of(respond_t respond = {}) -> virtual_slave {
+    using input_pdo = devices::details::input_pdo_t<device_t>;
+    using output_pdo = devices::details::output_pdo_t<device_t>;
+    using default_t = typename device_t::default_t;
+    return { .name = fmt::format("{}", device_t::name),
+             .vendor_id = device_t::vendor_id,
+             .product_code = device_t::product_code,
+             .input_bytes = std::same_as<input_pdo, default_t> ? std::uint16_t{ 0 } : std::uint16_t{ sizeof(input_pdo) },
+             .output_bytes = std::same_as<output_pdo, default_t> ? std::uint16_t{ 0 } : std::uint16_t{ sizeof(output_pdo) },
+             .respond = std::move(respond) };
+  }
+};
+
+/**@brief
+ * A segment of virtual slaves in place of SOEM and a NIC, for running context_t from async_start through OP and the
+ * fieldbus cycle on any linux box. The backend fills the slave and group lists of the SOEM context like
+ * ecx_config_init and ecx_config_overlap_map_group would, calls the PO2SO hooks, walks the slaves through the
+ * requested states and answers every frame by calling respond of each slave in SAFE_OP or OP.
+ * Slaves can be lost and put into SAFE_OP+ERROR to exercise the supervision.
+ * */
+class simulated {
+public:
+  explicit simulated(std::vector<virtual_slave> slaves, std::chrono::nanoseconds roundtrip = {});
+
+  auto init(ecx_contextt* context, std::string_view iface) -> bool;
+  auto config_init(ecx_contextt* context, bool use_config_table) -> bool;
+  auto config_overlap_map_group(ecx_contextt* context, std::span<std::byte> image) -> std::size_t;
+  auto configdc(ecx_contextt* context) -> bool;
+  auto write_state(ecx_contextt* context, std::uint16_t slave) -> ecx::working_counter_t;
+  auto read_state(ecx_contextt* context) -> ec_state;
+  auto statecheck(ecx_contextt* context, std::uint16_t slave, ec_state requested, std::chrono::microseconds timeout)
+      -> ec_state;
+  void send_processdata(ecx_contextt* context);
+  auto receive_processdata(ecx_contextt* context, std::chrono::microseconds timeout) -> ecx::working_counter_t;
+  auto sdo_write(ecx_contextt* context,
+                 std::uint16_t slave,
+                 ecx::index_t index,
+                 ecx::complete_access_t complete_access,
+                 std::span<std::byte> data,
+                 std::chrono::microseconds timeout) -> ecx::working_counter_t;
+  auto reconfig_slave(ecx_contextt* context, std::uint16_t slave, std::chrono::microseconds timeout) -> int;
+  auto recover_slave(ecx_contextt* context, std::uint16_t slave, std::chrono::microseconds timeout) -> int;
+  void close(ecx_contextt* context);
+
+  // Scripting, safe to call from another thread than the one running the cycle
+
+  /// \brief a lost slave stops answering, it drops out of the working counter and reports no state
+  void set_lost(std::uint16_t slave, bool lost);
+  /// \brief the slave falls back to SAFE_OP+ERROR as on a watchdog timeout
+  void inject_error(std::uint16_t slave);
+  /// \return the state the slave is actually in, not what the master last read
+  [[nodiscard]] auto state(std::uint16_t slave) const -> ec_state;
+  /// \return the index and payload of every SDO the master wrote to the slave
+  [[nodiscard]] auto sdo_writes(std::uint16_t slave) const -> std::vector<std::pair<ecx::index_t, std::vector<std::byte>>>;
+  /// \return number of frames answered
+  [[nodiscard]] auto frames() const -> std::uint64_t;
+
+private:
+  struct slave_state {
+    virtual_slave description;
+    ec_state state{ EC_STATE_INIT };
+    bool lost{ false };
+    std::vector<std::pair<ecx::index_t, std::vector<std::byte>>> sdo_writes{};
+  };
+
+  [[nodiscard]] auto valid(std::uint16_t slave) const noexcept -> bool { return slave >= 1 && slave <= slaves_.size(); }
+  [[nodiscard]] auto at(std::uint16_t slave) -> slave_state& { return slaves_[slave - 1]; }
+  [[nodiscard]] auto at(std::uint16_t slave) const -> slave_state const& { return slaves_[slave - 1]; }
+  /// \return state a slave moves to when the master requests requested while it is in current
+  [[nodiscard]] static auto transition(ec_state current, std::uint16_t requested) noexcept -> ec_state;
+  auto read_state_locked(ecx_contextt* context) -> ec_state;
+
+  mutable std::mutex mutex_{};
+  std::vector<slave_state> slaves_{};
+  std::chrono::nanoseconds roundtrip_{};
+  std::vector<std::uint8_t> frame_{};
+  bool frame_pending_{ false };
+  std::uint64_t frames_{};
+};
+
+static_assert(bus_c<simulated>);
+
+}  // namespace tfc::ec::bus
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <fmt/chrono.h>
+
+#include <tfc/ec/bus.hpp>
+#include <tfc/ec/realtime.hpp>
+#include <tfc/ec/soem_interface.hpp>
+#include <tfc/logger.hpp>
+
+namespace tfc::ec {
+
+/// \brief where a slave is on its way back to OP
+enum struct slave_phase_e : std::uint8_t {
+  operational = 0,
+  acknowledging,
+  requesting_op,
+  reconfiguring,
+  confirming_lost,
+  lost,
+  recovering,
+};
+
+constexpr auto format_as(slave_phase_e const value) -> std::string_view {
+  using std::string_view_literals::operator""sv;
+  switch (value) {
+    case slave_phase_e::operational:
+      return "operational"sv;
+    case slave_phase_e::acknowledging:
+      return "acknowledging"sv;
+    case slave_phase_e::requesting_op:
+      return "requesting_op"sv;
+    case slave_phase_e::reconfiguring:
+      return "reconfiguring"sv;
+    case slave_phase_e::confirming_lost:
+      return "confirming_lost"sv;
+    case slave_phase_e::lost:
+      return "lost"sv;
+    case slave_phase_e::recovering:
+      return "recovering"sv;
+  }
+  return "unknown"sv;
+}
+
+/// \brief recovery timing of one slave, degraded_since is only meaningful when not operational
+struct slave_recovery {
+  slave_phase_e phase{ slave_phase_e::operational };
+  std::chrono::steady_clock::time_point degraded_since{};
+  std::uint64_t recoveries{};
+  std::chrono::nanoseconds last{};
+  std::chrono::nanoseconds max{};
+};
+
+/**@brief
+ * Event driven state supervision of the slaves, run on the io_context after each completed cycle.
+ * A drop of the working counter triggers a read of the slave states. The read decides per slave what brings it back to
+ * OP: acknowledge an error, request OP, reconfigure, confirm it lost or recover it. Every state and mailbox operation
+ * goes through a bounded queue and one at a time is handed to a callable of the owner, which runs it between two frames
+ * on the thread exchanging them and calls the completion back on the thread owning the slaves. A new read follows at
+ * most every interval until all slaves are in OP.
+ * */
+template <bus::bus_c bus_t>
+class supervisor {
+public:
+  using clock = std::chrono::steady_clock;
+
+  supervisor(bus_t& bus, ecx_contextt* context, std::chrono::nanoseconds interval = std::chrono::milliseconds{ 10 })
+      : bus_{ bus }, context_{ context }, interval_{ interval } {}
+
+  /// \brief start over for a freshly configured segment, all slaves are expected in OP
+  void reset(std::size_t slave_count) {
+    slaves_.assign(slave_count, slave_recovery{});
+    queued_.assign(slave_count + 1, false);
+    while (queue_.read_slot() != nullptr) {
+      queue_.pop();
+    }
+    check_pending_ = false;
+    in_flight_ = false;
+  }
+
+  /**
+   * Called after every completed cycle on the thread owning the slaves, starts at most one operation
+   * @param wkc working counter of the cycle
+   * @param expected working counter with every slave in OP
+   * @param off_cycle invoked with a callable doing the bus operation and a completion, must run the operation between
+   * two frames on the thread exchanging them and afterwards invoke the completion on the thread owning the slaves,
+   * possibly before returning
+   */
+  template <typename off_cycle_t>
+  void on_cycle(ecx::working_counter_t wkc, ecx::working_counter_t expected, off_cycle_t&& off_cycle) {
+    if (in_flight_) {
+      return;
+    }
+    auto const now{ clock::now() };
+    if ((wkc < expected || check_pending_) && !queued_[0] && now - last_read_ >= interval_) {
+      last_read_ = now;
+      enqueue(operation_e::read_states, 0);
+    }
+    auto* const next{ queue_.read_slot() };
+    if (next == nullptr) {
+      return;
+    }
+    auto const item{ *next };
+    queue_.pop();
+    queued_[item.slave] = false;
+    in_flight_ = true;
+    off_cycle([this, item] { result_ = execute(item); },
+              [this, item] {
+                in_flight_ = false;
+                complete(item);
+              });
+  }
+
+  /// \return recovery timing of slave 1 and up
+  [[nodiscard]] auto slaves() const noexcept -> std::span<slave_recovery const> { return slaves_; }
+
+  /// \return whether any slave was out of OP at the last read
+  [[nodiscard]] auto degraded() const noexcept -> bool { return check_pending_; }
+
+private:
+  enum struct operation_e : std::uint8_t { read_states, acknowledge, request_op, reconfigure, confirm_lost, recover };
+  struct operation {
+    operation_e op{};
+    std::uint16_t slave{};
+  };
+
+  /// \return result of the bus operation, runs on the thread exchanging the frames
+  auto execute(operation item) -> int {
+    auto const idx{ item.slave };
+    auto& slave{ context_->slavelist[idx] };
+    auto const timeout{ ecx::constants::timeout_tx_to_rx };
+    switch (item.op) {
+      case operation_e::read_states:
+        return bus_.read_state(context_);
+      case operation_e::acknowledge:
+        slave.state = EC_STATE_SAFE_OP + EC_STATE_ACK;
+        return bus_.write_state(context_, idx);
+      case operation_e::request_op:
+        slave.state = EC_STATE_OPERATIONAL;
+        return bus_.write_state(context_, idx);
+      case operation_e::reconfigure:
+        return bus_.reconfig_slave(context_, idx, timeout);
+      case operation_e::confirm_lost:
+        return bus_.statecheck(context_, idx, EC_STATE_OPERATIONAL, timeout);
+      case operation_e::recover:
+        return bus_.recover_slave(context_, idx, timeout);
+    }
+    return 0;
+  }
+
+  /// \brief act on the result of an operation, back on the thread owning the slaves
+  void complete(operation item) {
+    auto const idx{ item.slave };
+    auto& slave{ context_->slavelist[idx] };
+    switch (item.op) {
+      case operation_e::read_states:
+        evaluate();
+        break;
+      case operation_e::acknowledge:
+      case operation_e::request_op:
+        break;
+      case operation_e::reconfigure:
+        if (result_ != 0) {
+          slave.islost = FALSE;
+          logger_.warn("Slave {}, {} reconfigured", idx, slave.name);
+        }
+        break;
+      case operation_e::confirm_lost:
+        if (slave.state == EC_STATE_NONE) {
+          slave.islost = TRUE;
+          slaves_[idx - 1].phase = slave_phase_e::lost;
+          logger_.warn("Slave {}, {} lost", idx, slave.name);
+        }
+        break;
+      case operation_e::recover:
+        if (result_ != 0) {
+          slave.islost = FALSE;
+          logger_.info("Slave {}, {} recovered", idx, slave.name);
+        } else {
+          slaves_[idx - 1].phase = slave_phase_e::lost;
+        }
+        break;
+    }
+  }
+
+  /// \brief decide the next operation of every slave from the states just read
+  void evaluate() {
+    auto const now{ clock::now() };
+    bool all_operational{ true };
+    for (std::uint16_t idx = 1; idx <= slaves_.size(); idx++) {
+      auto& slave{ context_->slavelist[idx] };
+      auto& recovery{ slaves_[idx - 1] };
+      if (slave.state != EC_STATE_OPERATIONAL) {
+        all_operational = false;
+        if (recovery.phase == slave_phase_e::operational) {
+          recovery.degraded_since = now;
+        }
+        if (slave.state == EC_STATE_SAFE_OP + EC_STATE_ERROR) {
+          logger_.warn("Slave {}, {} is in SAFE_OP+ERROR, attempting ACK", idx, slave.name);
+          enqueue(operation_e::acknowledge, idx, slave_phase_e::acknowledging);
+        } else if (slave.state == EC_STATE_SAFE_OP) {
+          logger_.warn("Slave {}, {} is in SAFE_OP, change to OPERATIONAL", idx, slave.name);
+          enqueue(operation_e::request_op, idx, slave_phase_e::requesting_op);
+        } else if (slave.state > EC_STATE_NONE) {
+          enqueue(operation_e::reconfigure, idx, slave_phase_e::reconfiguring);
+        } else if (slave.islost == 0) {
+          enqueue(operation_e::confirm_lost, idx, slave_phase_e::confirming_lost);
+        }
+      }
+      if (slave.islost == 1) {
+        if (slave.state != EC_STATE_NONE) {
+          slave.islost = FALSE;
+          logger_.info("Slave {}, {} found", idx, slave.name);
+        } else {
+          enqueue(operation_e::recover, idx, slave_phase_e::recovering);
+        }
+      }
+      if (slave.state == EC_STATE_OPERATIONAL && slave.islost == 0 && recovery.phase != slave_phase_e::operational) {
+        recovery.last = now - recovery.degraded_since;
+        recovery.max = std::max(recovery.max, recovery.last);
+        recovery.recoveries++;
+        recovery.phase = slave_phase_e::operational;
+        logger_.info("Slave {}, {} back in OPERATIONAL after {}", idx, slave.name,
+                     std::chrono::duration_cast<std::chrono::milliseconds>(recovery.last));
+      }
+    }
+    if (check_pending_ && all_operational) {
+      logger_.info("All slaves resumed OPERATIONAL");
+    }
+    check_pending_ = !all_operational;
+  }
+
+  /// \brief a slave has at most one operation queued, anything dropped is decided again by the next read
+  void enqueue(operation_e op, std::uint16_t slave, slave_phase_e phase = slave_phase_e::operational) {
+    if (queued_[slave]) {
+      return;
+    }
+    auto* const slot{ queue_.write_slot() };
+    if (slot == nullptr) {
+      return;
+    }
+    *slot = { .op = op, .slave = slave };
+    queue_.push();
+    queued_[slave] = true;
+    if (slave != 0) {
+      slaves_[slave - 1].phase = phase;
+    }
+  }
+
+  // one operation per slave and the state read
+  static constexpr std::size_t queue_depth{ std::bit_ceil(ecx::constants::max_slave + 1) };
+
+  bus_t& bus_;
+  ecx_contextt* context_;
+  std::chrono::nanoseconds interval_;
+  std::vector<slave_recovery> slaves_{};
+  std::vector<bool> queued_{};
+  realtime::spsc_queue<operation, queue_depth> queue_{};
+  clock::time_point last_read_{};
+  bool check_pending_{ false };
+  // an operation is handed to the owner and its completion has not run yet, the result is read by the completion
+  bool in_flight_{ false };
+  int result_{};
+  tfc::logger::logger logger_{ "ethercat.supervisor" };
+};
+
+}  // namespace tfc::ec
@@ -17,11 +17,12 @@ template <typename manager_client_type,
 el1xxx<manager_client_type, size, entries, pc, name, signal_t>::el1xxx(asio::io_context& ctx,
                                                                        manager_client_type& client,
                                                                        const uint16_t slave_index)
-    : base<el1xxx<manager_client_type, size, entries, pc, name, signal_t>>(slave_index) {
+    : base<el1xxx<manager_client_type, size, entries, pc, name, signal_t>>(slave_index), publish_{ ctx } {
   for (size_t i = 0; i < size; i++) {
     transmitters_[i] = std::make_unique<bool_signal_t>(
         ctx, client, fmt::format("{}.s{}.in{}", name.view(), slave_index, entries[i]), "Digital input");
     /// todo description: skápur - tæki - íhlutur
+    staged_[i] = &publish_.add(*transmitters_[i]);
   }
 }
 
@@ -34,20 +35,22 @@ template <typename manager_client_type,
           typename signal_t>
 void el1xxx<manager_client_type, size, entries, pc, name, signal_t>::pdo_cycle(input_pdo const& input,
                                                                                std::span<std::uint8_t>) noexcept {
+  if (!this->publish_due()) {
+    return;
+  }
   // Loop bytes
   for (size_t idx = 0; idx < input.size(); idx++) {
     for (size_t bits = 0; bits < 8 && size - ((idx * 8) + bits) > 0; bits++) {
       auto const value = static_cast<bool>(input[idx] & (1 << bits));
       const size_t bit_index = idx * 8 + bits;
       if (!last_values_[bit_index].has_value() || value != last_values_[bit_index]) {
-        transmitters_[bit_index]->async_send(value, [this](std::error_code error, size_t) {
-          if (error) {
-            this->logger_.error("Ethercat {}, error transmitting : {}", name.view(), error.message());
-          }
-        });
+        staged_[bit_index]->stage(value);
       }
       last_values_[bit_index] = value;
     }
   }
+  if (auto error{ publish_.flush() }) {
+    this->logger_.error("Ethercat {}, error transmitting : {}", name.view(), error.message());
+  }
 }
 }  // namespace tfc::ec::devices::beckhoff
@@ -0,0 +1,42 @@
+#include <cerrno>
+#include <ctime>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include <tfc/ec/realtime.hpp>
+
+namespace tfc::ec::realtime {
+
+auto make_current_thread_realtime(int priority, std::optional<std::size_t> cpu) -> std::error_code {
+  // page faults in the cycle would be as bad as any lock
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    return { errno, std::system_category() };
+  }
+  if (cpu.has_value()) {
+    cpu_set_t set{};
+    CPU_ZERO(&set);
+    CPU_SET(cpu.value(), &set);
+    if (auto const err{ pthread_setaffinity_np(pthread_self(), sizeof(set), &set) }; err != 0) {
+      return { err, std::system_category() };
+    }
+  }
+  sched_param const param{ .sched_priority = priority };
+  if (auto const err{ pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) }; err != 0) {
+    return { err, std::system_category() };
+  }
+  return {};
+}
+
+void sleep_until(std::chrono::steady_clock::time_point deadline) noexcept {
+  // steady_clock is CLOCK_MONOTONIC on linux
+  auto const since_epoch{ deadline.time_since_epoch() };
+  auto const seconds{ std::chrono::duration_cast<std::chrono::seconds>(since_epoch) };
+  timespec const wake{ .tv_sec = static_cast<std::time_t>(seconds.count()),
+                       .tv_nsec = static_cast<long>(std::chrono::nanoseconds{ since_epoch - seconds }.count()) };
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr) == EINTR) {
+  }
+}
+
+}  // namespace tfc::ec::realtime
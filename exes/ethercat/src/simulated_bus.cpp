@@ -0,0 +1,291 @@
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include <tfc/ec/simulated_bus.hpp>
+
+namespace tfc::ec::bus {
+
+namespace {
+constexpr std::uint16_t state_mask{ 0x0f };
+}  // namespace
+
+simulated::simulated(std::vector<virtual_slave> slaves, std::chrono::nanoseconds roundtrip) : roundtrip_{ roundtrip } {
+  slaves_.reserve(slaves.size());
+  for (auto& description : slaves) {
+    slaves_.push_back({ .description = std::move(description) });
+  }
+}
+
+auto simulated::init(ecx_contextt* context, std::string_view) -> bool {
+  std::lock_guard const lock{ mutex_ };
+  std::fill_n(context->slavelist, context->maxslave, ec_slavet{});
+  std::fill_n(context->grouplist, context->maxgroup, ec_groupt{});
+  *context->slavecount = 0;
+  *context->elist = ec_eringt{};
+  *context->ecaterror = FALSE;
+  return true;
+}
+
+auto simulated::config_init(ecx_contextt* context, bool) -> bool {
+  std::lock_guard const lock{ mutex_ };
+  if (slaves_.empty() || slaves_.size() >= static_cast<std::size_t>(context->maxslave)) {
+    return false;
+  }
+  *context->slavecount = static_cast<int>(slaves_.size());
+  for (std::uint16_t idx = 1; idx <= slaves_.size(); idx++) {
+    auto& simulated_slave{ at(idx) };
+    simulated_slave.state = simulated_slave.lost ? EC_STATE_NONE : EC_STATE_INIT;
+    auto const& description{ simulated_slave.description };
+    auto& slave{ context->slavelist[idx] };
+    slave = ec_slavet{};
+    fmt::format_to_n(slave.name, sizeof(slave.name) - 1, "{}", description.name);
+    slave.eep_man = description.vendor_id;
+    slave.eep_id = description.product_code;
+    slave.configadr = static_cast<std::uint16_t>(0x1000 + idx);
+    slave.Ibytes = description.input_bytes;
+    slave.Ibits = static_cast<std::uint16_t>(description.input_bytes * 8);
+    slave.Obytes = description.output_bytes;
+    slave.Obits = static_cast<std::uint16_t>(description.output_bytes * 8);
+    slave.state = simulated_slave.state;
+  }
+  return true;
+}
+
+auto simulated::config_overlap_map_group(ecx_contextt* context, std::span<std::byte> image) -> std::size_t {
+  // The hooks write SDOs through sdo_write, so they run before the lock is taken
+  for (std::uint16_t idx = 1; idx <= slaves_.size(); idx++) {
+    if (auto* hook{ context->slavelist[idx].PO2SOconfigx }; hook != nullptr) {
+      hook(context, idx);
+    }
+  }
+
+  std::lock_guard const lock{ mutex_ };
+  std::size_t output_bytes{};
+  std::size_t input_bytes{};
+  for (auto const& slave : slaves_) {
+    output_bytes += slave.description.output_bytes;
+    input_bytes += slave.description.input_bytes;
+  }
+  if (output_bytes + input_bytes > image.size()) {
+    throw std::runtime_error(fmt::format("Simulated process image of {} bytes does not fit in {} bytes",
+                                         output_bytes + input_bytes, image.size()));
+  }
+  // Same layout as SOEM overlap mapping, all outputs first and the inputs after them
+  auto* const base{ reinterpret_cast<std::uint8_t*>(image.data()) };
+  auto& group{ context->grouplist[0] };
+  group = ec_groupt{};
+  group.outputs = base;
+  group.Obytes = static_cast<std::uint32_t>(output_bytes);
+  group.inputs = base + output_bytes;
+  group.Ibytes = static_cast<std::uint32_t>(input_bytes);
+  std::size_t output_offset{};
+  std::size_t input_offset{ output_bytes };
+  for (std::uint16_t idx = 1; idx <= slaves_.size(); idx++) {
+    auto& slave{ context->slavelist[idx] };
+    if (slave.Obytes > 0) {
+      slave.outputs = base + output_offset;
+      output_offset += slave.Obytes;
+      group.outputsWKC++;
+    }
+    if (slave.Ibytes > 0) {
+      slave.inputs = base + input_offset;
+      input_offset += slave.Ibytes;
+      group.inputsWKC++;
+    }
+  }
+  frame_.assign(output_bytes, 0);
+  frame_pending_ = false;
+  return output_bytes + input_bytes;
+}
+
+auto simulated::configdc(ecx_contextt*) -> bool {
+  return true;
+}
+
+auto simulated::write_state(ecx_contextt* context, std::uint16_t slave) -> ecx::working_counter_t {
+  std::lock_guard const lock{ mutex_ };
+  ecx::working_counter_t wkc{};
+  auto const requested{ context->slavelist[slave].state };
+  for (std::uint16_t idx = 1; idx <= slaves_.size(); idx++) {
+    auto& simulated_slave{ at(idx) };
+    if ((slave == 0 || slave == idx) && !simulated_slave.lost) {
+      simulated_slave.state = transition(simulated_slave.state, requested);
+      wkc++;
+    }
+  }
+  return wkc;
+}
+
+auto simulated::read_state(ecx_contextt* context) -> ec_state {
+  std::lock_guard const lock{ mutex_ };
+  return read_state_locked(context);
+}
+
+auto simulated::statecheck(ecx_contextt* context, std::uint16_t slave, ec_state, std::chrono::microseconds) -> ec_state {
+  // Transitions are instant, no need to poll until the timeout
+  std::lock_guard const lock{ mutex_ };
+  auto const lowest{ read_state_locked(context) };
+  if (slave == 0) {
+    return lowest;
+  }
+  return static_cast<ec_state>(context->slavelist[slave].state);
+}
+
+void simulated::send_processdata(ecx_contextt* context) {
+  std::lock_guard const lock{ mutex_ };
+  auto const& group{ context->grouplist[0] };
+  if (group.outputs != nullptr) {
+    std::copy_n(group.outputs, frame_.size(), frame_.begin());
+  }
+  frame_pending_ = true;
+}
+
+auto simulated::receive_processdata(ecx_contextt* context, std::chrono::microseconds) -> ecx::working_counter_t {
+  std::unique_lock lock{ mutex_ };
+  if (!frame_pending_) {
+    return EC_NOFRAME;
+  }
+  frame_pending_ = false;
+  auto const& group{ context->grouplist[0] };
+  ecx::working_counter_t wkc{};
+  for (std::uint16_t idx = 1; idx <= slaves_.size(); idx++) {
+    auto const& simulated_slave{ at(idx) };
+    auto const running{ simulated_slave.state & state_mask };
+    if (simulated_slave.lost || running < EC_STATE_SAFE_OP) {
+      continue;
+    }
+    auto const& slave{ context->slavelist[idx] };
+    std::span<std::uint8_t const> outputs{};
+    if (slave.outputs != nullptr) {
+      outputs = std::span{ frame_ }.subspan(static_cast<std::size_t>(slave.outputs - group.outputs), slave.Obytes);
+      // Outputs are only applied in OP, the slave keeps its safe state until then
+      wkc += running == EC_STATE_OPERATIONAL ? 2 : 0;
+    }
+    std::span<std::uint8_t> inputs{};
+    if (slave.inputs != nullptr) {
+      inputs = { slave.inputs, slave.Ibytes };
+      wkc += 1;
+    }
+    if (simulated_slave.description.respond) {
+      simulated_slave.description.respond(outputs, inputs);
+    }
+  }
+  frames_++;
+  lock.unlock();
+  if (roundtrip_ > std::chrono::nanoseconds::zero()) {
+    std::this_thread::sleep_for(roundtrip_);
+  }
+  return wkc;
+}
+
+auto simulated::sdo_write(ecx_contextt*,
+                          std::uint16_t slave,
+                          ecx::index_t index,
+                          ecx::complete_access_t,
+                          std::span<std::byte> data,
+                          std::chrono::microseconds) -> ecx::working_counter_t {
+  std::lock_guard const lock{ mutex_ };
+  if (!valid(slave) || at(slave).lost) {
+    return 0;
+  }
+  at(slave).sdo_writes.emplace_back(index, std::vector<std::byte>{ data.begin(), data.end() });
+  return 1;
+}
+
+auto simulated::reconfig_slave(ecx_contextt* context, std::uint16_t slave, std::chrono::microseconds) -> int {
+  {
+    std::lock_guard const lock{ mutex_ };
+    if (!valid(slave) || at(slave).lost) {
+      return 0;
+    }
+  }
+  if (auto* hook{ context->slavelist[slave].PO2SOconfigx }; hook != nullptr) {
+    hook(context, slave);
+  }
+  std::lock_guard const lock{ mutex_ };
+  at(slave).state = EC_STATE_SAFE_OP;
+  context->slavelist[slave].state = EC_STATE_SAFE_OP;
+  return EC_STATE_SAFE_OP;
+}
+
+auto simulated::recover_slave(ecx_contextt*, std::uint16_t slave, std::chrono::microseconds) -> int {
+  std::lock_guard const lock{ mutex_ };
+  if (!valid(slave) || at(slave).lost) {
+    return 0;
+  }
+  at(slave).state = EC_STATE_INIT;
+  return 1;
+}
+
+void simulated::close(ecx_contextt*) {
+  std::lock_guard const lock{ mutex_ };
+  frame_pending_ = false;
+}
+
+void simulated::set_lost(std::uint16_t slave, bool lost) {
+  std::lock_guard const lock{ mutex_ };
+  if (!valid(slave)) {
+    return;
+  }
+  at(slave).lost = lost;
+  // A slave coming back has been power cycled
+  at(slave).state = lost ? EC_STATE_NONE : EC_STATE_INIT;
+}
+
+void simulated::inject_error(std::uint16_t slave) {
+  std::lock_guard const lock{ mutex_ };
+  if (valid(slave) && !at(slave).lost) {
+    at(slave).state = static_cast<ec_state>(EC_STATE_SAFE_OP | EC_STATE_ERROR);
+  }
+}
+
+auto simulated::state(std::uint16_t slave) const -> ec_state {
+  std::lock_guard const lock{ mutex_ };
+  if (!valid(slave) || at(slave).lost) {
+    return EC_STATE_NONE;
+  }
+  return at(slave).state;
+}
+
+auto simulated::sdo_writes(std::uint16_t slave) const -> std::vector<std::pair<ecx::index_t, std::vector<std::byte>>> {
+  std::lock_guard const lock{ mutex_ };
+  if (!valid(slave)) {
+    return {};
+  }
+  return at(slave).sdo_writes;
+}
+
+auto simulated::frames() const -> std::uint64_t {
+  std::lock_guard const lock{ mutex_ };
+  return frames_;
+}
+
+auto simulated::transition(ec_state current, std::uint16_t requested) noexcept -> ec_state {
+  auto const target{ static_cast<std::uint16_t>(requested & state_mask) };
+  if (target == EC_STATE_NONE) {
+    return current;
+  }
+  // An error is only left when the master acknowledges it
+  if ((current & EC_STATE_ERROR) != 0 && (requested & EC_STATE_ACK) == 0) {
+    return current;
+  }
+  return static_cast<ec_state>(target);
+}
+
+auto simulated::read_state_locked(ecx_contextt* context) -> ec_state {
+  std::uint16_t lowest{ EC_STATE_OPERATIONAL };
+  for (std::uint16_t idx = 1; idx <= slaves_.size(); idx++) {
+    auto const& simulated_slave{ at(idx) };
+    auto const state{ simulated_slave.lost ? std::uint16_t{ EC_STATE_NONE }
+                                           : static_cast<std::uint16_t>(simulated_slave.state) };
+    context->slavelist[idx].state = state;
+    lowest = std::min<std::uint16_t>(lowest, state & state_mask);
+  }
+  context->slavelist[0].state = lowest;
+  return static_cast<ec_state>(lowest);
+}
+
+}  // namespace tfc::ec::bus
@@ -50,18 +50,37 @@ auto main(int argc, const char* argv[]) -> int {
       };
       std::array buffer{ std::uint8_t{ 0b11 } };
       auto const& transmitters{ vars.device.transmitters() };
-      EXPECT_CALL(*transmitters.at(0), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(1), async_send_cb(true, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(0), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(true)).Times(1);
       vars.device.process_data(buffer, {});
       buffer = { std::uint8_t{ 0b00 } };
-      EXPECT_CALL(*transmitters.at(0), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(1), async_send_cb(false, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(0), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(false)).Times(1);
       vars.device.process_data(buffer, {});
 
       // Only calls when value changes
       buffer = { std::uint8_t{ 0b01 } };
-      EXPECT_CALL(*transmitters.at(0), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(1), async_send_cb(false, testing::_)).Times(0);
+      EXPECT_CALL(*transmitters.at(0), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(false)).Times(0);
+      vars.device.process_data(buffer, {});
+    };
+    "publish divisor"_test = [] {
+      test_vars<beckhoff::el1002<ipc_manager_client_mock, tfc::ipc::mock_signal>> vars{
+        .device = { vars.ctx, vars.connect_interface, 42 }
+      };
+      vars.device.set_publish_divisor(3);
+      std::array buffer{ std::uint8_t{ 0b01 } };
+      auto const& transmitters{ vars.device.transmitters() };
+      EXPECT_CALL(*transmitters.at(0), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(false)).Times(1);
+      vars.device.process_data(buffer, {});
+
+      // Changes in between are published on the next due cycle
+      buffer = { std::uint8_t{ 0b10 } };
+      vars.device.process_data(buffer, {});
+      vars.device.process_data(buffer, {});
+      EXPECT_CALL(*transmitters.at(0), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(true)).Times(1);
       vars.device.process_data(buffer, {});
     };
     "8 input"_test = [] {
@@ -70,36 +89,36 @@ auto main(int argc, const char* argv[]) -> int {
       };
       std::array buffer{ std::uint8_t{ 0b11111111 } };
       auto const& transmitters{ vars.device.transmitters() };
-      EXPECT_CALL(*transmitters.at(0), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(1), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(2), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(3), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(4), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(5), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(6), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(7), async_send_cb(true, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(0), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(2), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(3), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(4), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(5), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(6), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(7), send(true)).Times(1);
       vars.device.process_data(buffer, {});
       buffer = { std::uint8_t{ 0b00000000 } };
-      EXPECT_CALL(*transmitters.at(0), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(1), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(2), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(3), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(4), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(5), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(6), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(7), async_send_cb(false, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(0), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(2), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(3), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(4), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(5), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(6), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(7), send(false)).Times(1);
       vars.device.process_data(buffer, {});
 
       // Only calls when value changes
       buffer = { std::uint8_t{ 0b01010101 } };
-      EXPECT_CALL(*transmitters.at(0), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(1), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(2), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(3), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(4), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(5), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(6), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(7), async_send_cb(false, testing::_)).Times(0);
+      EXPECT_CALL(*transmitters.at(0), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(2), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(3), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(4), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(5), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(6), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(7), send(false)).Times(0);
       vars.device.process_data(buffer, {});
     };
   };
@@ -149,63 +168,63 @@ auto main(int argc, const char* argv[]) -> int {
       std::array input{ std::uint8_t{ 0b11111111 }, std::uint8_t{ 0b11111111 } };
       auto const& transmitters{ vars.device.transmitters() };
 
-      EXPECT_CALL(*transmitters.at(0), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(1), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(2), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(3), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(4), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(5), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(6), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(7), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(8), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(9), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(10), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(11), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(12), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(13), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(14), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(15), async_send_cb(true, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(0), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(2), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(3), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(4), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(5), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(6), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(7), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(8), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(9), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(10), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(11), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(12), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(13), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(14), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(15), send(true)).Times(1);
 
       vars.device.process_data(input, output);
 
       input = { std::uint8_t{ 0b00000000 }, std::uint8_t{ 0b00000000 } };
-      EXPECT_CALL(*transmitters.at(0), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(1), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(2), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(3), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(4), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(5), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(6), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(7), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(8), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(9), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(10), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(11), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(12), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(13), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(14), async_send_cb(false, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(15), async_send_cb(false, testing::_)).Times(1);
+      EXPECT_CALL(*transmitters.at(0), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(2), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(3), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(4), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(5), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(6), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(7), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(8), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(9), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(10), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(11), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(12), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(13), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(14), send(false)).Times(1);
+      EXPECT_CALL(*transmitters.at(15), send(false)).Times(1);
 
       vars.device.process_data(input, output);
 
       // Only calls when value changes
       input = { std::uint8_t{ 0b01010101 }, std::uint8_t{ 0b01010101 } };
-      EXPECT_CALL(*transmitters.at(0), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(1), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(2), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(3), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(4), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(5), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(6), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(7), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(8), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(9), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(10), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(11), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(12), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(13), async_send_cb(false, testing::_)).Times(0);
-      EXPECT_CALL(*transmitters.at(14), async_send_cb(true, testing::_)).Times(1);
-      EXPECT_CALL(*transmitters.at(15), async_send_cb(false, testing::_)).Times(0);
+      EXPECT_CALL(*transmitters.at(0), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(1), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(2), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(3), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(4), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(5), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(6), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(7), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(8), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(9), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(10), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(11), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(12), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(13), send(false)).Times(0);
+      EXPECT_CALL(*transmitters.at(14), send(true)).Times(1);
+      EXPECT_CALL(*transmitters.at(15), send(false)).Times(0);
       vars.device.process_data(input, output);
     };
 
@@ -0,0 +1,127 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <fmt/core.h>
+
+#include <tfc/ec/devices/device.hpp>
+#include <tfc/ec/devices/dispatch.hpp>
+#include <tfc/ec/soem_interface.hpp>
+#include <tfc/ipc.hpp>
+#include <tfc/progbase.hpp>
+
+// CPU time of running the devices of a simulated bus once, the work done on the process image every cycle.
+// before: walk the SOEM slave list and visit the device variant with size checks every cycle, as ec.hpp did
+// after: the flat dispatch table built once after the process image is mapped
+
+namespace asio = boost::asio;
+namespace devices = tfc::ec::devices;
+namespace beckhoff = tfc::ec::devices::beckhoff;
+
+using device_t = devices::device<tfc::ipc_ruler::ipc_manager_client>;
+
+namespace {
+
+constexpr std::size_t slave_count{ 100 };
+constexpr std::size_t cycles{ 100000 };
+
+struct simulated_bus {
+  explicit simulated_bus(asio::io_context& ctx) {
+    slavelist.resize(slave_count + 1);
+    slaves.reserve(slave_count + 1);
+    slaves.emplace_back(std::in_place_type<devices::default_device>, 0);
+    std::size_t offset{};
+    for (std::size_t idx = 1; idx <= slave_count; idx++) {
+      auto const slave_index{ static_cast<std::uint16_t>(idx) };
+      auto& slave{ slavelist[idx] };
+      // a coupler every 10th slave, analog inputs and outputs in between
+      if (idx % 10 == 1) {
+        slaves.emplace_back(std::in_place_type<beckhoff::ek1100>, slave_index);
+      } else if (idx % 2 == 0) {
+        slaves.emplace_back(std::in_place_type<beckhoff::el3054>, ctx, slave_index);
+        slave.Ibytes = sizeof(std::array<beckhoff::temporary, 4>);
+        slave.inputs = image.data() + offset;
+        offset += slave.Ibytes;
+      } else {
+        slaves.emplace_back(std::in_place_type<beckhoff::el4002>, ctx, slave_index);
+        slave.Obytes = sizeof(beckhoff::el4002::output_pdo);
+        slave.outputs = image.data() + offset;
+        offset += slave.Obytes;
+      }
+    }
+    for (std::size_t idx = 1; idx <= slave_count; idx++) {
+      auto const& slave{ slavelist[idx] };
+      table.push_back(slaves[idx].dispatch_entry(static_cast<std::uint16_t>(idx), region(slave.inputs, slave.Ibytes),
+                                                 region(slave.outputs, slave.Obytes)));
+    }
+  }
+
+  [[nodiscard]] auto region(std::uint8_t const* pointer, std::size_t size) const -> devices::dispatch_table::region {
+    if (pointer == nullptr) {
+      return {};
+    }
+    return { .offset = static_cast<std::uint32_t>(pointer - image.data()), .size = static_cast<std::uint32_t>(size) };
+  }
+
+  void run_slave_list() {
+    std::span<std::uint8_t> input;
+    std::span<std::uint8_t> output;
+    for (std::size_t i = 1; i < slave_count + 1; i++) {
+      auto& slave{ slavelist[i] };
+      if (slave.inputs != nullptr) {
+        input = { slave.inputs, slave.Ibytes };
+      }
+      if (slave.outputs != nullptr) {
+        output = { slave.outputs, slave.Obytes };
+      }
+      if (slave.islost) {
+        slaves[i].process_data({}, {});
+      } else {
+        slaves[i].process_data(input, output);
+      }
+    }
+  }
+
+  void run_table() {
+    table.run(image.data(), [this](std::uint16_t slave) { return slavelist[slave].islost != 0U; });
+  }
+
+  std::array<std::uint8_t, 4096> image{};
+  std::vector<ec_slavet> slavelist{};
+  std::vector<device_t> slaves{};
+  devices::dispatch_table table{};
+};
+
+/// \return nanoseconds per call of function
+auto measure(auto&& function) -> double {
+  auto const start{ std::chrono::steady_clock::now() };
+  for (std::size_t idx = 0; idx < cycles; idx++) {
+    function();
+  }
+  std::chrono::duration<double, std::nano> const elapsed{ std::chrono::steady_clock::now() - start };
+  return elapsed.count() / static_cast<double>(cycles);
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  tfc::base::init(argc, argv);
+
+  asio::io_context ctx{};
+  simulated_bus bus{ ctx };
+
+  // warm up both paths before measuring
+  measure([&bus] { bus.run_slave_list(); });
+  measure([&bus] { bus.run_table(); });
+  auto const before{ measure([&bus] { bus.run_slave_list(); }) };
+  auto const after{ measure([&bus] { bus.run_table(); }) };
+
+  fmt::print("{} slaves  slave list {:>9.1f} ns/cycle  dispatch table {:>9.1f} ns/cycle  ({:.2f}x)\n", slave_count, before,
+             after, before / after);
+  return 0;
+}
@@ -0,0 +1,121 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/program_options.hpp>
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+
+#include <tfc/ec.hpp>
+#include <tfc/ec/simulated_bus.hpp>
+#include <tfc/progbase.hpp>
+
+// Runs context_t from async_start through OP and the fieldbus cycle against a segment of virtual slaves and prints
+// the cycle period and roundtrip for each slave count. The digital input slaves toggle every 100 frames so their
+// signals publish, which puts the ipc fan-out into the measured cycle. The cycle time and real-time mode are taken
+// from the ethercat config like on real hardware.
+
+namespace asio = boost::asio;
+namespace bpo = boost::program_options;
+namespace bus = tfc::ec::bus;
+namespace beckhoff = tfc::ec::devices::beckhoff;
+namespace realtime = tfc::ec::realtime;
+
+using manager_client_t = tfc::ipc_ruler::ipc_manager_client;
+
+namespace {
+
+struct options {
+  std::vector<std::size_t> slaves{ 10, 50, 100, 200 };
+  std::uint64_t duration{ 5 };
+  std::uint64_t roundtrip{ 0 };
+};
+
+/// \brief a station of ten slaves, a coupler followed by digital and analog terminals
+auto make_segment(std::size_t count) -> std::vector<bus::virtual_slave> {
+  std::vector<bus::virtual_slave> slaves{};
+  slaves.reserve(count);
+  for (std::size_t idx = 0; idx < count; idx++) {
+    switch (idx % 10) {
+      case 0:
+        slaves.push_back(bus::virtual_slave::of<beckhoff::ek1100>());
+        break;
+      case 1:
+      case 2:
+      case 3:
+        slaves.push_back(bus::virtual_slave::of<beckhoff::el1008<manager_client_t>>(
+            [frame = std::uint64_t{}](std::span<std::uint8_t const>, std::span<std::uint8_t> inputs) mutable {
+              inputs[0] = static_cast<std::uint8_t>(frame++ / 100);
+            }));
+        break;
+      case 4:
+      case 5:
+        slaves.push_back(bus::virtual_slave::of<beckhoff::el2008<manager_client_t>>());
+        break;
+      case 6:
+      case 7:
+        slaves.push_back(bus::virtual_slave::of<beckhoff::el3054>());
+        break;
+      default:
+        slaves.push_back(bus::virtual_slave::of<beckhoff::el4002>());
+        break;
+    }
+  }
+  return slaves;
+}
+
+/// \return upper bound in microseconds of the bucket holding the given fraction of the cycles
+auto percentile(realtime::cycle_histogram const& histogram, double fraction) -> std::uint64_t {
+  auto const wanted{ static_cast<std::uint64_t>(static_cast<double>(histogram.count()) * fraction) };
+  std::uint64_t seen{};
+  for (std::size_t bucket = 0; bucket < histogram.buckets().size(); bucket++) {
+    seen += histogram.buckets()[bucket];
+    if (seen >= wanted) {
+      return std::uint64_t{ 1 } << bucket;
+    }
+  }
+  return std::uint64_t{ 1 } << (histogram.buckets().size() - 1);
+}
+
+auto micro(std::chrono::nanoseconds value) -> double {
+  return std::chrono::duration<double, std::micro>{ value }.count();
+}
+
+void bench(std::size_t slave_count, options const& opts) {
+  asio::io_context ctx{};
+  tfc::ec::context_t<4096, bus::simulated> ethercat{ ctx, make_segment(slave_count),
+                                                     std::chrono::microseconds{ opts.roundtrip } };
+  ethercat.async_start();
+  ctx.run_for(std::chrono::seconds{ opts.duration });
+
+  auto const& period{ ethercat.period_histogram() };
+  auto const& roundtrip{ ethercat.roundtrip_histogram() };
+  fmt::println("{:>4} slaves  cycle {} us  {:>8} cycles  period min {:>8.1f} us  p99 < {:>6} us  max {:>9.1f} us  "
+               "roundtrip min {:>7.1f} us  p99 < {:>6} us  max {:>9.1f} us",
+               slave_count, std::chrono::duration_cast<std::chrono::microseconds>(ethercat.cycle_time()).count(),
+               period.count(), micro(period.min()), percentile(period, 0.99), micro(period.max()), micro(roundtrip.min()),
+               percentile(roundtrip, 0.99), micro(roundtrip.max()));
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  options opts{};
+  auto description{ tfc::base::default_description() };
+  // clang-format off
+  description.add_options()
+    ("slaves", bpo::value<std::vector<std::size_t>>(&opts.slaves)->multitoken()->default_value(opts.slaves, fmt::format("{}", fmt::join(opts.slaves, " "))), "Numbers of virtual slaves to sweep")
+    ("duration", bpo::value<std::uint64_t>(&opts.duration)->default_value(opts.duration), "Seconds to run each slave count for")
+    ("roundtrip", bpo::value<std::uint64_t>(&opts.roundtrip)->default_value(opts.roundtrip), "Microseconds the simulated frame spends on the wire");
+  // clang-format on
+  tfc::base::init(argc, argv, description);
+
+  for (auto const slave_count : opts.slaves) {
+    bench(slave_count, opts);
+  }
+  return 0;
+}
@@ -0,0 +1,317 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <thread>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/ut.hpp>
+
+#include <tfc/cia/402.hpp>
+#include <tfc/ec.hpp>
+#include <tfc/ec/devices/beckhoff/EK1xxx.hpp>
+#include <tfc/ec/devices/beckhoff/EL4xxx.hpp>
+#include <tfc/ec/devices/schneider/lxm32m.hpp>
+#include <tfc/ec/simulated_bus.hpp>
+#include <tfc/progbase.hpp>
+
+namespace asio = boost::asio;
+namespace ut = boost::ut;
+namespace bus = tfc::ec::bus;
+namespace cia_402 = tfc::ec::cia_402;
+namespace beckhoff = tfc::ec::devices::beckhoff;
+namespace schneider = tfc::ec::devices::schneider;
+
+using manager_client_t = tfc::ipc_ruler::ipc_manager_client;
+
+namespace {
+/// \brief a drive walking the CiA 402 state machine on the control words it receives, the device on the master
+/// answers each status word with the next control word so the drive only reaches operation enabled on a round trip
+struct virtual_drive {
+  std::atomic<std::uint16_t> control_word{};
+  std::atomic<std::int32_t> velocity{};
+  std::atomic<cia_402::states_e> state{ cia_402::states_e::switch_on_disabled };
+
+  auto respond() -> bus::virtual_slave::respond_t {
+    return [this](std::span<std::uint8_t const> outputs, std::span<std::uint8_t> inputs) {
+      schneider::output_pdo command{};
+      std::memcpy(&command, outputs.data(), std::min(outputs.size(), sizeof(command)));
+      control_word.store(std::bit_cast<std::uint16_t>(command.ctrl_word));
+      velocity.store(command.velocity.value);
+
+      using enum cia_402::states_e;
+      auto const current{ state.load() };
+      auto const& word{ command.ctrl_word };
+      cia_402::status_word status{ .state_switch_on_disabled = true };
+      if (!word.enable_voltage) {
+        state.store(switch_on_disabled);
+      } else if (!word.switch_on && current == switch_on_disabled) {
+        state.store(ready_to_switch_on);
+      } else if (word.switch_on && word.enable_operation && (current == ready_to_switch_on || current == switched_on)) {
+        state.store(operation_enabled);
+      }
+      switch (state.load()) {
+        case ready_to_switch_on:
+          status = { .state_ready_to_switch_on = true, .state_quick_stop = true };
+          break;
+        case operation_enabled:
+          status = { .state_ready_to_switch_on = true,
+                     .state_switched_on = true,
+                     .state_operation_enabled = true,
+                     .voltage_enabled = true,
+                     .state_quick_stop = true };
+          break;
+        default:
+          break;
+      }
+      std::memcpy(inputs.data(), &status, std::min(inputs.size(), sizeof(status)));
+    };
+  }
+};
+
+/**@brief
+ * The simulated segment with every call checked for running at the same time as a frame exchange or a call of another
+ * thread. SOEM shares the error list and index stack of the context between them, the lock of the simulated segment
+ * would hide such a race. State and mailbox operations take a few cycles, as on a real segment, so any overlap shows.
+ * */
+class exclusive_segment : public bus::simulated {
+public:
+  using simulated::simulated;
+
+  auto write_state(ecx_contextt* context, std::uint16_t slave) -> ecx::working_counter_t {
+    scope const entry{ *this };
+    return simulated::write_state(context, slave);
+  }
+  auto read_state(ecx_contextt* context) -> ec_state {
+    scope const entry{ *this };
+    return simulated::read_state(context);
+  }
+  auto statecheck(ecx_contextt* context, std::uint16_t slave, ec_state requested, std::chrono::microseconds timeout)
+      -> ec_state {
+    scope const entry{ *this };
+    return simulated::statecheck(context, slave, requested, timeout);
+  }
+  // a frame is exchanged from its send to its receive
+  void send_processdata(ecx_contextt* context) {
+    enter(false);
+    simulated::send_processdata(context);
+  }
+  auto receive_processdata(ecx_contextt* context, std::chrono::microseconds timeout)
+      -> ecx::working_counter_t {
+    auto const wkc{ simulated::receive_processdata(context, timeout) };
+    leave();
+    return wkc;
+  }
+  auto sdo_write(ecx_contextt* context,
+                 std::uint16_t slave,
+                 ecx::index_t index,
+                 ecx::complete_access_t complete_access,
+                 std::span<std::byte> data,
+                 std::chrono::microseconds timeout) -> ecx::working_counter_t {
+    scope const entry{ *this };
+    return simulated::sdo_write(context, slave, index, complete_access, data, timeout);
+  }
+  auto reconfig_slave(ecx_contextt* context, std::uint16_t slave, std::chrono::microseconds timeout) -> int {
+    scope const entry{ *this };
+    auto& hook{ context->slavelist[slave].PO2SOconfigx };
+    lender_ = this;
+    lent_hook_ = std::exchange(hook, &lend);
+    auto const result{ simulated::reconfig_slave(context, slave, timeout) };
+    hook = lent_hook_;
+    return result;
+  }
+  auto recover_slave(ecx_contextt* context, std::uint16_t slave, std::chrono::microseconds timeout) -> int {
+    scope const entry{ *this };
+    return simulated::recover_slave(context, slave, timeout);
+  }
+
+  /// \return calls which started while another thread was using the segment
+  [[nodiscard]] auto overlaps() const noexcept -> std::uint64_t { return overlaps_.load(); }
+  /// \return state and mailbox operations, frames not included
+  [[nodiscard]] auto operations() const noexcept -> std::uint64_t { return operations_.load(); }
+
+private:
+  struct scope {
+    explicit scope(exclusive_segment& segment) : segment_{ segment } { segment_.enter(true); }
+    scope(scope const&) = delete;
+    auto operator=(scope const&) -> scope& = delete;
+    ~scope() { segment_.leave(); }
+    exclusive_segment& segment_;
+  };
+
+  void enter(bool operation) {
+    // the PO2SO hook of a reconfigured slave writes SDOs from within reconfig_slave
+    if (depth_++ != 0) {
+      return;
+    }
+    if (busy_.exchange(true)) {
+      overlaps_++;
+    }
+    if (operation) {
+      operations_++;
+      std::this_thread::sleep_for(std::chrono::milliseconds{ 3 });
+    }
+  }
+  void leave() {
+    if (--depth_ == 0) {
+      busy_.store(false);
+    }
+  }
+
+  /// \brief the PO2SO hook may hand the segment to another thread while the reconfiguring one waits for it
+  static auto lend(ecx_contextt* context, std::uint16_t slave) -> int {
+    auto* const self{ lender_ };
+    auto const depth{ std::exchange(depth_, 0) };
+    self->busy_.store(false);
+    auto const result{ lent_hook_(context, slave) };
+    if (self->busy_.exchange(true)) {
+      self->overlaps_++;
+    }
+    depth_ = depth;
+    return result;
+  }
+
+  static inline thread_local int depth_{};
+  static inline thread_local exclusive_segment* lender_{};
+  static inline thread_local int (*lent_hook_)(ecx_contextt*, std::uint16_t){};
+  std::atomic<bool> busy_{ false };
+  std::atomic<std::uint64_t> overlaps_{};
+  std::atomic<std::uint64_t> operations_{};
+};
+
+/// \brief a coupler, an analog output terminal and a drive
+auto make_segment(virtual_drive& drive) -> std::vector<bus::virtual_slave> {
+  return { bus::virtual_slave::of<beckhoff::ek1100>(), bus::virtual_slave::of<beckhoff::el4002>(),
+           bus::virtual_slave::of<schneider::lxm32m<manager_client_t>>(drive.respond()) };
+}
+
+/// \return whether the condition was met before the io_context ran for the timeout
+template <typename condition_t>
+auto run_until(asio::io_context& ctx, condition_t&& condition, std::chrono::milliseconds timeout) -> bool {
+  for (auto waited{ std::chrono::milliseconds{} }; waited < timeout; waited += std::chrono::milliseconds{ 10 }) {
+    if (condition()) {
+      return true;
+    }
+    ctx.run_for(std::chrono::milliseconds{ 10 });
+  }
+  return condition();
+}
+
+/// \brief start every test from the default ethercat config
+void remove_config() {
+  std::error_code code;
+  std::filesystem::remove_all(tfc::base::make_config_file_name("", ""), code);
+}
+
+/// \brief the ethercat config the next context reads, like on real hardware
+void write_config(std::string_view json) {
+  auto const file{ tfc::base::make_config_file_name("ethercat", "json") };
+  std::filesystem::create_directories(file.parent_path());
+  std::ofstream{ file } << json;
+}
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  using ut::operator""_test;
+  using ut::operator>>;
+  using ut::expect;
+  using ut::fatal;
+
+  tfc::base::init(argc, argv);
+
+  "context cycles process data through virtual slaves"_test = [] {
+    remove_config();
+    asio::io_context ctx{};
+    virtual_drive drive{};
+    tfc::ec::context_t<4096, bus::simulated> ethercat{ ctx, make_segment(drive) };
+    expect(!ethercat.async_start());
+    expect(!ethercat.realtime());
+    expect((ethercat.slave_count() == 3) >> fatal);
+    expect(ethercat.expected_working_counter() == 5);
+
+    // the drive is only enabled after the device answered the status words the drive returned
+    auto const enabled{ [&drive] { return drive.state.load() == cia_402::states_e::operation_enabled; } };
+    expect((run_until(ctx, enabled, std::chrono::seconds{ 2 })) >> fatal);
+    auto const cycles{ ethercat.period_histogram().count() };
+    ctx.run_for(std::chrono::milliseconds{ 20 });
+    expect(ethercat.period_histogram().count() > cycles);
+    expect(ethercat.working_counter() == ethercat.expected_working_counter());
+    expect(drive.control_word.load() == std::bit_cast<std::uint16_t>(cia_402::commands::enable_operation()));
+    expect(drive.velocity.load() == 100);
+    expect(ethercat.segment().frames() >= ethercat.period_histogram().count());
+  };
+
+  "a real-time context keeps cycling while a slave is brought back to OP"_test = [] {
+    remove_config();
+    write_config(R"({"realtime":{"enabled":true}})");
+    asio::io_context ctx{};
+    virtual_drive drive{};
+    tfc::ec::context_t<4096, bus::simulated> ethercat{ ctx, make_segment(drive) };
+    expect(!ethercat.async_start());
+    expect((ethercat.realtime()) >> fatal);
+    auto const enabled{ [&drive] { return drive.state.load() == cia_402::states_e::operation_enabled; } };
+    expect((run_until(ctx, enabled, std::chrono::seconds{ 2 })) >> fatal);
+
+    // the outputs of the terminal drop out of the working counter until its error is acknowledged and OP requested
+    ethercat.segment().inject_error(2);
+    auto const frames{ ethercat.segment().frames() };
+    auto const recovered{ [&ethercat] {
+      return ethercat.segment().state(2) == EC_STATE_OPERATIONAL &&
+             ethercat.working_counter() == ethercat.expected_working_counter();
+    } };
+    expect((run_until(ctx, recovered, std::chrono::seconds{ 2 })) >> fatal);
+    expect(ethercat.segment().frames() > frames);
+
+    auto const cycles{ ethercat.period_histogram().count() };
+    ctx.run_for(std::chrono::milliseconds{ 20 });
+    expect(ethercat.period_histogram().count() > cycles);
+    expect(ethercat.working_counter() == ethercat.expected_working_counter());
+    expect(enabled());
+  };
+
+  "supervisor operations never overlap a frame exchange"_test = [](bool realtime) {
+    remove_config();
+    if (realtime) {
+      write_config(R"({"realtime":{"enabled":true}})");
+    }
+    asio::io_context ctx{};
+    virtual_drive drive{};
+    tfc::ec::context_t<4096, exclusive_segment> ethercat{ ctx, make_segment(drive) };
+    expect(!ethercat.async_start());
+    expect((ethercat.realtime() == realtime) >> fatal);
+    auto& segment{ ethercat.segment() };
+    auto const recovered{ [&ethercat, &segment] {
+      return segment.state(2) == EC_STATE_OPERATIONAL && ethercat.working_counter() == ethercat.expected_working_counter();
+    } };
+    expect((run_until(ctx, recovered, std::chrono::seconds{ 2 })) >> fatal);
+
+    // acknowledge and request OP
+    segment.inject_error(2);
+    expect((run_until(ctx, [&segment] { return segment.state(2) != EC_STATE_OPERATIONAL; }, std::chrono::seconds{ 1 })));
+    expect((run_until(ctx, recovered, std::chrono::seconds{ 2 })) >> fatal);
+
+    // confirm lost, recover and reconfigure with the PO2SO hook of the terminal
+    auto const operations{ segment.operations() };
+    segment.set_lost(2, true);
+    ctx.run_for(std::chrono::milliseconds{ 100 });
+    segment.set_lost(2, false);
+    expect((run_until(ctx, recovered, std::chrono::seconds{ 2 })) >> fatal);
+    expect(segment.operations() > operations);
+
+    expect(segment.overlaps() == 0) << "bus calls overlapping:" << segment.overlaps();
+    auto const cycles{ ethercat.period_histogram().count() };
+    ctx.run_for(std::chrono::milliseconds{ 20 });
+    expect(ethercat.period_histogram().count() > cycles);
+  } | std::vector{ false, true };
+
+  remove_config();
+}
@@ -0,0 +1,91 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <boost/ut.hpp>
+#include <tfc/ec/realtime.hpp>
+
+namespace ut = boost::ut;
+namespace realtime = tfc::ec::realtime;
+
+auto main(int, char**) -> int {
+  using ut::operator""_test;
+  using ut::operator>>;
+  using ut::expect;
+  using ut::fatal;
+
+  "spsc queue hands slots over in order"_test = []() {
+    realtime::spsc_queue<int, 4> queue{};
+    expect(queue.read_slot() == nullptr);
+    for (int idx = 0; idx < 4; idx++) {
+      auto* slot{ queue.write_slot() };
+      expect((slot != nullptr) >> fatal);
+      *slot = idx;
+      queue.push();
+    }
+    expect(queue.write_slot() == nullptr) << "full queue must not hand out a slot";
+    expect(queue.size() == 4);
+    for (int idx = 0; idx < 4; idx++) {
+      auto* slot{ queue.read_slot() };
+      expect((slot != nullptr) >> fatal);
+      expect(*slot == idx);
+      queue.pop();
+    }
+    expect(queue.read_slot() == nullptr);
+  };
+
+  "spsc queue between two threads"_test = []() {
+    static constexpr std::uint64_t count{ 100'000 };
+    realtime::spsc_queue<std::array<std::uint64_t, 8>, 4> queue{};
+    std::thread producer{ [&queue] {
+      for (std::uint64_t idx = 0; idx < count;) {
+        if (auto* slot{ queue.write_slot() }; slot != nullptr) {
+          slot->fill(idx++);
+          queue.push();
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    } };
+    std::uint64_t expected{};
+    bool torn{ false };
+    while (expected < count) {
+      if (auto* slot{ queue.read_slot() }; slot != nullptr) {
+        torn |= slot->front() != expected || slot->back() != expected;
+        expected++;
+        queue.pop();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+    expect(!torn);
+  };
+
+  "cycle histogram buckets are powers of two microseconds"_test = []() {
+    using std::chrono::microseconds;
+    using std::chrono::nanoseconds;
+    realtime::cycle_histogram histogram{};
+    histogram.add(nanoseconds{ 500 });
+    histogram.add(microseconds{ 1 });
+    histogram.add(microseconds{ 1000 });
+    histogram.add(microseconds{ 1023 });
+    histogram.add(microseconds{ 1024 });
+    histogram.add(std::chrono::hours{ 1 });
+    expect(histogram.buckets()[0] == 1);
+    expect(histogram.buckets()[1] == 1);
+    expect(histogram.buckets()[10] == 2);
+    expect(histogram.buckets()[11] == 1);
+    expect(histogram.buckets().back() == 1);
+    expect(histogram.count() == 6);
+    expect(histogram.min() == nanoseconds{ 500 });
+    expect(histogram.max() == std::chrono::hours{ 1 });
+  };
+
+  "sleep until an absolute deadline"_test = []() {
+    auto const deadline{ std::chrono::steady_clock::now() + std::chrono::milliseconds{ 2 } };
+    realtime::sleep_until(deadline);
+    expect(std::chrono::steady_clock::now() >= deadline);
+  };
+}
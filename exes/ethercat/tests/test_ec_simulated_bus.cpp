@@ -0,0 +1,150 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <boost/ut.hpp>
+
+#include <tfc/ec/devices/beckhoff/EK1xxx.hpp>
+#include <tfc/ec/devices/beckhoff/EL3xxx.hpp>
+#include <tfc/ec/devices/beckhoff/EL4xxx.hpp>
+#include <tfc/ec/simulated_bus.hpp>
+
+namespace ut = boost::ut;
+namespace bus = tfc::ec::bus;
+namespace beckhoff = tfc::ec::devices::beckhoff;
+
+namespace {
+/// \brief the parts of the SOEM context the backend fills, context_t owns the same in its members
+struct soem_context {
+  soem_context() {
+    context.slavelist = slavelist.data();
+    context.maxslave = static_cast<int>(slavelist.size());
+    context.slavecount = &slave_count;
+    context.grouplist = grouplist.data();
+    context.maxgroup = static_cast<int>(grouplist.size());
+    context.elist = &elist;
+    context.ecaterror = &ecat_error;
+  }
+  ecx_contextt context{};
+  std::array<ec_slavet, 8> slavelist{};
+  int slave_count{};
+  std::array<ec_groupt, 2> grouplist{};
+  ec_eringt elist{};
+  boolean ecat_error{};
+  std::array<std::byte, 256> io{};
+};
+
+auto make_segment() -> std::vector<bus::virtual_slave> {
+  return { bus::virtual_slave::of<beckhoff::ek1100>(), bus::virtual_slave::of<beckhoff::el3054>(),
+           bus::virtual_slave::of<beckhoff::el4002>() };
+}
+
+void bring_up(bus::simulated& segment, soem_context& soem) {
+  segment.init(&soem.context, "sim0");
+  segment.config_init(&soem.context, false);
+  segment.config_overlap_map_group(&soem.context, soem.io);
+  soem.slavelist[0].state = EC_STATE_OPERATIONAL;
+  segment.write_state(&soem.context, 0);
+}
+}  // namespace
+
+auto main(int, char**) -> int {
+  using ut::operator""_test;
+  using ut::operator>>;
+  using ut::expect;
+  using ut::fatal;
+
+  "slaves identify as the devices they simulate"_test = [] {
+    soem_context soem{};
+    bus::simulated segment{ make_segment() };
+    expect(segment.init(&soem.context, "sim0"));
+    expect((segment.config_init(&soem.context, false)) >> fatal);
+    expect(soem.slave_count == 3);
+    expect(soem.slavelist[2].eep_man == beckhoff::el3054::vendor_id);
+    expect(soem.slavelist[2].eep_id == beckhoff::el3054::product_code);
+    expect(soem.slavelist[2].Ibytes == sizeof(std::array<beckhoff::temporary, 4>));
+    expect(soem.slavelist[3].Obytes == sizeof(beckhoff::el4002::output_pdo));
+    expect(soem.slavelist[1].Ibytes == 0 && soem.slavelist[1].Obytes == 0);
+  };
+
+  "process image is mapped outputs first"_test = [] {
+    soem_context soem{};
+    bus::simulated segment{ make_segment() };
+    bring_up(segment, soem);
+    auto* const base{ reinterpret_cast<std::uint8_t*>(soem.io.data()) };
+    auto const& group{ soem.grouplist[0] };
+    expect(group.outputs == base);
+    expect(group.Obytes == soem.slavelist[3].Obytes);
+    expect(group.inputs == base + group.Obytes);
+    expect(soem.slavelist[3].outputs == base);
+    expect(soem.slavelist[2].inputs == group.inputs);
+    expect(soem.slavelist[1].inputs == nullptr && soem.slavelist[1].outputs == nullptr);
+    expect(group.outputsWKC == 1 && group.inputsWKC == 1);
+  };
+
+  "frames are answered by the scripted slaves"_test = [] {
+    soem_context soem{};
+    auto slaves{ make_segment() };
+    slaves[1].respond = [](std::span<std::uint8_t const>, std::span<std::uint8_t> inputs) { inputs[0]++; };
+    bus::simulated segment{ std::move(slaves) };
+    bring_up(segment, soem);
+    expect(segment.receive_processdata(&soem.context, {}) == EC_NOFRAME) << "nothing was sent";
+    segment.send_processdata(&soem.context);
+    expect(segment.receive_processdata(&soem.context, {}) == 3);
+    segment.send_processdata(&soem.context);
+    expect(segment.receive_processdata(&soem.context, {}) == 3);
+    expect(soem.slavelist[2].inputs[0] == 2);
+    expect(segment.frames() == 2);
+  };
+
+  "lost slaves drop out of the working counter"_test = [] {
+    soem_context soem{};
+    bus::simulated segment{ make_segment() };
+    bring_up(segment, soem);
+    segment.set_lost(3, true);
+    segment.send_processdata(&soem.context);
+    expect(segment.receive_processdata(&soem.context, {}) == 1);
+    expect(segment.read_state(&soem.context) == EC_STATE_NONE);
+    expect(segment.recover_slave(&soem.context, 3, {}) == 0);
+
+    segment.set_lost(3, false);
+    expect(segment.recover_slave(&soem.context, 3, {}) == 1);
+    expect(segment.reconfig_slave(&soem.context, 3, {}) == EC_STATE_SAFE_OP);
+    soem.slavelist[3].state = EC_STATE_OPERATIONAL;
+    segment.write_state(&soem.context, 3);
+    expect(segment.read_state(&soem.context) == EC_STATE_OPERATIONAL);
+  };
+
+  "errors are only left when acknowledged"_test = [] {
+    soem_context soem{};
+    bus::simulated segment{ make_segment() };
+    bring_up(segment, soem);
+    segment.inject_error(2);
+    soem.slavelist[2].state = EC_STATE_OPERATIONAL;
+    segment.write_state(&soem.context, 2);
+    expect(segment.state(2) == (EC_STATE_SAFE_OP | EC_STATE_ERROR));
+    soem.slavelist[2].state = EC_STATE_SAFE_OP | EC_STATE_ACK;
+    segment.write_state(&soem.context, 2);
+    expect(segment.state(2) == EC_STATE_SAFE_OP);
+  };
+
+  "the pre op to safe op hook can write sdos"_test = [] {
+    soem_context soem{};
+    bus::simulated segment{ make_segment() };
+    static bus::simulated* hooked{ nullptr };
+    hooked = &segment;
+    segment.init(&soem.context, "sim0");
+    segment.config_init(&soem.context, false);
+    soem.slavelist[3].PO2SOconfigx = [](ecx_contextt* context, std::uint16_t slave) -> int {
+      std::array<std::byte, 2> value{ std::byte{ 1 }, std::byte{ 2 } };
+      return hooked->sdo_write(context, slave, { 0x8000, 1 }, false, value, {});
+    };
+    segment.config_overlap_map_group(&soem.context, soem.io);
+    auto const writes{ segment.sdo_writes(3) };
+    expect((writes.size() == 1) >> fatal);
+    expect(writes[0].first == ecx::index_t{ 0x8000, 1 });
+    expect(writes[0].second.size() == 2);
+  };
+}
@@ -0,0 +1,180 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <boost/ut.hpp>
+
+#include <tfc/ec/devices/beckhoff/EK1xxx.hpp>
+#include <tfc/ec/devices/beckhoff/EL3xxx.hpp>
+#include <tfc/ec/devices/beckhoff/EL4xxx.hpp>
+#include <tfc/ec/simulated_bus.hpp>
+#include <tfc/ec/supervisor.hpp>
+
+namespace ut = boost::ut;
+namespace bus = tfc::ec::bus;
+namespace beckhoff = tfc::ec::devices::beckhoff;
+using tfc::ec::slave_phase_e;
+
+namespace {
+/// \brief a simulated segment of a coupler, an analog input and an analog output brought up to OP
+struct segment {
+  segment() {
+    context.slavelist = slavelist.data();
+    context.maxslave = static_cast<int>(slavelist.size());
+    context.slavecount = &slave_count;
+    context.grouplist = grouplist.data();
+    context.maxgroup = static_cast<int>(grouplist.size());
+    context.elist = &elist;
+    context.ecaterror = &ecat_error;
+    bus.init(&context, "sim0");
+    bus.config_init(&context, false);
+    bus.config_overlap_map_group(&context, io);
+    slavelist[0].state = EC_STATE_OPERATIONAL;
+    bus.write_state(&context, 0);
+    expected = grouplist[0].outputsWKC * 2 + grouplist[0].inputsWKC;
+    supervisor.reset(static_cast<std::size_t>(slave_count));
+  }
+
+  /// \brief one process data cycle followed by the supervisor, the operation it started last cycle runs and completes
+  /// first unless held, like it would on its own thread next to the cycle
+  void cycle() {
+    if (completion && !hold) {
+      operation();
+      auto const done{ std::exchange(completion, nullptr) };
+      done();
+    }
+    bus.send_processdata(&context);
+    auto const wkc{ bus.receive_processdata(&context, {}) };
+    auto const before{ operations };
+    supervisor.on_cycle(wkc, expected, [this](auto&& next, auto&& next_completion) {
+      operations++;
+      overlapped += completion ? 1 : 0;
+      operation = next;
+      completion = next_completion;
+    });
+    started = operations - before;
+  }
+
+  /// \return whether the segment reached full working counter within the given cycles
+  auto cycle_until_operational(std::size_t cycles) -> bool {
+    for (std::size_t idx = 0; idx < cycles; idx++) {
+      cycle();
+      if (!supervisor.degraded() && bus.read_state(&context) == EC_STATE_OPERATIONAL) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  ecx_contextt context{};
+  std::array<ec_slavet, 8> slavelist{};
+  int slave_count{};
+  std::array<ec_groupt, 2> grouplist{};
+  ec_eringt elist{};
+  boolean ecat_error{};
+  std::array<std::byte, 256> io{};
+  bus::simulated bus{ { bus::virtual_slave::of<beckhoff::ek1100>(), bus::virtual_slave::of<beckhoff::el3054>(),
+                        bus::virtual_slave::of<beckhoff::el4002>() } };
+  tfc::ec::supervisor<bus::simulated> supervisor{ bus, &context, std::chrono::nanoseconds::zero() };
+  ecx::working_counter_t expected{};
+  std::function<void()> operation{};
+  std::function<void()> completion{};
+  bool hold{ false };
+  std::size_t operations{};
+  // operations started by the last cycle and while another one was in flight
+  std::size_t started{};
+  std::size_t overlapped{};
+};
+}  // namespace
+
+auto main(int, char**) -> int {
+  using ut::operator""_test;
+  using ut::operator>>;
+  using ut::expect;
+  using ut::fatal;
+
+  "a healthy segment is left alone"_test = [] {
+    segment seg{};
+    for (std::size_t idx = 0; idx < 10; idx++) {
+      seg.cycle();
+    }
+    expect(seg.operations == 0);
+    expect(seg.supervisor.slaves()[1].phase == slave_phase_e::operational);
+  };
+
+  "at most one operation runs per cycle"_test = [] {
+    segment seg{};
+    seg.bus.inject_error(2);
+    seg.bus.inject_error(3);
+    // both are found by the state read the output terminal triggers, then acknowledged and requested OP one by one
+    for (std::size_t idx = 0; idx < 20; idx++) {
+      seg.cycle();
+      expect(seg.started == 0 || seg.started == 1) << "cycle" << idx;
+    }
+    expect(seg.overlapped == 0);
+    expect(seg.operations >= 5);
+    expect(seg.bus.state(2) == EC_STATE_OPERATIONAL);
+    expect(seg.bus.state(3) == EC_STATE_OPERATIONAL);
+  };
+
+  "process data keeps flowing while an operation is in flight"_test = [] {
+    segment seg{};
+    seg.bus.inject_error(3);
+    seg.hold = true;
+    seg.cycle();
+    expect((seg.operations == 1) >> fatal);
+    auto const frames{ seg.bus.frames() };
+    for (std::size_t idx = 0; idx < 10; idx++) {
+      seg.cycle();
+    }
+    expect(seg.bus.frames() == frames + 10);
+    expect(seg.operations == 1);
+    seg.hold = false;
+    expect((seg.cycle_until_operational(20)) >> fatal);
+    expect(seg.overlapped == 0);
+  };
+
+  "an error is acknowledged and the slave brought back to OP"_test = [] {
+    segment seg{};
+    // the output terminal, its outputs drop out of the working counter outside OP
+    seg.bus.inject_error(3);
+    // the first cycle reads the states, the second acts on them
+    seg.cycle();
+    seg.cycle();
+    expect(seg.supervisor.slaves()[2].phase == slave_phase_e::acknowledging);
+    expect((seg.cycle_until_operational(20)) >> fatal);
+    expect(seg.bus.state(3) == EC_STATE_OPERATIONAL);
+    auto const& recovery{ seg.supervisor.slaves()[2] };
+    expect(recovery.phase == slave_phase_e::operational);
+    expect(recovery.recoveries == 1);
+    expect(recovery.last > std::chrono::nanoseconds::zero());
+    expect(recovery.max == recovery.last);
+    expect(seg.supervisor.slaves()[1].recoveries == 0);
+  };
+
+  "a lost slave is recovered once it is back"_test = [] {
+    segment seg{};
+    seg.bus.set_lost(3, true);
+    for (std::size_t idx = 0; idx < 10; idx++) {
+      seg.cycle();
+    }
+    expect(seg.slavelist[3].islost == TRUE);
+    expect(seg.supervisor.slaves()[2].phase == slave_phase_e::lost ||
+           seg.supervisor.slaves()[2].phase == slave_phase_e::recovering);
+    expect(seg.supervisor.degraded());
+
+    seg.bus.set_lost(3, false);
+    expect((seg.cycle_until_operational(20)) >> fatal);
+    expect(seg.slavelist[3].islost == FALSE);
+    expect(seg.supervisor.slaves()[2].recoveries == 1);
+  };
+
+  "phases format by name"_test = [] {
+    expect(format_as(slave_phase_e::requesting_op) == "requesting_op");
+    expect(format_as(slave_phase_e::lost) == "lost");
+  };
+}
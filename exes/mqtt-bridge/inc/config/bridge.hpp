@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -17,6 +19,7 @@
 #include <vector>
 
 #include <glaze/core/common.hpp>
+#include <tfc/stx/glaze_meta.hpp>
 #include <tfc/utils/json_schema.hpp>
 
 #include <signal_names.hpp>
@@ -85,6 +88,46 @@ struct glz::detail::to_json_schema<tfc::mqtt::config::signal_name> {
 };
 
 namespace tfc::mqtt::config {
+/// \brief coalescing of changed values into multi metric NDATA payloads
+struct ndata_batch {
+  std::chrono::milliseconds flush_window{ 50 };
+  std::size_t max_metrics{ 500 };
+  std::size_t max_bytes{ 64 * 1024 };
+  bool keep_history{ false };
+  bool aliases{ true };
+
+  struct glaze {
+    static constexpr auto value{ glz::object(
+        // clang-format off
+        "flush_window", &ndata_batch::flush_window, "Time to collect changed values before sending them in one NDATA payload, 0 sends every change on its own",
+        "max_metrics", &ndata_batch::max_metrics, "Send the payload early when it holds this many metrics",
+        "max_bytes", &ndata_batch::max_bytes, "Send the payload early when it grows beyond this many bytes",
+        "keep_history", &ndata_batch::keep_history, "Send every change within the window instead of only the latest value of each metric",
+        "aliases", &ndata_batch::aliases, "Assign every metric a numeric alias in the birth certificate and send only the alias in NDATA instead of the metric name"
+        // clang-format on
+        ) };
+    static constexpr std::string_view name{ "tfc::mqtt::ndata_batch" };
+  };
+};
+
+/// \brief disk backed buffering of NDATA payloads while the broker is unreachable
+struct store_and_forward {
+  bool enabled{ true };
+  std::size_t max_bytes{ 64 * 1024 * 1024 };
+  std::chrono::seconds max_age{ std::chrono::hours{ 24 } };
+
+  struct glaze {
+    static constexpr auto value{ glz::object(
+        // clang-format off
+        "enabled", &store_and_forward::enabled, "Buffer NDATA payloads on disk while the broker is unreachable and send them as historical values once reconnected",
+        "max_bytes", &store_and_forward::max_bytes, "Drop the oldest buffered payloads beyond this many bytes",
+        "max_age", &store_and_forward::max_age, "Drop buffered payloads older than this"
+        // clang-format on
+        ) };
+    static constexpr std::string_view name{ "tfc::mqtt::store_and_forward" };
+  };
+};
+
 struct bridge {
   std::vector<signal_name> publish_signals{};
   std::string node_id{ "tfc_unconfigured_node_id" };
@@ -96,20 +139,24 @@ struct bridge {
   std::string password{};
   std::string client_id{ "tfc_unconfigured_client_id" };
   std::vector<signal_definition> writeable_signals{};
+  ndata_batch ndata{};
+  store_and_forward offline{};
 
   struct glaze {
     static constexpr auto value{ glz::object(
         // clang-format off
        "node_id", &bridge::node_id, json::schema{ .description = "Spark Plug B Node ID, used to identify which node is sending information", .pattern = "[^+#/]" },
         "group_id", &bridge::group_id, json::schema{ .description = "Spark Plug B Group ID, used to identify which group the node belongs to", .pattern = "[^+#/]" },
-        "publish_signals", &bridge::publish_signals, "Signals to publish",
+        "publish_signals", &bridge::publish_signals, "Signals to publish, exact names or patterns where * matches any run of characters and ? a single character",
         "address", &bridge::address, "Hostname or IP address of the MQTT broker",
         "port", &bridge::port, "Port of the MQTT broker. Possible values are: mqtt, mqtts or a custom port number",
         "ssl_active", &bridge::ssl_active, "Whether or not to use SSL to connect to the MQTT broker",
         "username", &bridge::username, "Username for the MQTT broker",
         "password", &bridge::password, "Password for the MQTT broker",
         "client_id", &bridge::client_id, "Client ID, used to identify which client is sending information",
-        "writeable_signals", &bridge::writeable_signals, "Array of signals that an MQTT client with a Spark Plug B extension can write to"
+        "writeable_signals", &bridge::writeable_signals, "Array of signals that an MQTT client with a Spark Plug B extension can write to",
+        "ndata", &bridge::ndata, "Batching of changed values into NDATA payloads",
+        "offline", &bridge::offline, "Buffering of NDATA payloads during broker outages"
 
         ) };
     // clang-format on
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+namespace tfc::mqtt {
+
+namespace detail {
+
+/// \brief where a record is stored, segment sequence number and byte offset within it
+struct record_position {
+  std::uint64_t segment{};
+  std::size_t offset{};
+  constexpr auto operator==(record_position const&) const noexcept -> bool = default;
+};
+
+/**@brief
+ * One memory mapped file of the offline buffer, records are appended back to back.
+ * Record layout: u32 payload size, i64 milliseconds since epoch, payload. The file is zero filled on creation so a
+ * size of zero marks the end of the written records, the size is stored last so a torn write reads as the end.
+ * A forwarded record is marked by setting the top bit of its size, so a restart resumes after the last one.
+ * */
+class segment {
+public:
+  static constexpr std::size_t header_size{ sizeof(std::uint32_t) + sizeof(std::int64_t) };
+  static constexpr std::uint32_t consumed_flag{ std::uint32_t{ 1 } << 31 };
+  static constexpr std::size_t max_payload_size{ consumed_flag - 1 };
+
+  struct record {
+    std::chrono::system_clock::time_point timestamp;
+    std::string_view payload;
+    record_position position;
+  };
+
+  [[nodiscard]] static auto create(std::filesystem::path path, std::uint64_t sequence, std::size_t capacity)
+      -> std::expected<segment, std::error_code> {
+    int const file_descriptor{ ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR) };
+    if (file_descriptor == -1) {
+      return std::unexpected(std::error_code{ errno, std::system_category() });
+    }
+    if (ftruncate(file_descriptor, static_cast<off_t>(capacity)) == -1) {
+      std::error_code const err{ errno, std::system_category() };
+      close(file_descriptor);
+      std::filesystem::remove(path);
+      return std::unexpected(err);
+    }
+    return map(std::move(path), sequence, file_descriptor, capacity);
+  }
+
+  /// \brief map a segment left by a previous run and find the end of its records
+  [[nodiscard]] static auto recover(std::filesystem::path path, std::uint64_t sequence)
+      -> std::expected<segment, std::error_code> {
+    int const file_descriptor{ ::open(path.c_str(), O_RDWR | O_CLOEXEC) };
+    if (file_descriptor == -1) {
+      return std::unexpected(std::error_code{ errno, std::system_category() });
+    }
+    struct stat info {};
+    if (fstat(file_descriptor, &info) == -1) {
+      std::error_code const err{ errno, std::system_category() };
+      close(file_descriptor);
+      return std::unexpected(err);
+    }
+    auto result{ map(std::move(path), sequence, file_descriptor, static_cast<std::size_t>(info.st_size)) };
+    if (result) {
+      while (auto const next{ result->at(result->write_offset_) }) {
+        // records are consumed in order, those forwarded before the restart lead the segment
+        if (result->read_offset_ == result->write_offset_ && result->consumed(result->read_offset_)) {
+          result->read_offset_ += header_size + next->payload.size();
+        }
+        result->write_offset_ += header_size + next->payload.size();
+        result->newest_ = std::max(result->newest_, next->timestamp);
+      }
+    }
+    return result;
+  }
+
+  segment(segment const&) = delete;
+  auto operator=(segment const&) -> segment& = delete;
+  segment(segment&& other) noexcept
+      : path_{ std::move(other.path_) }, sequence_{ other.sequence_ }, fd_{ std::exchange(other.fd_, -1) },
+        addr_{ std::exchange(other.addr_, nullptr) }, capacity_{ std::exchange(other.capacity_, 0) },
+        read_offset_{ other.read_offset_ },
+        write_offset_{ other.write_offset_ }, newest_{ other.newest_ } {}
+  auto operator=(segment&& other) noexcept -> segment& {
+    if (this != &other) {
+      reset();
+      path_ = std::move(other.path_);
+      sequence_ = other.sequence_;
+      fd_ = std::exchange(other.fd_, -1);
+      addr_ = std::exchange(other.addr_, nullptr);
+      capacity_ = std::exchange(other.capacity_, 0);
+      read_offset_ = other.read_offset_;
+      write_offset_ = other.write_offset_;
+      newest_ = other.newest_;
+    }
+    return *this;
+  }
+  ~segment() { reset(); }
+
+  [[nodiscard]] auto fits(std::size_t payload_size) const noexcept -> bool {
+    return capacity_ - write_offset_ >= header_size + payload_size;
+  }
+
+  void append(std::string_view payload, std::chrono::system_clock::time_point timestamp) noexcept {
+    auto* position{ addr_ + write_offset_ };
+    auto const size{ static_cast<std::uint32_t>(payload.size()) };
+    auto const milliseconds{
+      std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count()
+    };
+    std::memcpy(position + sizeof(size), &milliseconds, sizeof(milliseconds));
+    std::memcpy(position + header_size, payload.data(), payload.size());
+    std::memcpy(position, &size, sizeof(size));
+    write_offset_ += header_size + payload.size();
+    newest_ = std::max(newest_, timestamp);
+  }
+
+  /// \return the oldest record not yet consumed
+  [[nodiscard]] auto front() const noexcept -> std::optional<record> { return at(read_offset_); }
+  void pop_front() noexcept {
+    if (auto const current{ front() }) {
+      auto const size{ static_cast<std::uint32_t>(current->payload.size()) | consumed_flag };
+      std::memcpy(addr_ + read_offset_, &size, sizeof(size));
+      read_offset_ += header_size + current->payload.size();
+    }
+  }
+
+  [[nodiscard]] auto drained() const noexcept -> bool { return read_offset_ >= write_offset_; }
+  /// \return bytes of records not yet consumed
+  [[nodiscard]] auto unread_bytes() const noexcept -> std::size_t { return write_offset_ - read_offset_; }
+  [[nodiscard]] auto newest() const noexcept -> std::chrono::system_clock::time_point { return newest_; }
+
+  /// \brief unmap and delete the file
+  void remove() noexcept {
+    reset();
+    std::error_code ignore{};
+    std::filesystem::remove(path_, ignore);
+  }
+
+private:
+  segment(std::filesystem::path path, std::uint64_t sequence, int file_descriptor, std::byte* addr, std::size_t capacity)
+      : path_{ std::move(path) }, sequence_{ sequence }, fd_{ file_descriptor }, addr_{ addr }, capacity_{ capacity } {}
+
+  [[nodiscard]] static auto map(std::filesystem::path path,
+                                std::uint64_t sequence,
+                                int file_descriptor,
+                                std::size_t capacity) -> std::expected<segment, std::error_code> {
+    void* addr{ mmap(nullptr, std::max<std::size_t>(capacity, 1), PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0) };
+    if (addr == MAP_FAILED) {
+      std::error_code const err{ errno, std::system_category() };
+      close(file_descriptor);
+      return std::unexpected(err);
+    }
+    return segment{ std::move(path), sequence, file_descriptor, static_cast<std::byte*>(addr), capacity };
+  }
+
+  [[nodiscard]] auto at(std::size_t offset) const noexcept -> std::optional<record> {
+    if (capacity_ < header_size || offset > capacity_ - header_size) {
+      return std::nullopt;
+    }
+    std::uint32_t size{};
+    std::int64_t milliseconds{};
+    std::memcpy(&size, addr_ + offset, sizeof(size));
+    std::memcpy(&milliseconds, addr_ + offset + sizeof(size), sizeof(milliseconds));
+    size &= ~consumed_flag;
+    if (size == 0 || size > capacity_ - offset - header_size) {
+      return std::nullopt;
+    }
+    return record{ .timestamp = std::chrono::system_clock::time_point{ std::chrono::milliseconds{ milliseconds } },
+                   .payload = { reinterpret_cast<char const*>(addr_ + offset + header_size), size },
+                   .position = { .segment = sequence_, .offset = offset } };
+  }
+
+  [[nodiscard]] auto consumed(std::size_t offset) const noexcept -> bool {
+    std::uint32_t size{};
+    std::memcpy(&size, addr_ + offset, sizeof(size));
+    return (size & consumed_flag) != 0;
+  }
+
+  void reset() noexcept {
+    if (addr_ != nullptr) {
+      munmap(addr_, std::max<std::size_t>(capacity_, 1));
+      addr_ = nullptr;
+    }
+    if (fd_ != -1) {
+      close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  std::filesystem::path path_{};
+  std::uint64_t sequence_{};
+  int fd_{ -1 };
+  std::byte* addr_{ nullptr };
+  std::size_t capacity_{};
+  std::size_t read_offset_{};
+  std::size_t write_offset_{};
+  std::chrono::system_clock::time_point newest_{};
+};
+
+}  // namespace detail
+
+/**@brief
+ * Bounded store and forward log of NDATA payloads, kept while the broker is unreachable.
+ * Payloads are appended to memory mapped segment files in `directory`, named by an increasing sequence number.
+ * A segment file is deleted once every record in it has been forwarded, or as a whole when the log grows beyond
+ * `max_bytes` or its newest record is older than `max_age`. Segments left by a previous run are recovered on
+ * construction, so buffered values survive a restart of the bridge. Records consumed by pop are marked in the file,
+ * they are not forwarded again after a restart.
+ * */
+class offline_buffer {
+public:
+  using clock = std::chrono::system_clock;
+  using record = detail::segment::record;
+  using position = detail::record_position;
+
+  struct limits {
+    std::size_t max_bytes{};
+    std::chrono::seconds max_age{};
+  };
+
+  offline_buffer(std::filesystem::path directory, limits limit) : directory_{ std::move(directory) }, limits_{ limit } {
+    std::error_code err{};
+    std::filesystem::create_directories(directory_, err);
+    std::vector<std::pair<std::uint64_t, std::filesystem::path>> found{};
+    for (auto const& entry : std::filesystem::directory_iterator{ directory_, err }) {
+      if (entry.path().extension() != extension) {
+        continue;
+      }
+      try {
+        found.emplace_back(std::stoull(entry.path().stem().string()), entry.path());
+      } catch (std::exception const&) {  // not one of ours
+      }
+    }
+    std::ranges::sort(found);
+    for (auto& [sequence, path] : found) {
+      next_sequence_ = sequence + 1;
+      auto recovered{ detail::segment::recover(path, sequence) };
+      if (!recovered || recovered->drained()) {
+        std::filesystem::remove(path, err);
+        continue;
+      }
+      bytes_ += recovered->unread_bytes();
+      segments_.emplace_back(std::move(recovered.value()));
+    }
+    enforce_limits(clock::now());
+  }
+
+  /// \brief append payload, dropping the oldest segments when the byte limit is exceeded
+  auto push(std::string_view payload, clock::time_point timestamp = clock::now()) -> std::error_code {
+    if (payload.empty()) {
+      return {};
+    }
+    if (payload.size() > detail::segment::max_payload_size) {
+      return std::make_error_code(std::errc::message_size);
+    }
+    if (segments_.empty() || !segments_.back().fits(payload.size())) {
+      auto const sequence{ next_sequence_++ };
+      auto const path{ directory_ / fmt::format("{:020}{}", sequence, extension) };
+      auto const capacity{ std::max(segment_capacity(), detail::segment::header_size + payload.size()) };
+      auto created{ detail::segment::create(path, sequence, capacity) };
+      if (!created) {
+        return created.error();
+      }
+      segments_.emplace_back(std::move(created.value()));
+    }
+    segments_.back().append(payload, timestamp);
+    bytes_ += detail::segment::header_size + payload.size();
+    enforce_limits(clock::now());
+    return {};
+  }
+
+  /// \return the oldest buffered record, valid until the next call to pop or push
+  [[nodiscard]] auto front() -> std::optional<record> {
+    enforce_limits(clock::now());
+    while (!segments_.empty()) {
+      if (auto current{ segments_.front().front() }) {
+        return current;
+      }
+      segments_.front().remove();
+      segments_.pop_front();
+    }
+    return std::nullopt;
+  }
+
+  /// \brief consume the record at the given position if it is still the oldest
+  /// The limits may have dropped it while it was being forwarded, then the new oldest record is kept.
+  void pop(position const& at) {
+    if (segments_.empty()) {
+      return;
+    }
+    if (auto const current{ segments_.front().front() }; current && current->position == at) {
+      pop();
+    }
+  }
+
+  /// \brief consume the record returned by front, once it has been forwarded
+  void pop() {
+    if (segments_.empty()) {
+      return;
+    }
+    auto& oldest{ segments_.front() };
+    auto const before{ oldest.unread_bytes() };
+    oldest.pop_front();
+    bytes_ -= before - oldest.unread_bytes();
+    if (oldest.drained()) {
+      oldest.remove();
+      segments_.pop_front();
+    }
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return bytes_ == 0; }
+  /// \return bytes of buffered records including their headers
+  [[nodiscard]] auto size_bytes() const noexcept -> std::size_t { return bytes_; }
+  /// \return number of segment files currently on disk
+  [[nodiscard]] auto segments() const noexcept -> std::size_t { return segments_.size(); }
+  /// \return bytes of records discarded because of the limits
+  [[nodiscard]] auto dropped_bytes() const noexcept -> std::size_t { return dropped_bytes_; }
+
+  void set_limits(limits limit) noexcept { limits_ = limit; }
+
+private:
+  static constexpr std::string_view extension{ ".seg" };
+
+  /// \brief a handful of segments per limit so dropping the oldest one discards a small part of the log
+  [[nodiscard]] auto segment_capacity() const noexcept -> std::size_t {
+    static constexpr std::size_t min_capacity{ 4 * 1024 };
+    static constexpr std::size_t max_capacity{ 1024 * 1024 };
+    return std::clamp(limits_.max_bytes / 8, min_capacity, max_capacity);
+  }
+
+  void enforce_limits(clock::time_point now) {
+    while (!segments_.empty() && (bytes_ > limits_.max_bytes || now - segments_.front().newest() > limits_.max_age)) {
+      auto& oldest{ segments_.front() };
+      bytes_ -= oldest.unread_bytes();
+      dropped_bytes_ += oldest.unread_bytes();
+      oldest.remove();
+      segments_.pop_front();
+    }
+  }
+
+  std::filesystem::path directory_;
+  limits limits_;
+  std::deque<detail::segment> segments_{};
+  std::uint64_t next_sequence_{};
+  std::size_t bytes_{};
+  std::size_t dropped_bytes_{};
+};
+
+}  // namespace tfc::mqtt
@@ -66,8 +66,9 @@ public:
             asio::use_awaitable);
       }
 
+      // the signals stay connected while reconnecting, changes during the outage are buffered by the spark plug
+      // interface and replayed after the next birth certificate
       cancel_signal.emit(asio::cancellation_type::all);
-      tfc_to_exter_.clear_signals();
     }
     co_return;
   }
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace tfc::mqtt {
+
+namespace detail {
+/// \brief transparent hash, lets the pattern sets be queried with a string_view without allocating
+struct string_hash {
+  using is_transparent = void;
+  auto operator()(std::string_view str) const noexcept -> std::size_t { return std::hash<std::string_view>{}(str); }
+};
+}  // namespace detail
+
+/**@brief
+ * Matches signal names against the configured publish patterns.
+ * A pattern without wildcards is an exact name and a pattern whose only wildcard is a trailing `*` matches every name
+ * starting with the rest of it, both are looked up in hash sets. Any other pattern is a glob where `*` matches any run
+ * of characters and `?` a single character, globs are the only patterns tested one by one.
+ * */
+class signal_matcher {
+public:
+  signal_matcher() = default;
+
+  template <typename range_t>
+  explicit signal_matcher(range_t const& patterns) {
+    for (auto const& pattern : patterns) {
+      add(pattern);
+    }
+  }
+
+  void add(std::string_view pattern) {
+    auto const wildcard{ pattern.find_first_of("*?") };
+    if (wildcard == std::string_view::npos) {
+      exact_.emplace(pattern);
+    } else if (wildcard == pattern.size() - 1 && pattern.back() == '*') {
+      auto const prefix{ pattern.substr(0, wildcard) };
+      prefixes_.emplace(prefix);
+      if (auto const iter{ std::ranges::lower_bound(prefix_lengths_, prefix.size()) };
+          iter == prefix_lengths_.end() || *iter != prefix.size()) {
+        prefix_lengths_.insert(iter, prefix.size());
+      }
+    } else {
+      globs_.emplace_back(pattern);
+    }
+  }
+
+  [[nodiscard]] auto matches(std::string_view name) const -> bool {
+    if (exact_.contains(name)) {
+      return true;
+    }
+    for (auto const length : prefix_lengths_) {
+      if (length > name.size()) {
+        break;
+      }
+      if (prefixes_.contains(name.substr(0, length))) {
+        return true;
+      }
+    }
+    return std::ranges::any_of(globs_, [name](auto const& glob) { return glob_match(glob, name); });
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return exact_.empty() && prefixes_.empty() && globs_.empty(); }
+
+  /// \return true if name matches the glob pattern, backtracks to the last `*` only so it is linear in practice
+  [[nodiscard]] static auto glob_match(std::string_view pattern, std::string_view name) noexcept -> bool {
+    std::size_t pattern_idx{};
+    std::size_t name_idx{};
+    std::size_t star{ std::string_view::npos };
+    std::size_t star_match{};
+    while (name_idx < name.size()) {
+      if (pattern_idx < pattern.size() && (pattern[pattern_idx] == '?' || pattern[pattern_idx] == name[name_idx])) {
+        pattern_idx++;
+        name_idx++;
+      } else if (pattern_idx < pattern.size() && pattern[pattern_idx] == '*') {
+        star = pattern_idx++;
+        star_match = name_idx;
+      } else if (star != std::string_view::npos) {
+        pattern_idx = star + 1;
+        name_idx = ++star_match;
+      } else {
+        return false;
+      }
+    }
+    while (pattern_idx < pattern.size() && pattern[pattern_idx] == '*') {
+      pattern_idx++;
+    }
+    return pattern_idx == pattern.size();
+  }
+
+private:
+  std::unordered_set<std::string, detail::string_hash, std::equal_to<>> exact_{};
+  std::unordered_set<std::string, detail::string_hash, std::equal_to<>> prefixes_{};
+  std::vector<std::size_t> prefix_lengths_{};  // distinct lengths of the prefixes, ascending
+  std::vector<std::string> globs_{};
+};
+
+}  // namespace tfc::mqtt
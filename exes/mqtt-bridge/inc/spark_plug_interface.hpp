@@ -1,13 +1,16 @@
 #pragma once
 
-#include <any>
 #include <chrono>
+#include <concepts>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -16,8 +19,10 @@
 #include <boost/asio.hpp>
 
 #include <tfc/logger.hpp>
+#include <tfc/progbase.hpp>
 
 #include <constants.hpp>
+#include <offline_buffer.hpp>
 #include <structs.hpp>
 
 namespace tfc::mqtt {
@@ -29,6 +34,14 @@ using org::eclipse::tahu::protobuf::DataType;
 using org::eclipse::tahu::protobuf::Payload;
 using org::eclipse::tahu::protobuf::Payload_Metric;
 
+/// \brief log argument printing a payload with DebugString, only built when the message is emitted
+struct debug_string {
+  Payload const& payload;
+};
+inline auto format_as(debug_string const& value) -> std::string {
+  return value.payload.DebugString();
+}
+
 template <class config_t, class mqtt_client_t>
 class spark_plug_interface {
 public:
@@ -73,10 +86,22 @@ public:
     return duration_cast<milliseconds>(system_clock::now().time_since_epoch());
   }
 
-  auto set_current_values(std::vector<structs::spark_plug_b_variable> const& metrics) -> void { variables_ = metrics; }
+  auto set_current_values(std::vector<structs::spark_plug_b_variable> const& metrics) -> void {
+    variables_ = metrics;
+    for (auto const& variable : variables_) {
+      make_prototype(slot_for(variable), variable);
+    }
+  }
 
   auto send_current_values() -> void {
     if (mqtt_client_) {
+      // the birth certificate carries the current value of every metric and restarts the sequence numbers
+      pending_.Clear();
+      batch_++;
+      pending_bytes_ = 0;
+      pending_saved_bytes_ = 0;
+      bool const aliases{ config_.value().ndata.aliases };
+
       Payload payload;
       payload.set_timestamp(timestamp_milliseconds().count());
       seq_ = 0;
@@ -99,82 +124,280 @@ public:
       bd_seq_metric->set_long_value(0);
 
       for (auto const& variable : variables_) {
+        auto& slot{ slot_for(variable) };
+        // the NDATA payloads following this birth use the prototypes matching it
+        make_prototype(slot, variable);
+
         auto* variable_metric = payload.add_metrics();
 
         auto* metadata = variable_metric->mutable_metadata();
         metadata->set_description(variable.description);
 
         variable_metric->set_name(variable.name);
+        if (aliases) {
+          variable_metric->set_alias(slot.alias);
+        }
         variable_metric->set_datatype(variable.datatype);
         variable_metric->set_timestamp(timestamp_milliseconds().count());
-        set_value_payload(variable_metric, variable.value, logger_);
+        set_value_payload(variable_metric, variable.value);
 
         variable_metric->set_is_transient(false);
         variable_metric->set_is_historical(false);
       }
 
-      logger_.trace("NBIRTH payload: \n {}", payload.DebugString());
+      logger_.trace("NBIRTH payload: \n {}", debug_string{ payload });
 
       std::string payload_string;
       payload.SerializeToString(&payload_string);
 
+      logger_.debug("Sending NBIRTH of {} metrics, NDATA sent so far: {} payloads, {} bytes, {} bytes saved by aliases",
+                    variables_.size(), stats_.payloads, stats_.bytes, stats_.saved_bytes);
+
       const std::string topic = topic_formatter(
           { constants::namespace_element, config_.value().group_id, constants::nbirth, config_.value().node_id });
 
       mqtt_client_->set_initial_message(topic, payload_string, async_mqtt::qos::at_most_once);
 
-      asio::co_spawn(mqtt_client_->get_executor(),
-                     mqtt_client_->send_message(topic, payload_string, async_mqtt::qos::at_most_once), asio::detached);
+      asio::co_spawn(mqtt_client_->get_executor(), send_birth_and_replay(topic, payload_string), asio::detached);
     }
   }
 
   auto make_payload() -> Payload {
     Payload payload;
     payload.set_timestamp(timestamp_milliseconds().count());
+    payload.set_seq(next_seq());
+    return payload;
+  }
+
+  auto next_seq() -> uint64_t {
     if (seq_ == 255) {
       seq_ = 0;
     } else {
       seq_++;
     }
-    payload.set_seq(seq_);
-    return payload;
+    return seq_;
   }
 
-  auto update_value(structs::spark_plug_b_variable& variable) -> void {
-    asio::co_spawn(get_executor(), update_value_impl(variable), asio::detached);
+  struct ndata_stats {
+    std::uint64_t payloads{};     // NDATA payloads sent
+    std::uint64_t metrics{};      // metrics sent in those payloads
+    std::uint64_t coalesced{};    // changes replaced by a newer value of the same metric before being sent
+    std::uint64_t bytes{};        // serialized payload bytes sent
+    std::uint64_t saved_bytes{};  // bytes the sent metrics would have taken for name, datatype and description
+  };
+
+  /// \brief stage the current value of variable for the next NDATA payload
+  /// Changes are collected for the configured flush window, or until the payload reaches its metric or byte budget,
+  /// and sent as one payload. Only the latest value of each metric is kept unless keep_history is set.
+  /// Only the value and timestamp are written per change, the rest of the metric is copied from its prototype and the
+  /// metric objects of the pending payload are reused from one batch to the next.
+  /// With aliases enabled the metric is identified by the alias assigned in the birth certificate, the name, datatype
+  /// and description are only sent in the birth certificate.
+  auto update_value(structs::spark_plug_b_variable const& variable) -> void {
+    auto const& batch{ config_.value().ndata };
+    auto& slot{ slot_for(variable) };
+    Payload_Metric* metric{ nullptr };
+    if (!batch.keep_history && slot.batch == batch_) {
+      metric = pending_.mutable_metrics(slot.index);
+      stats_.coalesced++;
+      pending_bytes_ -= metric->ByteSizeLong();
+    } else {
+      slot.batch = batch_;
+      slot.index = pending_.metrics_size();
+      metric = pending_.add_metrics();
+      metric->CopyFrom(slot.prototype);
+      pending_saved_bytes_ += slot.saved_bytes;
+    }
+    metric->set_timestamp(timestamp_milliseconds().count());
+    set_value_payload(metric, variable.value);
+    pending_bytes_ += metric->ByteSizeLong();
+
+    logger_.trace("Staged variable: {}, {} metrics pending", variable.name, pending_.metrics_size());
+
+    if (batch.flush_window <= std::chrono::milliseconds{ 0 } ||
+        static_cast<std::size_t>(pending_.metrics_size()) >= batch.max_metrics || pending_bytes_ >= batch.max_bytes) {
+      flush();
+      return;
+    }
+    if (flush_timer_batch_ != batch_) {
+      flush_timer_batch_ = batch_;
+      flush_timer_.expires_after(batch.flush_window);
+      // an expired wait is queued with no error even if the batch was flushed since, it must not flush the next one
+      flush_timer_.async_wait([this, armed_batch = batch_](std::error_code const& err) {
+        if (err || armed_batch != batch_) {
+          return;
+        }
+        flush();
+      });
+    }
   }
 
-  auto update_value_impl(structs::spark_plug_b_variable& variable) -> asio::awaitable<void> {
-    Payload payload = make_payload();
-    Payload_Metric* metric = payload.add_metrics();
+  /// \brief send the staged metrics as one NDATA payload
+  auto flush() -> void {
+    if (flush_timer_batch_ == batch_) {
+      flush_timer_.cancel();
+    }
+    if (pending_.metrics_size() == 0) {
+      return;
+    }
+    auto const timestamp{ static_cast<uint64_t>(timestamp_milliseconds().count()) };
+    pending_.set_timestamp(timestamp);
+    pending_.set_seq(next_seq());
+
+    std::string payload_string;
+    pending_.SerializeToString(&payload_string);
+
+    stats_.payloads++;
+    stats_.metrics += static_cast<std::uint64_t>(pending_.metrics_size());
+    stats_.bytes += payload_string.size();
+    stats_.saved_bytes += pending_saved_bytes_;
+
+    logger_.trace("Sending {} metrics in {} bytes on topic: {}", pending_.metrics_size(), payload_string.size(),
+                  ndata_topic_);
+
+    // cleared metrics stay allocated and are handed out again by add_metrics
+    pending_.Clear();
+    batch_++;
+    pending_bytes_ = 0;
+    pending_saved_bytes_ = 0;
+
+    asio::co_spawn(get_executor(), forward(std::move(payload_string), timestamp), asio::detached);
+  }
 
-    if (metric == nullptr) {
-      logger_.error("Failed to add metric to payload for variable: {}", variable.name);
+  /// \brief send an NDATA payload, or buffer it on disk while the broker is unreachable
+  auto forward(std::string payload, uint64_t timestamp) -> asio::awaitable<void> {
+    if (online_) {
+      bool const sent = co_await mqtt_client_->send_message(ndata_topic_, payload, async_mqtt::qos::at_most_once);
+      if (sent) {
+        co_return;
+      }
+      logger_.warn("Sending NDATA failed, buffering payloads until the broker is reachable");
+      online_ = false;
+    }
+    auto* buffer{ offline() };
+    if (buffer == nullptr) {
       co_return;
     }
+    auto const stamp{ offline_buffer::clock::time_point{ std::chrono::milliseconds{ timestamp } } };
+    // aliases are only valid until the bridge restarts, the buffer may outlive them
+    if (auto const err{ buffer->push(with_names(payload), stamp) }) {
+      logger_.warn("Unable to buffer NDATA payload: {}", err.message());
+    }
+  }
 
-    metric->set_name(variable.name);
-    metric->set_timestamp(timestamp_milliseconds().count());
-    metric->set_datatype(variable.datatype);
+  /// \brief send the birth certificate followed by the payloads buffered while the broker was unreachable
+  auto send_birth_and_replay(std::string topic, std::string payload) -> asio::awaitable<void> {
+    bool const sent =
+        co_await mqtt_client_->send_message(std::move(topic), std::move(payload), async_mqtt::qos::at_most_once);
+    if (sent) {
+      co_await replay();
+    }
+  }
 
-    if (variable.value.has_value()) {
-      set_value_payload(metric, variable.value.value(), logger_);
-    } else {
-      metric->set_is_null(true);
+  /// \brief send the buffered payloads in order with every metric marked historical
+  /// A payload is removed from the buffer once it has been sent, so a new outage resumes where the replay stopped.
+  /// Payloads buffered meanwhile may drop the record being sent because of the limits, so only a copy and its
+  /// position are kept while sending, and the record is only consumed if it is still the oldest.
+  auto replay() -> asio::awaitable<void> {
+    if (replaying_ || !offline_.has_value()) {
+      co_return;
     }
+    replaying_ = true;
+    std::size_t replayed{};
+    while (online_) {
+      std::string payload_string;
+      offline_buffer::position position{};
+      {
+        auto const record{ offline_->front() };
+        if (!record.has_value()) {
+          break;
+        }
+        position = record->position;
+        Payload payload;
+        if (!payload.ParseFromArray(record->payload.data(), static_cast<int>(record->payload.size()))) {
+          logger_.warn("Discarding unreadable buffered payload of {} bytes", record->payload.size());
+          offline_->pop(position);
+          continue;
+        }
+        for (auto& metric : *payload.mutable_metrics()) {
+          metric.set_is_historical(true);
+        }
+        payload.set_seq(next_seq());
+        payload.SerializeToString(&payload_string);
+      }
+      bool const sent =
+          co_await mqtt_client_->send_message(ndata_topic_, std::move(payload_string), async_mqtt::qos::at_most_once);
+      if (!sent) {
+        online_ = false;
+        break;
+      }
+      offline_->pop(position);
+      replayed++;
+    }
+    replaying_ = false;
+    if (replayed > 0) {
+      logger_.info("Replayed {} buffered NDATA payloads, {} bytes left", replayed, offline_->size_bytes());
+    }
+  }
 
-    auto* metadata = metric->mutable_metadata();
-    metadata->set_description(variable.description);
+  /// \return the store and forward buffer, opened on first use, or nullptr when disabled
+  auto offline() -> offline_buffer* {
+    auto const& settings{ config_.value().offline };
+    if (!settings.enabled) {
+      return nullptr;
+    }
+    offline_buffer::limits const limits{ .max_bytes = settings.max_bytes, .max_age = settings.max_age };
+    if (offline_.has_value()) {
+      offline_->set_limits(limits);
+    } else {
+      offline_.emplace(base::make_state_file_name("ndata_offline", ""), limits);
+    }
+    return &offline_.value();
+  }
 
-    logger_.trace("Updating variable: {}", variable.name);
-    logger_.trace("Payload: {}", payload.DebugString());
+  [[nodiscard]] auto stats() const noexcept -> ndata_stats const& { return stats_; }
 
-    std::string payload_string;
-    payload.SerializeToString(&payload_string);
+  /// \return the alias assigned to the metric of the given name
+  [[nodiscard]] auto alias(std::string const& name) const -> std::optional<uint64_t> {
+    if (auto const iter{ metrics_.find(name) }; iter != metrics_.end()) {
+      return iter->second.alias;
+    }
+    return std::nullopt;
+  }
 
-    logger_.trace("Sending message on topic: {}", ndata_topic_);
+  /// \return the name of a metric received by name or by alias, empty if the alias is unknown
+  [[nodiscard]] auto name_of(Payload_Metric const& metric) const -> std::string_view {
+    if (metric.has_alias() && metric.name().empty()) {
+      return metric.alias() < aliased_.size() ? std::string_view{ aliased_[metric.alias()]->first } : std::string_view{};
+    }
+    return metric.name();
+  }
 
-    co_await mqtt_client_->send_message(ndata_topic_, payload_string, async_mqtt::qos::at_most_once);
+  /// \return payload with the aliases of its metrics replaced by their names
+  auto with_names(std::string const& payload) const -> std::string {
+    Payload parsed;
+    if (!parsed.ParseFromString(payload)) {
+      return payload;
+    }
+    bool aliased{ false };
+    for (auto& metric : *parsed.mutable_metrics()) {
+      if (!metric.has_alias()) {
+        continue;
+      }
+      if (metric.name().empty() && metric.alias() < aliased_.size()) {
+        auto const& [name, slot]{ *aliased_[metric.alias()] };
+        metric.set_name(name);
+        metric.set_datatype(slot.datatype);
+      }
+      metric.clear_alias();
+      aliased = true;
+    }
+    if (!aliased) {
+      return payload;
+    }
+    std::string payload_string;
+    parsed.SerializeToString(&payload_string);
+    return payload_string;
   }
 
   auto set_value_change_callback(
@@ -200,7 +423,7 @@ public:
 
     auto metric = payload.metrics(0);
 
-    logger_.trace("Incoming NCMD payload: \n {}", payload.DebugString());
+    logger_.trace("Incoming NCMD payload: \n {}", debug_string{ payload });
 
     if (payload.has_seq()) {
       logger_.error("NCMD payload should not have a seq nr timestamp but it does.");
@@ -218,7 +441,7 @@ public:
       logger_.error("NCMD payload should have retain set to false but it doesn't");
     }
 
-    if (metric.name() == constants::rebirth_metric) {
+    if (name_of(metric) == constants::rebirth_metric) {
       logger_.trace("NBIRTH requested.");
       send_current_values();
     } else {
@@ -229,47 +452,49 @@ public:
 
   auto set_metric_callback(Payload_Metric const& metric) -> void {
     if (value_change_callback_.has_value()) {
+      std::string name{ name_of(metric) };
+      if (name.empty()) {
+        logger_.warn("Received metric with unknown alias: {}", metric.alias());
+        return;
+      }
       if (metric.has_boolean_value()) {
-        (value_change_callback_.value())(metric.name(), metric.boolean_value());
+        (value_change_callback_.value())(std::move(name), metric.boolean_value());
       } else if (metric.has_double_value()) {
-        (value_change_callback_.value())(metric.name(), metric.double_value());
+        (value_change_callback_.value())(std::move(name), metric.double_value());
       } else if (metric.has_float_value()) {
-        (value_change_callback_.value())(metric.name(), metric.float_value());
+        (value_change_callback_.value())(std::move(name), metric.float_value());
       } else if (metric.has_int_value()) {
-        (value_change_callback_.value())(metric.name(), static_cast<uint64_t>(metric.int_value()));
+        (value_change_callback_.value())(std::move(name), static_cast<uint64_t>(metric.int_value()));
       } else if (metric.has_long_value()) {
-        (value_change_callback_.value())(metric.name(), metric.long_value());
+        (value_change_callback_.value())(std::move(name), metric.long_value());
       } else if (metric.has_string_value()) {
-        (value_change_callback_.value())(metric.name(), metric.string_value());
+        (value_change_callback_.value())(std::move(name), metric.string_value());
       }
     }
   }
 
   auto get_executor() const -> asio::any_io_executor { return mqtt_client_->get_executor(); }
 
-  static auto set_value_payload(Payload_Metric* metric, std::optional<std::any> const& value, logger::logger const& logger)
-      -> void {
-    if (value.has_value()) {
-      if (value.value().type() == typeid(bool)) {
-        metric->set_boolean_value(std::any_cast<bool>(value.value()));
-      } else if (value.value().type() == typeid(std::string)) {
-        metric->set_string_value(std::any_cast<std::string>(value.value()));
-      } else if (value.value().type() == typeid(uint64_t)) {
-        metric->set_long_value(std::any_cast<uint64_t>(value.value()));
-      } else if (value.value().type() == typeid(int64_t)) {
-        metric->set_long_value(std::any_cast<int64_t>(value.value()));
-      } else if (value.value().type() == typeid(double)) {
-        metric->set_double_value(std::any_cast<double>(value.value()));
-      } else if (value.value().type() == typeid(float)) {
-        metric->set_float_value(std::any_cast<float>(value.value()));
-      } else if (value.value().type() == typeid(uint32_t)) {
-        metric->set_int_value(std::any_cast<uint32_t>(value.value()));
-      } else {
-        logger.error("Unknown type: {}", value.value().type().name());
-      }
-    } else {
+  static auto set_value_payload(Payload_Metric* metric, std::optional<structs::metric_value> const& value) -> void {
+    if (!value.has_value()) {
+      metric->clear_value();
       metric->set_is_null(true);
+      return;
     }
+    metric->clear_is_null();
+    std::visit(
+        [metric]<typename value_t>(value_t const& val) {
+          if constexpr (std::same_as<value_t, bool>) {
+            metric->set_boolean_value(val);
+          } else if constexpr (std::same_as<value_t, std::string>) {
+            metric->set_string_value(val);
+          } else if constexpr (std::same_as<value_t, double>) {
+            metric->set_double_value(val);
+          } else {
+            metric->set_long_value(static_cast<uint64_t>(val));
+          }
+        },
+        value.value());
   }
 
   static auto topic_formatter(std::vector<std::string_view> const& topic_vector) -> std::string {
@@ -282,7 +507,15 @@ public:
     return topic;
   }
 
-  auto connect_mqtt_client() -> asio::awaitable<bool> { co_return co_await mqtt_client_->connect(); }
+  auto connect_mqtt_client() -> asio::awaitable<bool> {
+    online_ = false;
+    online_ = co_await mqtt_client_->connect();
+    if (online_ && !offline_.has_value()) {
+      // payloads buffered before a restart of the bridge are replayed after the next birth certificate
+      std::ignore = offline();
+    }
+    co_return online_;
+  }
 
   auto subscribe_to_ncmd() -> asio::awaitable<bool> { co_return co_await mqtt_client_->subscribe_to_topic(ncmd_topic_); }
 
@@ -297,6 +530,52 @@ private:
   config_t& config_;
   std::unique_ptr<mqtt_client_t> mqtt_client_;
   std::vector<structs::spark_plug_b_variable> variables_;
+  asio::steady_timer flush_timer_{ io_ctx_ };
+  std::uint64_t flush_timer_batch_{};  // batch the flush timer is armed for, it is disarmed once batch_ moves on
+  struct metric_slot {
+    Payload_Metric prototype{};  // alias or name and datatype, copied into the payload when first staged in a batch
+    std::uint64_t batch{};       // batch the metric was last staged in
+    int index{};                 // position of the metric in the pending payload of that batch
+    std::uint64_t alias{};       // assigned once, stays the same for every birth certificate of this process
+    DataType datatype{};         // datatype announced in the birth certificate
+    std::size_t saved_bytes{};   // size of name, datatype and description the prototype does not carry
+  };
+  auto slot_for(structs::spark_plug_b_variable const& variable) -> metric_slot& {
+    auto [iter, inserted]{ metrics_.try_emplace(variable.name) };
+    if (inserted) {
+      iter->second.alias = aliased_.size();
+      aliased_.emplace_back(&*iter);
+      make_prototype(iter->second, variable);
+    }
+    return iter->second;
+  }
+  /// \brief the parts of a metric that stay the same from one value to the next, descriptions are left to the birth
+  auto make_prototype(metric_slot& slot, structs::spark_plug_b_variable const& variable) const -> void {
+    Payload_Metric full{};
+    full.set_name(variable.name);
+    full.set_datatype(variable.datatype);
+    full.mutable_metadata()->set_description(variable.description);
+
+    slot.datatype = variable.datatype;
+    slot.prototype.Clear();
+    if (config_.value().ndata.aliases) {
+      slot.prototype.set_alias(slot.alias);
+    } else {
+      slot.prototype.set_name(variable.name);
+      slot.prototype.set_datatype(variable.datatype);
+    }
+    slot.saved_bytes = full.ByteSizeLong() - slot.prototype.ByteSizeLong();
+  }
+  std::unordered_map<std::string, metric_slot> metrics_;
+  std::vector<std::pair<std::string const, metric_slot> const*> aliased_;  // entries of metrics_ indexed by alias
+  std::uint64_t batch_{ 1 };
+  Payload pending_;
+  std::size_t pending_bytes_{};
+  std::size_t pending_saved_bytes_{};
+  ndata_stats stats_{};
+  std::optional<offline_buffer> offline_{};
+  bool online_{ false };
+  bool replaying_{ false };
   uint64_t seq_ = 1;
   logger::logger logger_{ "spark_plug_interface" };
   std::optional<std::function<void(std::string, std::variant<bool, double, std::string, int64_t, uint64_t>)> >
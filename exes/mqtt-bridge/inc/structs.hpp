@@ -1,8 +1,9 @@
 #pragma once
 
-#include <any>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <variant>
 
 #include <sparkplug_b/sparkplug_b.pb.h>
 
@@ -10,10 +11,13 @@ namespace tfc::mqtt::structs {
 
 enum struct ssl_active_e { yes, no };
 
+/// \brief value of a metric, one alternative per Spark Plug B value field the tfc types map to
+using metric_value = std::variant<bool, std::int64_t, std::uint64_t, double, std::string>;
+
 struct spark_plug_b_variable {
   std::string name;
   org::eclipse::tahu::protobuf::DataType datatype;
-  std::optional<std::any> value;
+  std::optional<metric_value> value;
   std::string description;
 };
 
@@ -1,16 +1,24 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <ranges>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
 #include <boost/asio.hpp>
+#include <sdbusplus/bus/match.hpp>
 
 #include <tfc/ipc.hpp>
 #include <tfc/logger.hpp>
 
+#include <signal_matcher.hpp>
 #include <signal_names.hpp>
 #include <spark_plug_interface.hpp>
 #include <structs.hpp>
@@ -42,6 +50,7 @@ public:
     using enum ipc::details::type_e;
     switch (type) {
       case unknown:
+      case _struct:  // records are not known at runtime
         return DataType::Unknown;
       case _bool:
         return DataType::Boolean;
@@ -75,94 +84,178 @@ public:
     return signal_name_to_format;
   }
 
+  /// \brief subscribe to the ipc-ruler changes and publish the matching signals, always followed by a birth certificate
   auto set_signals() -> void {
     logger_.trace("Starting to add new signals...");
+    matcher_ = signal_matcher{};
+    for (auto const& publish_signal : config_.value().publish_signals) {
+      matcher_.add(publish_signal.value);
+    }
+    if (!changes_registered_) {
+      changes_registered_ = true;
+      changes_match_ = ipc_client_.register_changes_callback(
+          [this](std::uint64_t generation, std::vector<ipc_ruler::change> const& changes) {
+            handle_changes(generation, changes);
+          });
+    }
     ipc_client_.signals(
         [this](std::vector<ipc_ruler::signal> const& signals) { handle_incoming_signals_from_ipc_client(signals); });
   }
 
-  auto is_publish_signal(std::string signal_name) -> bool {
-    // check if signal is a writeable signal
-    if (signal_name.starts_with(base::get_exe_name())) {
-      logger_.trace("Signal is a writeable signal");
-      return true;
-    }
-
-    for (const auto& publish_signal : config_.value().publish_signals) {
-      if (publish_signal.value == signal_name) {
-        logger_.trace("Signal {} is in the list of signals to publish", signal_name);
-        return true;
-      }
-    }
-    logger_.trace("Signal {} is not in the list of signals to publish", signal_name);
-    return false;
+  auto is_publish_signal(std::string_view signal_name) const -> bool {
+    // signals of this process are the writeable signals
+    return signal_name.starts_with(base::get_exe_name()) || matcher_.matches(signal_name);
   }
 
   auto handle_incoming_signals_from_ipc_client(std::vector<ipc_ruler::signal> const& signals) -> void {
-    global::set_signals(signals);
-    logger_.trace("Received {} new signals to add.", signals.size());
-
-    signals_.clear();
-    spb_variables_.clear();
-
-    signals_.reserve(signals.size());
-    spb_variables_.reserve(signals.size());
+    logger_.trace("Received {} signals.", signals.size());
+    refresh(signals);
+    set_current_values();
+  }
 
-    for (const auto& signal : signals) {
-      if (!is_publish_signal(signal.name)) {
+  /// \brief apply the changes announced by the ipc-ruler, a birth certificate is only sent if the published metrics
+  /// changed. When changes were missed the whole list of signals is read again.
+  auto handle_changes(std::uint64_t generation, std::vector<ipc_ruler::change> const& changes) -> void {
+    if (changes.empty()) {
+      return;
+    }
+    bool const missed{ last_generation_ != 0 && changes.front().generation > last_generation_ + 1 };
+    last_generation_ = generation;
+    if (missed) {
+      logger_.info("Missed ipc-ruler changes, reading all signals again");
+      ipc_client_.signals([this](std::vector<ipc_ruler::signal> const& signals) {
+        if (refresh(signals)) {
+          set_current_values();
+        }
+      });
+      return;
+    }
+    bool changed{ false };
+    auto known{ global::get_signals() };
+    for (auto const& change : changes) {
+      if (!change.signal_info.has_value()) {
         continue;
       }
+      auto const& signal{ change.signal_info.value() };
+      if (auto iter{ std::ranges::find(known, signal.name, &ipc_ruler::signal::name) }; iter != known.end()) {
+        *iter = signal;
+      } else {
+        known.emplace_back(signal);
+      }
+      if (is_publish_signal(signal.name)) {
+        changed |= upsert(signal);
+      }
+    }
+    global::set_signals(known);
+    if (changed) {
+      set_current_values();
+    }
+  }
 
-      signals_.emplace_back(ipc::details::make_any_slot_cb::make(signal.type, io_ctx_, signal.name));
-
-      spb_variables_.emplace_back(format_signal_name(signal.name.data()), type_enum_convert(signal.type), std::nullopt,
-                                  signal.description.data());
-
-      logger_.trace("Connecting: {}", signal.name);
+  /// \brief bring the published signals in line with the complete list of signals
+  /// \return true if a published signal was added, removed or changed
+  auto refresh(std::vector<ipc_ruler::signal> const& signals) -> bool {
+    global::set_signals(signals);
+    std::unordered_set<std::string_view> wanted{};
+    wanted.reserve(signals.size());
+    bool changed{ false };
+    for (auto const& signal : signals) {
+      if (is_publish_signal(signal.name)) {
+        wanted.emplace(signal.name);
+        changed |= upsert(signal);
+      }
+    }
+    changed |= std::erase_if(publishers_, [&wanted](auto const& entry) { return !wanted.contains(entry.first); }) > 0;
+    logger_.trace("Publishing {} signals, changed: {}", publishers_.size(), changed);
+    return changed;
+  }
 
-      auto& slot = signals_.back();
-      auto& variable = spb_variables_.back();
+  /// \brief create the slot of a signal, or update its description, the slot is kept when nothing it depends on changed
+  /// \return true if the metric was added or changed
+  auto upsert(ipc_ruler::signal const& signal) -> bool {
+    if (auto iter{ publishers_.find(signal.name) }; iter != publishers_.end()) {
+      auto& existing{ iter->second };
+      if (existing.type == signal.type) {
+        if (existing.variable.description == signal.description) {
+          return false;
+        }
+        existing.variable.description = signal.description;
+        return true;
+      }
+      publishers_.erase(iter);
+    }
 
-      std::visit(
-          [this, &variable](auto&& receiver) {
-            using receiver_t = std::remove_cvref_t<decltype(receiver)>;
-            if constexpr (!std::same_as<receiver_t, std::monostate>) {
-              auto error_code = receiver->connect(receiver->name(), [this, &variable](auto&& value) {
+    logger_.trace("Connecting: {}", signal.name);
+    auto& entry{ publishers_[signal.name] };
+    entry.type = signal.type;
+    entry.variable = { format_signal_name(signal.name), type_enum_convert(signal.type), std::nullopt, signal.description };
+    entry.slot = ipc::details::make_any_slot_cb::make(signal.type, io_ctx_, signal.name);
+
+    std::visit(
+        [this, &variable = entry.variable](auto&& receiver) {
+          using receiver_t = std::remove_cvref_t<decltype(receiver)>;
+          if constexpr (!std::same_as<receiver_t, std::monostate>) {
+            auto error_code = receiver->connect(receiver->name(), [this, &variable](auto&& value) {
+              using value_t = std::remove_cvref_t<decltype(value)>;
+              if constexpr (std::is_constructible_v<structs::metric_value, value_t>) {
                 variable.value = value;
-                spark_plug_interface_.update_value(variable);
-              });
-              if (error_code) {
-                logger_.trace("Error connecting to signal: {}, error: {}", receiver->name(), error_code.message());
+              } else {
+                // quantities have no Spark Plug B value representation yet
+                variable.value = std::nullopt;
               }
+              spark_plug_interface_.update_value(variable);
+            });
+            if (error_code) {
+              logger_.trace("Error connecting to signal: {}, error: {}", receiver->name(), error_code.message());
             }
-          },
-          slot);
-    }
-
-    logger_.trace("All new signals added. Preparing to send NBIRTH and start signals...");
-
-    set_current_values();
+          }
+        },
+        entry.slot);
+    return true;
   }
 
   auto set_current_values() -> void {
     logger_.info("Setting current values to interface");
 
-    spark_plug_interface_.set_current_values(spb_variables_);
+    std::vector<structs::spark_plug_b_variable> variables{};
+    variables.reserve(publishers_.size());
+    for (auto const& [name, entry] : publishers_) {
+      variables.emplace_back(entry.variable);
+    }
+    std::ranges::sort(variables, {}, &structs::spark_plug_b_variable::name);
+
+    spark_plug_interface_.set_current_values(variables);
     spark_plug_interface_.send_current_values();
   }
 
-  auto get_signals() -> std::vector<ipc::details::any_slot_cb>& { return signals_; }
+  /// \return the slot receiving the signal of the given name, nullptr if it is not published
+  auto get_slot(std::string const& signal_name) -> ipc::details::any_slot_cb* {
+    auto iter{ publishers_.find(signal_name) };
+    return iter == publishers_.end() ? nullptr : &iter->second.slot;
+  }
+
+  [[nodiscard]] auto published_count() const noexcept -> std::size_t { return publishers_.size(); }
 
-  auto clear_signals() -> void { signals_.clear(); }
+  auto clear_signals() -> void { publishers_.clear(); }
 
 private:
+  /// \brief a published signal, nodes of the map are stable so the slot callback can refer to the variable
+  struct publisher {
+    ipc::details::type_e type{};
+    structs::spark_plug_b_variable variable{};
+    ipc::details::any_slot_cb slot{};  // declared last so it is destroyed before the variable its callback updates
+  };
+
   asio::io_context& io_ctx_;
   spark_plug_interface<config_t, mqtt_client_t>& spark_plug_interface_;
   config_t& config_;
   ipc_client_t ipc_client_;
   logger::logger logger_{ "tfc_to_external" };
-  std::vector<ipc::details::any_slot_cb> signals_;
-  std::vector<structs::spark_plug_b_variable> spb_variables_;
+  signal_matcher matcher_{};
+  std::unordered_map<std::string, publisher> publishers_{};
+  bool changes_registered_{ false };
+  std::unique_ptr<sdbusplus::bus::match::match> changes_match_{};
+  std::uint64_t last_generation_{};
 
   friend class test_tfc_to_external;
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include <boost/asio.hpp>
 
 #include "../inc/config/bridge.hpp"
@@ -18,6 +20,8 @@ struct bridge_owner_mock {
   std::string node_id{};
   std::string group_id{};
   std::vector<signal_definition> writeable_signals{};
+  ndata_batch ndata{};
+  store_and_forward offline{};
 
   static auto get_port() -> std::string { return "1965"; }
 };
@@ -36,12 +40,17 @@ public:
     owner_.node_id = "tfc_unconfigured_node_id";
     owner_.group_id = "tfc_unconfigured_group_id";
     owner_.writeable_signals = {};
+    // send every change on its own and by name so tests can count and read the NDATA payloads
+    owner_.ndata.flush_window = std::chrono::milliseconds{ 0 };
+    owner_.ndata.aliases = false;
   }
 
   auto add_writeable_signal(std::string name, std::string description, type_e type) -> void {
     owner_.writeable_signals.emplace_back(name, description, type);
   }
 
+  auto set_ndata(ndata_batch const& ndata) -> void { owner_.ndata = ndata; }
+
   [[nodiscard]] auto value() const -> bridge_owner_mock { return owner_; }
 };
 }  // namespace tfc::mqtt::config
@@ -55,7 +55,11 @@ public:
 
     isolated_ctx.run_for(milliseconds{ 1 });
 
-    auto& first_signal = tfc_ext_mock.get_signals()[0];
+    auto* slot = tfc_ext_mock.get_slot("test_mqtt_bridge.def.bool.bool_signal");
+    if (slot == nullptr) {
+      co_return false;
+    }
+    auto& first_signal = *slot;
 
     isolated_ctx.run_for(milliseconds{ 1 });
 
@@ -81,5 +85,36 @@ public:
         },
         first_signal);
   }
+
+  /// \brief signals registered after the initial list only add their own slot, existing slots are kept
+  auto test_incremental() -> bool {
+    using std::chrono::milliseconds;
+
+    asio::io_context isolated_ctx{};
+
+    ipc_ruler::ipc_manager_client_mock ipc_mock{ isolated_ctx };
+    ipc::signal<ipc::details::type_bool, ipc_ruler::ipc_manager_client_mock&> first(isolated_ctx, ipc_mock, "first");
+    isolated_ctx.run_for(milliseconds{ 1 });
+
+    config::bridge_mock config{ isolated_ctx, "test" };
+    spark_plug_interface<config::bridge_mock, client<endpoint_client_mock, config::bridge_mock> > sp_mock{ isolated_ctx,
+                                                                                                           config };
+    tfc_to_external<config::bridge_mock, client<endpoint_client_mock, config::bridge_mock>,
+                    ipc_ruler::ipc_manager_client_mock&>
+        tfc_ext_mock{ isolated_ctx, sp_mock, ipc_mock, config };
+
+    tfc_ext_mock.set_signals();
+    isolated_ctx.run_for(milliseconds{ 1 });
+    auto* const first_slot = tfc_ext_mock.get_slot("test_mqtt_bridge.def.bool.first");
+    if (first_slot == nullptr || tfc_ext_mock.published_count() != 1) {
+      return false;
+    }
+
+    ipc::signal<ipc::details::type_bool, ipc_ruler::ipc_manager_client_mock&> second(isolated_ctx, ipc_mock, "second");
+    isolated_ctx.run_for(milliseconds{ 1 });
+
+    return tfc_ext_mock.published_count() == 2 && tfc_ext_mock.get_slot("test_mqtt_bridge.def.bool.first") == first_slot &&
+           tfc_ext_mock.get_slot("test_mqtt_bridge.def.bool.second") != nullptr;
+  }
 };
 }  // namespace tfc::mqtt
@@ -1,4 +1,5 @@
 #include <expected>
+#include <filesystem>
 #include <iostream>
 #include <tuple>
 
@@ -27,6 +28,7 @@ PRAGMA_CLANG_WARNING_POP
 #include <constants.hpp>
 #include <endpoint.hpp>
 #include <run.hpp>
+#include <spark_plug_interface.hpp>
 #include "../inc/endpoint_mock.hpp"
 
 namespace ut = boost::ut;
@@ -267,5 +269,54 @@ auto main(int argc, char* argv[]) -> int {
     expect(sixth_message.metrics()[0].string_value() == "number_3");
   };
 
+  "values changed while the broker is down are replayed as historical"_test = [&]() {
+    asio::io_context io_ctx{};
+    std::filesystem::remove_all(tfc::base::make_state_file_name("ndata_offline", ""));
+
+    tfc::mqtt::config::bridge_mock config{ io_ctx, "test" };
+    tfc::mqtt::spark_plug_interface<tfc::mqtt::config::bridge_mock,
+                                    tfc::mqtt::client<tfc::mqtt::endpoint_client, tfc::mqtt::config::bridge_mock>>
+        sp{ io_ctx, config };
+
+    // no broker yet, the changes are buffered on disk
+    tfc::mqtt::structs::spark_plug_b_variable variable{ "offline/bool/test", org::eclipse::tahu::protobuf::DataType::Boolean,
+                                                        std::nullopt, "test" };
+    for (bool const value : { true, false, true }) {
+      variable.value = value;
+      sp.update_value(variable);
+    }
+    io_ctx.run_for(std::chrono::milliseconds{ 5 });
+
+    // start broker
+    mqtt_broker broker3{ io_ctx };
+    io_ctx.run_for(std::chrono::milliseconds{ 5 });
+
+    std::string ndata_topic = "spBv1.0/tfc_unconfigured_group_id/NDATA/tfc_unconfigured_node_id";
+    std::vector<async_mqtt::buffer> messages3;
+    mqtt_client ndata_cli{ io_ctx, messages3, ndata_topic };
+    io_ctx.run_for(std::chrono::milliseconds{ 5 });
+
+    bool connected{ false };
+    co_spawn(
+        io_ctx, [&]() -> asio::awaitable<void> { connected = co_await sp.connect_mqtt_client(); }, asio::detached);
+    io_ctx.run_for(std::chrono::milliseconds{ 50 });
+    expect(connected);
+
+    sp.set_current_values({ variable });
+    sp.send_current_values();
+    io_ctx.run_for(std::chrono::milliseconds{ 50 });
+
+    expect(messages3.size() == 3) << "messages.size() == " << messages3.size();
+    for (std::size_t idx = 0; idx < messages3.size(); idx++) {
+      org::eclipse::tahu::protobuf::Payload replayed;
+      replayed.ParseFromArray(messages3[idx].data(), static_cast<int>(messages3[idx].size()));
+      expect(replayed.metrics_size() == 1);
+      expect(replayed.metrics()[0].name() == "offline/bool/test");
+      expect(replayed.metrics()[0].is_historical());
+      expect(replayed.metrics()[0].boolean_value() == (idx % 2 == 0));
+      expect(replayed.seq() == idx + 1) << "seq " << replayed.seq();
+    }
+  };
+
   return 0;
 }
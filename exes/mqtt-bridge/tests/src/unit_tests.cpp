@@ -1,5 +1,11 @@
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <async_mqtt/all.hpp>
 #include <boost/asio.hpp>
@@ -11,6 +17,8 @@
 #include <client.hpp>
 #include <constants.hpp>
 #include <endpoint_mock.hpp>
+#include <offline_buffer.hpp>
+#include <signal_matcher.hpp>
 #include <spark_plug_interface.hpp>
 #include <test_external_to_tfc.hpp>
 #include <test_tfc_to_external.hpp>
@@ -43,6 +51,26 @@ auto main(int argc, char* argv[]) -> int {
     expect(set_signals);
   };
 
+  "tfc to external adds signals registered later"_test = [&]() {
+    tfc::mqtt::test_tfc_to_external test_ext{};
+    expect(test_ext.test_incremental());
+  };
+
+  "signal matcher"_test = [&]() {
+    std::vector<std::string> const patterns{ "operations.def.bool.running", "ethercat.def.bool.*", "*.def.double.el3062_*" };
+    tfc::mqtt::signal_matcher const matcher{ patterns };
+    expect(matcher.matches("operations.def.bool.running"));
+    expect(!matcher.matches("operations.def.bool.running2"));
+    expect(matcher.matches("ethercat.def.bool.el1008_s3_in4"));
+    expect(!matcher.matches("ethercat.def.int64.el1008_s3_in4"));
+    expect(matcher.matches("ethercat.def.double.el3062_s4_in1"));
+    expect(!matcher.matches("ethercat.def.double.el3064_s4_in1"));
+    expect(tfc::mqtt::signal_matcher::glob_match("a?c*", "abcdef"));
+    expect(tfc::mqtt::signal_matcher::glob_match("*b*d*", "abcdef"));
+    expect(!tfc::mqtt::signal_matcher::glob_match("*b*x*", "abcdef"));
+    expect(tfc::mqtt::signal_matcher{}.empty());
+  };
+
   "testing constants"_test = [&]() {
     expect(tfc::mqtt::constants::namespace_element == "spBv1.0");
     expect(tfc::mqtt::constants::ndata == "NDATA");
@@ -61,6 +89,183 @@ auto main(int argc, char* argv[]) -> int {
     expect(sp.topic_formatter({ "first", "second" }) == "first/second");
   };
 
+  "spark plug interface batches changed values into one NDATA payload"_test = [&]() {
+    asio::io_context ctx;
+    tfc::mqtt::config::bridge_mock config{ ctx, "test" };
+    config.set_ndata({ .flush_window = std::chrono::milliseconds{ 50 } });
+    tfc::mqtt::spark_plug_interface<tfc::mqtt::config::bridge_mock,
+                                    tfc::mqtt::client<tfc::mqtt::endpoint_client_mock, tfc::mqtt::config::bridge_mock> >
+        sp{ ctx, config };
+
+    std::vector<tfc::mqtt::structs::spark_plug_b_variable> variables{
+      { "tfc/bool/first", org::eclipse::tahu::protobuf::DataType::Boolean, std::nullopt, "first" },
+      { "tfc/bool/second", org::eclipse::tahu::protobuf::DataType::Boolean, std::nullopt, "second" },
+      { "tfc/bool/third", org::eclipse::tahu::protobuf::DataType::Boolean, std::nullopt, "third" },
+    };
+    for (bool const value : { true, false, true }) {
+      for (auto& variable : variables) {
+        variable.value = value;
+        sp.update_value(variable);
+      }
+    }
+    expect(sp.stats().payloads == 0);
+    ctx.run_for(std::chrono::milliseconds{ 100 });
+    expect(sp.stats().payloads == 1);
+    expect(sp.stats().metrics == 3);
+    expect(sp.stats().coalesced == 6);
+  };
+
+  "spark plug interface flushing while the flush timer expires keeps the next batch"_test = [&]() {
+    asio::io_context ctx;
+    tfc::mqtt::config::bridge_mock config{ ctx, "test" };
+    config.set_ndata({ .flush_window = std::chrono::milliseconds{ 20 } });
+    tfc::mqtt::spark_plug_interface<tfc::mqtt::config::bridge_mock,
+                                    tfc::mqtt::client<tfc::mqtt::endpoint_client_mock, tfc::mqtt::config::bridge_mock> >
+        sp{ ctx, config };
+
+    tfc::mqtt::structs::spark_plug_b_variable first{ "tfc/bool/first", org::eclipse::tahu::protobuf::DataType::Boolean,
+                                                     true, "first" };
+    tfc::mqtt::structs::spark_plug_b_variable second{ "tfc/bool/second", org::eclipse::tahu::protobuf::DataType::Boolean,
+                                                      true, "second" };
+    sp.update_value(first);
+    // queued ahead of the timer, which is only found expired once the io_context runs after the window
+    asio::post(ctx, [&sp, &second] {
+      sp.flush();
+      sp.update_value(second);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 30 });
+    ctx.poll();
+    expect(sp.stats().payloads == 1) << sp.stats().payloads;
+
+    // the second batch is sent at the end of its own window
+    ctx.run_for(std::chrono::milliseconds{ 50 });
+    expect(sp.stats().payloads == 2) << sp.stats().payloads;
+  };
+
+  "spark plug interface sends aliases instead of names in NDATA"_test = [&]() {
+    using spark_plug_t =
+        tfc::mqtt::spark_plug_interface<tfc::mqtt::config::bridge_mock,
+                                        tfc::mqtt::client<tfc::mqtt::endpoint_client_mock, tfc::mqtt::config::bridge_mock> >;
+    auto const directory{ tfc::base::make_state_file_name("ndata_offline", "") };
+    std::filesystem::remove_all(directory);
+    auto const send{ [](bool aliases) -> std::pair<spark_plug_t::ndata_stats, std::optional<std::uint64_t>> {
+      asio::io_context ctx;
+      tfc::mqtt::config::bridge_mock config{ ctx, "test" };
+      config.set_ndata({ .flush_window = std::chrono::milliseconds{ 0 }, .aliases = aliases });
+      spark_plug_t sp{ ctx, config };
+      tfc::mqtt::structs::spark_plug_b_variable variable{ "ethercat/def/bool/el1008/s3/in4",
+                                                          org::eclipse::tahu::protobuf::DataType::Boolean, true,
+                                                          "digital input" };
+      sp.set_current_values({ variable });
+      sp.update_value(variable);
+      // not connected, so the payload ends up in the offline buffer
+      ctx.run_for(std::chrono::milliseconds{ 10 });
+      return { sp.stats(), sp.alias(variable.name) };
+    } };
+    auto const [by_name, no_alias]{ send(false) };
+    auto const [by_alias, alias]{ send(true) };
+    expect(no_alias.has_value() && alias.has_value());
+    expect(by_alias.bytes < by_name.bytes) << by_alias.bytes << " < " << by_name.bytes;
+    expect(by_alias.saved_bytes > by_name.saved_bytes);
+    expect(by_name.saved_bytes > 0);  // the description is only sent in the birth certificate
+
+    // buffered payloads outlive the aliases of this process so they are stored by name
+    tfc::mqtt::offline_buffer buffer{ directory, { .max_bytes = 64 * 1024, .max_age = std::chrono::hours{ 1 } } };
+    for (int idx = 0; idx < 2; idx++) {
+      auto const record{ buffer.front() };
+      expect(record.has_value());
+      if (!record.has_value()) {
+        break;
+      }
+      org::eclipse::tahu::protobuf::Payload payload;
+      expect(payload.ParseFromArray(record->payload.data(), static_cast<int>(record->payload.size())));
+      expect(payload.metrics_size() == 1);
+      expect(payload.metrics(0).name() == "ethercat/def/bool/el1008/s3/in4");
+      expect(!payload.metrics(0).has_alias());
+      expect(!payload.metrics(0).has_metadata());
+      buffer.pop();
+    }
+    std::filesystem::remove_all(directory);
+  };
+
+  "offline buffer keeps payloads in order across restarts"_test = [&]() {
+    using namespace std::chrono_literals;
+    auto const directory{ std::filesystem::temp_directory_path() / "tfc_mqtt_offline_buffer_test" };
+    std::filesystem::remove_all(directory);
+    tfc::mqtt::offline_buffer::limits const limits{ .max_bytes = 64 * 1024, .max_age = 1h };
+    {
+      tfc::mqtt::offline_buffer buffer{ directory, limits };
+      expect(buffer.empty());
+      for (int idx = 0; idx < 1000; idx++) {
+        expect(!buffer.push(fmt::format("payload {}", idx)));
+      }
+      expect(buffer.segments() > 1);
+      buffer.pop();
+    }
+    tfc::mqtt::offline_buffer buffer{ directory, limits };
+    for (int idx = 1; idx < 1000; idx++) {
+      auto const record{ buffer.front() };
+      expect(record.has_value() && record->payload == fmt::format("payload {}", idx));
+      buffer.pop();
+    }
+    expect(buffer.empty());
+    expect(!buffer.front().has_value());
+    expect(std::filesystem::is_empty(directory));
+    std::filesystem::remove_all(directory);
+  };
+
+  "offline buffer only pops a record that is still the oldest"_test = [&]() {
+    using namespace std::chrono_literals;
+    auto const directory{ std::filesystem::temp_directory_path() / "tfc_mqtt_offline_position_test" };
+    std::filesystem::remove_all(directory);
+    tfc::mqtt::offline_buffer buffer{ directory, { .max_bytes = 64 * 1024, .max_age = 1h } };
+    expect(!buffer.push("first"));
+    auto const sending{ buffer.front() };
+    expect(sending.has_value());
+    if (!sending.has_value()) {
+      return;
+    }
+    auto const position{ sending->position };
+    // payloads buffered while "first" is being sent push it out of the limits
+    std::string const payload(100, 'x');
+    for (int idx = 0; idx < 10000; idx++) {
+      expect(!buffer.push(payload));
+    }
+    auto const oldest{ buffer.front() };
+    expect(oldest.has_value());
+    if (!oldest.has_value()) {
+      return;
+    }
+    expect(oldest->position != position);
+    buffer.pop(position);
+    expect(buffer.front()->position == oldest->position);
+    buffer.pop(oldest->position);
+    expect(buffer.front()->position != oldest->position);
+    std::filesystem::remove_all(directory);
+  };
+
+  "offline buffer drops the oldest payloads beyond its limits"_test = [&]() {
+    using namespace std::chrono_literals;
+    auto const directory{ std::filesystem::temp_directory_path() / "tfc_mqtt_offline_limits_test" };
+    std::filesystem::remove_all(directory);
+    tfc::mqtt::offline_buffer buffer{ directory, { .max_bytes = 64 * 1024, .max_age = 1h } };
+    std::string const payload(100, 'x');
+    for (int idx = 0; idx < 10000; idx++) {
+      expect(!buffer.push(payload));
+    }
+    expect(buffer.size_bytes() <= 64 * 1024);
+    expect(buffer.dropped_bytes() > 0);
+
+    while (buffer.front().has_value()) {
+      buffer.pop();
+    }
+    buffer.set_limits({ .max_bytes = 64 * 1024, .max_age = 1min });
+    expect(!buffer.push("stale", tfc::mqtt::offline_buffer::clock::now() - 1h));
+    expect(!buffer.front().has_value());
+    expect(buffer.empty());
+    std::filesystem::remove_all(directory);
+  };
+
   "testing tfc to external"_test = [&]() {
     tfc::ipc_ruler::ipc_manager_client_mock ipc_mock{ io_ctx };
 
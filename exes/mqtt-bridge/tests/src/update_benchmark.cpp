@@ -0,0 +1,119 @@
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <fmt/core.h>
+#include <boost/asio.hpp>
+
+#include <tfc/progbase.hpp>
+
+#include <client.hpp>
+#include <endpoint_mock.hpp>
+#include <spark_plug_interface.hpp>
+#include <structs.hpp>
+
+#include <config/bridge_mock.hpp>
+
+namespace asio = boost::asio;
+
+using tfc::mqtt::structs::spark_plug_b_variable;
+using spark_plug_t =
+    tfc::mqtt::spark_plug_interface<tfc::mqtt::config::bridge_mock,
+                                    tfc::mqtt::client<tfc::mqtt::endpoint_client_mock, tfc::mqtt::config::bridge_mock>>;
+
+namespace {
+
+constexpr std::size_t metric_count{ 5000 };
+constexpr std::size_t rounds{ 200 };
+
+auto make_variables() -> std::vector<spark_plug_b_variable> {
+  std::vector<spark_plug_b_variable> variables{};
+  variables.reserve(metric_count);
+  for (std::size_t idx = 0; idx < metric_count; idx++) {
+    switch (idx % 3) {
+      case 0:
+        variables.emplace_back(fmt::format("ethercat/def/bool/el1008/s{}/in{}", idx / 8, idx % 8),
+                               org::eclipse::tahu::protobuf::DataType::Boolean, std::nullopt, "digital input");
+        break;
+      case 1:
+        variables.emplace_back(fmt::format("ethercat/def/double/el3062/s{}/in{}", idx / 2, idx % 2),
+                               org::eclipse::tahu::protobuf::DataType::Double, std::nullopt, "analog input");
+        break;
+      default:
+        variables.emplace_back(fmt::format("operations/def/string/state{}", idx),
+                               org::eclipse::tahu::protobuf::DataType::String, std::nullopt, "state name");
+        break;
+    }
+  }
+  return variables;
+}
+
+/// \brief every metric changes every round, the cost of staging one change and its share of the payload sent
+void bench(tfc::mqtt::config::ndata_batch const& batch, std::string_view label) {
+  asio::io_context ctx{};
+  tfc::mqtt::config::bridge_mock config{ ctx, "benchmark" };
+  config.set_ndata(batch);
+  spark_plug_t spark_plug{ ctx, config };
+  asio::co_spawn(
+      ctx, [&spark_plug]() -> asio::awaitable<void> { std::ignore = co_await spark_plug.connect_mqtt_client(); },
+      asio::detached);
+  ctx.run();
+  ctx.restart();
+  auto const work{ asio::make_work_guard(ctx) };
+
+  auto variables{ make_variables() };
+  spark_plug.set_current_values(variables);
+
+  auto const start{ std::chrono::steady_clock::now() };
+  for (std::size_t round = 0; round < rounds; round++) {
+    for (std::size_t idx = 0; idx < variables.size(); idx++) {
+      auto& variable{ variables[idx] };
+      switch (idx % 3) {
+        case 0:
+          variable.value = round % 2 == 0;
+          break;
+        case 1:
+          variable.value = static_cast<double>(round) * 0.5;
+          break;
+        default:
+          variable.value = round % 2 == 0 ? std::string{ "running" } : std::string{ "stopped" };
+          break;
+      }
+      spark_plug.update_value(variable);
+    }
+    spark_plug.flush();
+    ctx.poll();
+  }
+  std::chrono::duration<double, std::nano> const elapsed{ std::chrono::steady_clock::now() - start };
+
+  auto const& stats{ spark_plug.stats() };
+  auto const updates{ static_cast<double>(metric_count * rounds) };
+  auto const metrics{ static_cast<double>(stats.metrics) };
+  fmt::print("{:<24} {:>8.1f} ns/update  {:>6} payloads  {:>8.1f} bytes/metric  {:>8.1f} saved bytes/metric\n", label,
+             elapsed.count() / updates, stats.payloads, static_cast<double>(stats.bytes) / metrics,
+             static_cast<double>(stats.saved_bytes) / metrics);
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  tfc::base::init(argc, argv);
+
+  fmt::print("{} metrics, {} rounds\n", metric_count, rounds);
+  for (bool const aliases : { false, true }) {
+    auto const encoding{ aliases ? "by alias" : "by name" };
+    bench({ .flush_window = std::chrono::milliseconds{ 0 }, .aliases = aliases }, fmt::format("per change, {}", encoding));
+    bench({ .flush_window = std::chrono::hours{ 1 }, .max_metrics = 500, .aliases = aliases },
+          fmt::format("500 per payload, {}", encoding));
+    bench({ .flush_window = std::chrono::hours{ 1 },
+            .max_metrics = metric_count,
+            .max_bytes = 16 * 1024 * 1024,
+            .aliases = aliases },
+          fmt::format("one per round, {}", encoding));
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,9 @@ inline auto stdin_coro(asio::io_context& ctx, std::string_view signal_name) -> a
   if (type == ipc::details::type_e::unknown) {
     throw std::runtime_error{ fmt::format("Unknown typename in: {}", signal_name) };
   }
+  if (type == ipc::details::type_e::_struct) {
+    throw std::runtime_error{ fmt::format("Struct layouts are only known at compile time, unsupported: {}", signal_name) };
+  }
   auto sender{ ipc::make_any_signal::make(type, ctx, client, signal_name) };
   std::visit(
       []<typename signal_t>(signal_t& my_signal) {
@@ -165,6 +168,9 @@ auto main(int argc, char** argv) -> int {
       if (type == ipc::details::type_e::unknown) {
         throw std::runtime_error{ fmt::format("Unknown typename in: {}", sig) };
       }
+      if (type == ipc::details::type_e::_struct) {
+        throw std::runtime_error{ fmt::format("Struct layouts are only known at compile time, unsupported: {}", sig) };
+      }
       auto ipc{ ipc::details::make_any_slot_cb::make(type, ctx, connected_slot_name) };
       slot_connect(ipc, sig);
       return ipc;
@@ -181,6 +187,9 @@ auto main(int argc, char** argv) -> int {
     if (type == ipc::details::type_e::unknown) {
       throw std::runtime_error{ fmt::format("Unknown typename in: {}", slot_name) };
     }
+    if (type == ipc::details::type_e::_struct) {
+      throw std::runtime_error{ fmt::format("Struct layouts are only known at compile time, unsupported: {}", slot_name) };
+    }
     tfc::ipc::make_any_slot::make_impl(slot, type, ctx, *client.get(), slot_name, [slot_name](auto new_value) {
       if constexpr (tfc::stx::is_expected<std::remove_cvref_t<decltype(new_value)>>) {
         if (new_value.has_value()) {
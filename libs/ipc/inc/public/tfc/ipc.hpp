@@ -39,14 +39,16 @@ public:
    * @param client manager_client_type a reference to a manager client
    * @param name The slot name
    * @param callback Channel for value updates from the corresponding signal.
+   * @param transport details::transport_e::shm to read same host signals from shared memory when they provide it
    */
   slot(asio::io_context& ctx,
        manager_client_type client,
        std::string_view name,
        std::string_view description,
-       stx::invocable<value_t> auto&& callback)
+       stx::invocable<value_t> auto&& callback,
+       details::transport_e transport = details::transport_e::zmq)
     requires std::is_lvalue_reference_v<manager_client_type>
-      : slot_{ details::slot_callback<type_desc>::create(ctx, name) }, dbus_slot_{ client.connection(), slot_->type_name() },
+      : slot_{ details::slot_callback<type_desc>::create(ctx, name, transport) }, dbus_slot_{ client.connection(), slot_->type_name() },
         client_{ client }, filters_{ client.connection(), slot_->type_name(),
                                      // store the callers callback in this lambda
                                      [this, callb = std::forward<decltype(callback)>(callback)](value_t const& new_value) {
@@ -60,9 +62,10 @@ public:
        std::shared_ptr<sdbusplus::asio::connection> connection,
        std::string_view name,
        std::string_view description,
-       tfc::stx::invocable<value_t> auto&& callback)
+       tfc::stx::invocable<value_t> auto&& callback,
+       details::transport_e transport = details::transport_e::zmq)
     requires(!std::is_lvalue_reference_v<manager_client_type>)
-      : slot_{ details::slot_callback<type_desc>::create(ctx, name) }, dbus_slot_{ connection, slot_->type_name() },
+      : slot_{ details::slot_callback<type_desc>::create(ctx, name, transport) }, dbus_slot_{ connection, slot_->type_name() },
         client_{ connection },
         filters_{ connection, slot_->type_name(),
                   // store the callers callback in this lambda
@@ -98,6 +101,18 @@ public:
    */
   [[nodiscard]] auto connection() const noexcept -> auto const& { return connected_signal_; }
 
+  /// \brief change how filtered values are mirrored on D-Bus, defaults to details::process_mirror_policy
+  void set_dbus_mirror(details::mirror_policy policy) { dbus_slot_.set_mirror_policy(policy); }
+
+  /// \return number of values not emitted on D-Bus because of the mirror policy
+  [[nodiscard]] auto dbus_suppressed() const noexcept -> std::uint64_t { return dbus_slot_.suppressed(); }
+
+  /// \return how values are mirrored on D-Bus
+  [[nodiscard]] auto dbus_mirror() const noexcept -> details::mirror_policy const& { return dbus_slot_.policy(); }
+
+  /// \return number of values emitted on D-Bus
+  [[nodiscard]] auto dbus_emitted() const noexcept -> std::uint64_t { return dbus_slot_.emitted(); }
+
 private:
   void client_init(std::string_view description) {
     client_.register_connection_change_callback(full_name(), [this](std::string_view signal_name) {
@@ -137,10 +152,15 @@ public:
    * Signal c'tor
    * @param ctx Execution context
    * @param name Signals name
+   * @param transport details::transport_e::shm to also publish to same host slots through shared memory
    */
-  signal(asio::io_context& ctx, manager_client_type client, std::string_view name, std::string_view description = "")
+  signal(asio::io_context& ctx,
+         manager_client_type client,
+         std::string_view name,
+         std::string_view description = "",
+         details::transport_e transport = details::transport_e::zmq)
     requires std::is_lvalue_reference_v<manager_client_type>
-      : client_{ client }, signal_{ make_impl_signal(ctx, name) },
+      : client_{ client }, signal_{ make_impl_signal(ctx, name, transport) },
         dbus_signal_{ client_.connection(), signal_->type_name() } {
     client_.register_signal_retry(signal_->full_name(), description, type_desc::value_e);
     dbus_signal_.initialize();
@@ -149,9 +169,10 @@ public:
   signal(asio::io_context& ctx,
          std::shared_ptr<sdbusplus::asio::connection> connection,
          std::string_view name,
-         std::string_view description = "")
+         std::string_view description = "",
+         details::transport_e transport = details::transport_e::zmq)
     requires(!std::is_lvalue_reference_v<manager_client_type>)
-      : client_{ connection }, signal_{ make_impl_signal(ctx, name) },
+      : client_{ connection }, signal_{ make_impl_signal(ctx, name, transport) },
         dbus_signal_{ client_.connection(), signal_->type_name() } {
     client_.register_signal_retry(signal_->full_name(), description, type_desc::value_e);
     dbus_signal_.initialize();
@@ -183,9 +204,25 @@ public:
 
   [[nodiscard]] auto value() const noexcept -> std::optional<value_t> const& { return signal_->value(); }
 
+  /// \brief change the preferred wire format of sent values, slots accept every version regardless of what they send
+  /// v0 is sent until every connected slot has advertised that it reads v1
+  void set_wire_format(details::wire_format format) { signal_->set_wire_format(format); }
+
+  /// \brief change how sent values are mirrored on D-Bus, defaults to details::process_mirror_policy
+  void set_dbus_mirror(details::mirror_policy policy) { dbus_signal_.set_mirror_policy(policy); }
+
+  /// \return number of values not emitted on D-Bus because of the mirror policy
+  [[nodiscard]] auto dbus_suppressed() const noexcept -> std::uint64_t { return dbus_signal_.suppressed(); }
+
+  /// \return how values are mirrored on D-Bus
+  [[nodiscard]] auto dbus_mirror() const noexcept -> details::mirror_policy const& { return dbus_signal_.policy(); }
+
+  /// \return number of values emitted on D-Bus
+  [[nodiscard]] auto dbus_emitted() const noexcept -> std::uint64_t { return dbus_signal_.emitted(); }
+
 private:
-  static auto make_impl_signal(auto&& ctx, auto&& name) {
-    auto exp{ details::signal<type_desc>::create(ctx, name) };
+  static auto make_impl_signal(auto&& ctx, auto&& name, details::transport_e transport) {
+    auto exp{ details::signal<type_desc>::create(ctx, name, transport) };
     if (!exp.has_value()) {
       throw std::runtime_error{ fmt::format("Unable to bind to socket, reason: {}", exp.error().message()) };
     }
@@ -212,6 +249,9 @@ using pressure_slot = slot<details::type_pressure>;
 using temperature_slot = slot<details::type_temperature>;
 using voltage_slot = slot<details::type_voltage>;
 using current_slot = slot<details::type_current>;
+/// \brief record_slot<axis_state> reads axis_state fields straight from the received bytes, see details::type_record
+template <details::concepts::is_record record_t>
+using record_slot = slot<details::type_record<record_t>>;
 using any_slot = std::variant<std::monostate,
                               bool_slot,
                               int_slot,
@@ -240,6 +280,8 @@ using pressure_signal = signal<details::type_pressure>;
 using temperature_signal = signal<details::type_temperature>;
 using voltage_signal = signal<details::type_voltage>;
 using current_signal = signal<details::type_current>;
+template <details::concepts::is_record record_t>
+using record_signal = signal<details::type_record<record_t>>;
 using any_signal = std::variant<std::monostate,
                                 bool_signal,
                                 int_signal,
@@ -304,6 +346,7 @@ struct make_any {
       case _current:
         out.template emplace<ipc_base_t<details::type_current, manager_client_t>>(std::forward<decltype(args)>(args)...);
         return;
+      case _struct:  // the record is not known at runtime
       case unknown:
         return;
     }
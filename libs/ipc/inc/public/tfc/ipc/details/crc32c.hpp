@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define TFC_IPC_CRC32C_X86 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define TFC_IPC_CRC32C_ARM 1
+#endif
+
+namespace tfc::ipc::details::crc32c {
+
+/// \brief CRC-32C (Castagnoli) as used by iSCSI and ext4, reflected polynomial
+static constexpr std::uint32_t polynomial{ 0x82f63b78 };
+
+namespace sw {
+constexpr auto make_table() -> std::array<std::uint32_t, 256> {
+  std::array<std::uint32_t, 256> result{};
+  for (std::uint32_t idx = 0; idx < result.size(); idx++) {
+    std::uint32_t crc{ idx };
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 1U) != 0 ? (crc >> 1U) ^ polynomial : crc >> 1U;
+    }
+    result[idx] = crc;
+  }
+  return result;
+}
+inline constexpr auto table{ make_table() };
+
+constexpr auto update(std::uint32_t crc, std::span<std::byte const> data) -> std::uint32_t {
+  for (auto const byte : data) {
+    crc = table[(crc ^ static_cast<std::uint8_t>(byte)) & 0xffU] ^ (crc >> 8U);
+  }
+  return crc;
+}
+}  // namespace sw
+
+namespace hw {
+#if defined(TFC_IPC_CRC32C_X86)
+// compiled for sse4.2 regardless of -march, only called after checking the cpu supports it
+__attribute__((target("sse4.2"))) inline auto update(std::uint32_t crc, std::span<std::byte const> data) -> std::uint32_t {
+  auto const* iter{ data.data() };
+  auto remaining{ data.size() };
+  std::uint64_t crc64{ crc };
+  for (; remaining >= sizeof(std::uint64_t); remaining -= sizeof(std::uint64_t), iter += sizeof(std::uint64_t)) {
+    std::uint64_t word{};
+    std::memcpy(&word, iter, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  crc = static_cast<std::uint32_t>(crc64);
+  for (; remaining > 0; remaining--, iter++) {
+    crc = _mm_crc32_u8(crc, static_cast<std::uint8_t>(*iter));
+  }
+  return crc;
+}
+inline auto available() noexcept -> bool {
+  static bool const supported{ __builtin_cpu_supports("sse4.2") != 0 };
+  return supported;
+}
+#elif defined(TFC_IPC_CRC32C_ARM)
+inline auto update(std::uint32_t crc, std::span<std::byte const> data) -> std::uint32_t {
+  auto const* iter{ data.data() };
+  auto remaining{ data.size() };
+  for (; remaining >= sizeof(std::uint64_t); remaining -= sizeof(std::uint64_t), iter += sizeof(std::uint64_t)) {
+    std::uint64_t word{};
+    std::memcpy(&word, iter, sizeof(word));
+    crc = __crc32cd(crc, word);
+  }
+  for (; remaining > 0; remaining--, iter++) {
+    crc = __crc32cb(crc, static_cast<std::uint8_t>(*iter));
+  }
+  return crc;
+}
+constexpr auto available() noexcept -> bool {
+  return true;
+}
+#else
+inline auto update(std::uint32_t crc, std::span<std::byte const> data) -> std::uint32_t {
+  return sw::update(crc, data);
+}
+constexpr auto available() noexcept -> bool {
+  return false;
+}
+#endif
+}  // namespace hw
+
+/// \return CRC-32C of data, computed with the cpu crc instructions when available
+inline auto compute(std::span<std::byte const> data) -> std::uint32_t {
+  constexpr std::uint32_t init{ 0xffffffff };
+  if (hw::available()) {
+    return ~hw::update(init, data);
+  }
+  return ~sw::update(init, data);
+}
+
+}  // namespace tfc::ipc::details::crc32c
+
+#undef TFC_IPC_CRC32C_X86
+#undef TFC_IPC_CRC32C_ARM
@@ -1,16 +1,23 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <tfc/dbus/sdbusplus_fwd.hpp>
 #include <tfc/ipc/details/dbus_constants.hpp>
 #include <tfc/ipc/details/dbus_structs.hpp>
 #include <tfc/ipc/enums.hpp>
+#include <tfc/logger.hpp>
 #include <tfc/utils/asio_fwd.hpp>
 
 namespace tfc::ipc_ruler {
@@ -19,6 +26,13 @@ namespace asio = boost::asio;
 
 class ipc_manager_client {
 public:
+  struct registration_stats_t {
+    std::uint64_t batches{};    // bulk registration calls made
+    std::uint64_t endpoints{};  // signals and slots registered, including failed attempts
+    /// time from the first registration until the first time all registrations were answered
+    std::optional<std::chrono::nanoseconds> startup_duration{ std::nullopt };
+  };
+
   explicit ipc_manager_client(asio::io_context& ctx);
 
   /// \param connection non null pointer to a sdbusplus connection
@@ -33,6 +47,8 @@ public:
 
   /**
    * Register a signal with the ipc_manager service running on dbus
+   * Registrations made within the same io_context handler are sent as a single RegisterSignals call once
+   * control returns to the io_context.
    * @param name the name of the signal to be registered
    * @param type  the type enum of the signal to be registered
    * @param handler  the error handling callback function
@@ -51,6 +67,8 @@ public:
 
   /**
    * Register a slot with the ipc_manager service running on dbus
+   * Registrations made within the same io_context handler are sent as a single RegisterSlots call once
+   * control returns to the io_context.
    * @param name the name of the slot to be registered
    * @param type  the type enum of the slot to be registered
    * @param handler  the error handling callback function
@@ -101,6 +119,15 @@ public:
                std::string_view signal_name,
                std::function<void(std::error_code const&)>&& handler) -> void;
 
+  /**
+   * Send a single request over dbus to connect many slots to signals.
+   * @param connections pairs of slot name and the signal name it should be connected to
+   * @param handler a method that receives an error in case there is one
+   * @note Connections that fail validation are skipped by the ipc manager, the same as for connect
+   */
+  auto connect_many(std::vector<std::pair<std::string, std::string>> const& connections,
+                    std::function<void(std::error_code const&)>&& handler) -> void;
+
   /**
    * Send a request over dbus to disconnect a slot from its signal
    * @param slot_name the name of the slot to be disconnected
@@ -129,7 +156,47 @@ public:
   auto register_properties_change_callback(std::function<void(sdbusplus::message_t&)> const& match_change_callback)
       -> std::unique_ptr<sdbusplus::bus::match::match>;
 
+  /**
+   * Async function to get the generation of the latest change in the ipc manager.
+   * To track the ipc manager state read the generation, then the signals and slots snapshot, and from then on
+   * apply the changes delivered to register_changes_callback. Changes are complete records so applying one the
+   * snapshot already contains is harmless.
+   * @param handler called with an error or the generation
+   */
+  auto generation(std::function<void(std::error_code const&, std::uint64_t)>&& handler) -> void;
+
+  /**
+   * Async function to get the changes made after the given generation, used to catch up after a missed change
+   * @param handler called with the changes, oldest first, or an error if they are no longer available in which case
+   * a new snapshot should be read
+   */
+  auto changes_since(std::uint64_t generation,
+                     std::function<void(std::error_code const&, std::vector<change> const&)>&& handler) -> void;
+
+  /**
+   * Register a callback function that is called with the changes made by each call to the ipc manager
+   * @param changes_callback called with the generation of the last change and the changes, oldest first.
+   * If the first change is not the generation following the last one seen some changes were missed, use changes_since.
+   * @return a unique pointer to the match object, the callback is removed when it is destroyed
+   */
+  auto register_changes_callback(std::function<void(std::uint64_t, std::vector<change> const&)> const& changes_callback)
+      -> std::unique_ptr<sdbusplus::bus::match::match>;
+
+  /// \return statistics of the batched registrations made by this client
+  [[nodiscard]] auto registration_stats() const noexcept -> registration_stats_t const& { return registration_stats_; }
+
 private:
+  struct registration {
+    std::string name;
+    std::string description;
+    ipc::details::type_e type;
+    std::function<void(std::error_code const&)> handler;
+  };
+
+  auto queue_registration(std::vector<registration>& queue, registration&& entry) -> void;
+  auto flush_registrations() -> void;
+  auto send_registrations(std::string_view method, std::vector<registration>&& batch) -> void;
+
   auto make_match(const std::string& match_rule, std::function<void(sdbusplus::message_t&)> const& callback)
       -> std::unique_ptr<sdbusplus::bus::match::match>;
   auto match_callback(sdbusplus::message_t& msg) -> void;
@@ -141,6 +208,15 @@ private:
   std::shared_ptr<sdbusplus::asio::connection> connection_;
   std::unique_ptr<sdbusplus::bus::match::match, std::function<void(sdbusplus::bus::match::match*)>> connection_match_;
   std::unordered_map<std::string, std::function<void(std::string_view const)>> slot_callbacks_;
+  std::vector<registration> pending_signals_{};
+  std::vector<registration> pending_slots_{};
+  bool flush_posted_{ false };
+  std::size_t batches_in_flight_{};
+  std::optional<std::chrono::steady_clock::time_point> first_registration_{ std::nullopt };
+  registration_stats_t registration_stats_{};
+  logger::logger logger_{ "ipc-manager-client" };
+  // posted flushes and registration replies hold a weak reference, they do nothing once the client is destroyed
+  std::shared_ptr<ipc_manager_client*> lifetime_{ std::make_shared<ipc_manager_client*>(this) };
 };
 
 }  // namespace tfc::ipc_ruler
@@ -5,12 +5,14 @@
 
 #include <chrono>
 #include <concepts>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <system_error>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/core.h>
 
@@ -77,10 +79,16 @@ struct ipc_manager_client_mock {
   auto register_properties_change_callback(std::function<void(sdbusplus::message_t&)> const&)
       -> std::unique_ptr<sdbusplus::bus::match::match>;
 
+  /// \brief called with a signal_added change for every signal registered through the mock
+  auto register_changes_callback(std::function<void(std::uint64_t, std::vector<change> const&)> const&)
+      -> std::unique_ptr<sdbusplus::bus::match::match>;
+
   std::vector<slot> slots_;
   std::vector<signal> signals_;
   std::vector<std::function<void(sdbusplus::message_t&)>> callbacks_ = {};
   std::unordered_map<std::string, std::function<void(std::string_view const)>> slot_callbacks;
+  std::vector<std::function<void(std::uint64_t, std::vector<change> const&)>> changes_callbacks_ = {};
+  std::uint64_t generation_{};
   std::shared_ptr<sdbusplus::asio::connection> conn_{};
 };
 
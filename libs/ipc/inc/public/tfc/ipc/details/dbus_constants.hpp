@@ -12,10 +12,16 @@ static constexpr std::string_view signals_property{ "Signals" };
 static constexpr std::string_view slots_property{ "Slots" };
 static constexpr std::string_view register_signal{ "RegisterSignal" };
 static constexpr std::string_view register_slot{ "RegisterSlot" };
+static constexpr std::string_view register_signals{ "RegisterSignals" };
+static constexpr std::string_view register_slots{ "RegisterSlots" };
 static constexpr std::string_view disconnect_method{ "Disconnect" };
 static constexpr std::string_view connect_method{ "Connect" };
+static constexpr std::string_view connect_many_method{ "ConnectMany" };
 static constexpr std::string_view connections_property{ "Connections" };
 static constexpr std::string_view connection_change{ "ConnectionChange" };
+static constexpr std::string_view changes_signal{ "Changes" };
+static constexpr std::string_view changes_since_method{ "ChangesSince" };
+static constexpr std::string_view generation_property{ "Generation" };
 
 // service name
 static constexpr auto ipc_ruler_service_name = dbus::const_dbus_name<dbus_name>;
@@ -1,15 +1,23 @@
 #pragma once
 
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string_view>
 #include <utility>
 
 #include <fmt/format.h>
+#include <boost/asio/steady_timer.hpp>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
 
 #include <tfc/dbus/sdbusplus_meta.hpp>
 #include <tfc/dbus/string_maker.hpp>
 #include <tfc/ipc/details/dbus_ipc.hpp>
+#include <tfc/progbase.hpp>
 #include <tfc/stx/concepts.hpp>
 #include <tfc/utils/json_schema.hpp>
 
@@ -27,6 +35,49 @@ static constexpr std::string_view signal_interface{ tfc::dbus::const_dbus_name<s
 
 enum struct ipc_type_e : std::uint8_t { slot, signal };
 
+/// \brief How values of signals and slots are mirrored on D-Bus
+enum struct mirror_e : std::uint8_t {
+  every_value = 0,    // emit a D-Bus signal for every value
+  rate_limited = 1,   // emit at most once per min_interval, the latest value is emitted when the interval elapses
+  property_only = 2,  // only update the Value property, no D-Bus signal messages
+  off = 3,            // do not mirror values at all
+};
+
+struct mirror_policy {
+  mirror_e mode{ mirror_e::every_value };
+  std::chrono::nanoseconds min_interval{ std::chrono::milliseconds(100) };  // used by mirror_e::rate_limited
+
+  /// \return rate limited policy emitting at most hz times per second
+  /// \throws std::invalid_argument if hz is not a positive finite number
+  static auto max_rate(double hz) -> mirror_policy {
+    if (!std::isfinite(hz) || hz <= 0.0) {
+      throw std::invalid_argument{ fmt::format("D-Bus mirror rate must be a positive number of Hz, got {}", hz) };
+    }
+    return { .mode = mirror_e::rate_limited,
+             .min_interval = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(1.0 / hz)) };
+  }
+};
+
+/// \return process wide policy signals and slots start with, from the --dbus-mirror and --dbus-mirror-rate options
+/// \throws std::invalid_argument on an unknown mode or a rate which is not a positive number
+inline auto process_mirror_policy() -> mirror_policy {
+  using std::string_view_literals::operator""sv;
+  auto const mode{ tfc::base::get_dbus_mirror() };
+  if (mode == "every_value"sv) {
+    return { .mode = mirror_e::every_value };
+  }
+  if (mode == "rate_limited"sv) {
+    return mirror_policy::max_rate(tfc::base::get_dbus_mirror_rate());
+  }
+  if (mode == "property_only"sv) {
+    return { .mode = mirror_e::property_only };
+  }
+  if (mode == "off"sv) {
+    return { .mode = mirror_e::off };
+  }
+  throw std::invalid_argument{ fmt::format("Unknown D-Bus mirror mode: {}", mode) };
+}
+
 template <typename slot_value_t, ipc_type_e type>
 class dbus_ipc {
 public:
@@ -34,9 +85,10 @@ public:
   std::string const interface_name{ type == ipc_type_e::signal ? dbus::tags::signal_interface : dbus::tags::slot_interface };
 
   explicit dbus_ipc(std::shared_ptr<sdbusplus::asio::connection> conn, std::string_view key)
-      : interface_{
-          std::make_shared<sdbusplus::asio::dbus_interface>(conn, tfc::dbus::make_dbus_path(key), interface_name)
-        } {}
+      : mirror_{ std::make_shared<mirror_state>(
+            std::make_shared<sdbusplus::asio::dbus_interface>(conn, tfc::dbus::make_dbus_path(key), interface_name),
+            conn->get_io_context()) },
+        policy_{ process_mirror_policy() } {}
 
   dbus_ipc(dbus_ipc const&) = delete;
   dbus_ipc(dbus_ipc&&) noexcept = default;
@@ -44,30 +96,114 @@ public:
   auto operator=(dbus_ipc&&) noexcept -> dbus_ipc& = default;
 
   void initialize() {
-    interface_->register_signal<value_t>(std::string{ dbus::tags::value });
-    interface_->register_property_r<value_t>(std::string{ dbus::tags::value }, sdbusplus::vtable::property_::none,
-                                             [this](const auto&) { return value_; });
-    interface_->register_property(std::string{ dbus::tags::type }, schema);
+    auto& interface{ *mirror_->interface };
+    interface.register_signal<value_t>(std::string{ dbus::tags::value });
+    interface.register_property_r<value_t>(std::string{ dbus::tags::value }, sdbusplus::vtable::property_::none,
+                                           [mirror = std::weak_ptr{ mirror_ }](const auto&) {
+                                             auto const locked{ mirror.lock() };
+                                             return locked ? locked->value : value_t{};
+                                           });
+    interface.register_property(std::string{ dbus::tags::type }, schema);
 
-    interface_->initialize();
+    interface.initialize();
   }
 
   void emit_value(value_t const& value) {
-    value_ = value;
-    auto message = interface_->new_signal(dbus::tags::value.data());
-    message.append(value);
-    message.signal_send();
+    auto& mirror{ *mirror_ };
+    switch (policy_.mode) {
+      case mirror_e::every_value:
+        mirror.value = value;
+        mirror.send_value();
+        return;
+      case mirror_e::rate_limited: {
+        mirror.value = value;
+        if (mirror.pending) {
+          suppressed_++;  // the pending value is replaced by this one
+          return;
+        }
+        auto const now{ std::chrono::steady_clock::now() };
+        if (!mirror.last_emit || now - mirror.last_emit.value() >= policy_.min_interval) {
+          mirror.last_emit = now;
+          mirror.send_value();
+          return;
+        }
+        mirror.pending = true;
+        mirror.rate_timer.expires_at(mirror.last_emit.value() + policy_.min_interval);
+        // the handler outlives a move of this object, it only holds on to the shared state
+        mirror.rate_timer.async_wait([weak_mirror = std::weak_ptr{ mirror_ }](std::error_code const& err) {
+          auto const locked{ weak_mirror.lock() };
+          if (err || !locked) {
+            return;
+          }
+          locked->pending = false;
+          locked->last_emit = std::chrono::steady_clock::now();
+          locked->send_value();
+        });
+        return;
+      }
+      case mirror_e::property_only:
+        mirror.value = value;
+        suppressed_++;
+        return;
+      case mirror_e::off:
+        suppressed_++;
+        return;
+    }
+  }
+
+  /// \brief change how values are mirrored, defaults to process_mirror_policy
+  void set_mirror_policy(mirror_policy policy) {
+    policy_ = policy;
+    auto& mirror{ *mirror_ };
+    if (mirror.pending && policy_.mode != mirror_e::rate_limited) {
+      mirror.rate_timer.cancel();
+      mirror.pending = false;
+      if (policy_.mode == mirror_e::every_value) {
+        mirror.send_value();
+      } else {
+        suppressed_++;
+      }
+    }
   }
 
+  [[nodiscard]] auto policy() const noexcept -> mirror_policy const& { return policy_; }
+
+  /// \return number of D-Bus signal messages emitted, including the pending value emitted after a move
+  [[nodiscard]] auto emitted() const noexcept -> std::uint64_t { return mirror_->emitted; }
+
+  /// \return number of values which were not emitted as D-Bus signal messages because of the mirror policy
+  [[nodiscard]] auto suppressed() const noexcept -> std::uint64_t { return suppressed_; }
+
   void on_set(tfc::stx::invocable<value_t&&> auto&& callback) {
-    interface_->register_method(
+    mirror_->interface->register_method(
         std::string{ dbus::tags::tinker },
         [callb = std::forward<decltype(callback)>(callback)](value_t const& set_value) { callb(value_t{ set_value }); });
   }
 
 private:
-  std::shared_ptr<sdbusplus::asio::dbus_interface> interface_{};
-  value_t value_{};
+  /// \brief what the D-Bus callbacks and the rate timer use, shared so they stay valid when this object is moved
+  struct mirror_state {
+    mirror_state(std::shared_ptr<sdbusplus::asio::dbus_interface> dbus_interface, boost::asio::io_context& ctx)
+        : interface{ std::move(dbus_interface) }, rate_timer{ ctx } {}
+
+    void send_value() {
+      auto message = interface->new_signal(dbus::tags::value.data());
+      message.append(value);
+      message.signal_send();
+      emitted++;
+    }
+
+    std::shared_ptr<sdbusplus::asio::dbus_interface> interface;
+    boost::asio::steady_timer rate_timer;
+    std::optional<std::chrono::steady_clock::time_point> last_emit{ std::nullopt };
+    bool pending{ false };
+    std::uint64_t emitted{};
+    value_t value{};
+  };
+
+  std::shared_ptr<mirror_state> mirror_;
+  mirror_policy policy_;
+  std::uint64_t suppressed_{};
   std::string const schema{ tfc::json::write_json_schema<value_t>().value() };
 };
 
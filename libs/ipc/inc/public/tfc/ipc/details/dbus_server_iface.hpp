@@ -2,13 +2,23 @@
 
 // ipc-ruler.cpp - Dbus API service maintaining a list of signals/slots and which signal
 // is connected to which slot
+#include <chrono>
+#include <deque>
 #include <filesystem>
 #include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <glaze/json.hpp>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
@@ -39,8 +49,19 @@ inline std::string config_file_name_populate_dir() {
   return file.string();
 }
 
+namespace details {
+/// \brief transparent hash, lets the name indexes be queried with a string_view without allocating
+struct string_hash {
+  using is_transparent = void;
+  auto operator()(std::string_view str) const noexcept -> std::size_t { return std::hash<std::string_view>{}(str); }
+};
+}  // namespace details
+
 /**
  * A class exposing methods for managing signals and slots
+ * The signals and slots are held in memory, which is authoritative while the process runs. The database is only read on
+ * construction and written behind the in memory state by persist(), changes are batched into a single transaction.
+ * Serialized json snapshots of the lists are cached and invalidated on change.
  */
 class ipc_manager {
 public:
@@ -71,8 +92,16 @@ public:
               time_point_t LONG INTEGER,
               description TEXT);
              )";
+    load();
   }
 
+  ipc_manager(ipc_manager const&) = delete;
+  auto operator=(ipc_manager const&) -> ipc_manager& = delete;
+  ipc_manager(ipc_manager&&) = delete;
+  auto operator=(ipc_manager&&) -> ipc_manager& = delete;
+
+  ~ipc_manager() { persist(); }
+
   auto set_callback(std::function<void(slot_name, signal_name)> on_connect_cb) -> void {
     on_connect_cb_ = std::move(on_connect_cb);
   }
@@ -82,26 +111,21 @@ public:
     logger_.trace("register_signal called name: {}, type: {}", name, enum_name(type));
     auto timestamp_now = std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now());
 
-    try {
-      // Check if signal exists
-      int count = 0;
-      db_ << "SELECT count(*) FROM signals WHERE name = ?;" << std::string(name) >> count;
-      if (count != 0) {
-        // update the signal
-        db_ << fmt::format(
-            "UPDATE signals SET last_registered = {}, description = '{}', type = {}, created_by = '{}'  WHERE name = '{}';",
-            timestamp_now.time_since_epoch().count(), description, static_cast<std::uint8_t>(type), sender, name);
-      } else {
-        // Insert the signal
-        db_ << fmt::format(
-            "INSERT INTO signals (name, type, created_by, created_at, last_registered, description) VALUES "
-            "('{}',{},'{}',{},{},'{}');",
-            name, static_cast<std::uint8_t>(type), sender, timestamp_now.time_since_epoch().count(),
-            timestamp_now.time_since_epoch().count(), description);
-      }
-    } catch (const std::exception& e) {
-      logger_.error(e.what());
+    if (auto* existing{ find(signals_, name) }) {
+      existing->value.last_registered = timestamp_now;
+      existing->value.description = description;
+      existing->value.type = type;
+      existing->value.created_by = sender;
+      mark_dirty(signals_, *existing);
+      record_change(change_e::signal_updated, existing->value);
+    } else {
+      auto& inserted{ insert(signals_, signal{ std::string{ name }, type, std::string{ sender }, timestamp_now,
+                                               timestamp_now, std::string{ description } }) };
+      record_change(change_e::signal_added, inserted.value);
     }
+    signals_json_.reset();
+    // slots loaded from the database may already be connected to this signal, which get_all_connections omitted so far
+    connections_json_.reset();
   }
 
   auto register_slot(std::string_view sender, const std::string_view name, const std::string_view description, type_e type)
@@ -110,31 +134,24 @@ public:
     auto timestamp_now = std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now());
     auto timestamp_never = std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>{};
 
+    std::string connected_to{};
+    if (auto* existing{ find(slots_, name) }) {
+      existing->value.last_registered = timestamp_now;
+      existing->value.description = description;
+      existing->value.type = type;
+      existing->value.created_by = sender;
+      connected_to = existing->value.connected_to;
+      mark_dirty(slots_, *existing);
+      record_change(change_e::slot_updated, existing->value);
+    } else {
+      auto& inserted{ insert(slots_, slot{ std::string{ name }, type, std::string{ sender }, timestamp_now, timestamp_now,
+                                           timestamp_never, "", "", std::string{ description } }) };
+      record_change(change_e::slot_added, inserted.value);
+    }
+    slots_json_.reset();
+
     // Call the connected callback to get the slot connected to its signal if it has one.
     try {
-      // Check if signal exists
-
-      std::string connected_to = "";
-      bool found = false;
-      db_ << "SELECT connected_to FROM slots WHERE name = ?;" << std::string(name) >>
-          [&connected_to, &found](const std::string& result) {
-            connected_to = result;
-            found = true;
-          };
-      if (found) {
-        // update the signal
-        db_ << fmt::format(
-            "UPDATE slots SET last_registered = {}, description = '{}', type = {}, created_by = '{}'  WHERE name = '{}';",
-            timestamp_now.time_since_epoch().count(), description, static_cast<std::uint8_t>(type), sender, name);
-      } else {
-        // Insert the signal
-        db_ << fmt::format(
-            "INSERT INTO slots (name, type, created_by, created_at, last_registered, last_modified, description) VALUES "
-            "('{}',{},'{}',{},{},{},'{}');",
-            name, static_cast<std::uint8_t>(type), sender, timestamp_now.time_since_epoch().count(),
-            timestamp_now.time_since_epoch().count(), timestamp_never.time_since_epoch().count(), description);
-      }
-
       on_connect_cb_(name, connected_to);
     } catch (const std::exception& e) {
       logger_.error(e.what());
@@ -144,75 +161,73 @@ public:
   auto get_all_signals() -> std::vector<signal> {
     logger_.trace("get_all_signals called");
     std::vector<signal> ret;
-    db_ << "SELECT name, type, last_registered, description, created_at, created_by FROM signals" >>
-        [&ret](const std::string& name, const int type, const std::uint64_t last_registered, const std::string& description,
-               const std::uint64_t created_at, const std::string& created_by) {
-          using std::chrono::milliseconds;
-          const auto last_reg = time_point_t(milliseconds(last_registered));
-          const auto cre_at = time_point_t(milliseconds(created_at));
-          ret.emplace_back(signal{ name, static_cast<type_e>(type), created_by, cre_at, last_reg, description });
-        };
+    ret.reserve(signals_.rows.size());
+    for (auto const& row : signals_.rows) {
+      ret.emplace_back(row.value);
+    }
     return ret;
   }
 
   auto get_all_slots() -> std::vector<slot> {
     logger_.trace("get_all_slots called");
     std::vector<slot> ret;
-    db_ << "SELECT name, type, last_registered, description, created_at, created_by, last_modified, modified_by, "
-           "connected_to FROM slots" >>
-        [&ret](const std::string& name, const int type, const std::uint64_t last_registered, const std::string& description,
-               const std::uint64_t created_at, const std::string& created_by, const std::uint64_t last_modified,
-               const std::string& modified_by, const std::string& connected_to) {
-          using std::chrono::milliseconds;
-          const auto last_reg = time_point_t(milliseconds(last_registered));
-          const auto cre_at = time_point_t(milliseconds(created_at));
-          const auto last_mod = time_point_t(milliseconds(last_modified));
-          ret.emplace_back(slot{ name, static_cast<type_e>(type), created_by, cre_at, last_reg, last_mod, modified_by,
-                                 connected_to, description });
-        };
+    ret.reserve(slots_.rows.size());
+    for (auto const& row : slots_.rows) {
+      ret.emplace_back(row.value);
+    }
     return ret;
   }
 
   auto get_all_connections() -> std::map<std::string, std::vector<std::string>> {
     std::map<std::string, std::vector<std::string>> connections;
-    db_ << "SELECT signals.name, slots.name FROM signals JOIN slots ON signals.name = slots.connected_to;" >>
-        [&connections](const std::string& signal_name, const std::string& slot_name) {
-          connections[signal_name].emplace_back(slot_name);
-        };
+    for (auto const& [signal_name, slot_names] : slots_by_signal_) {
+      // a slot loaded from the database may be connected to a signal which has not been registered
+      if (!slot_names.empty() && signals_.index.contains(signal_name)) {
+        connections.emplace(signal_name, slot_names);
+      }
+    }
     return connections;
   }
 
+  /// \return cached json array of all signals, serialized again only after a change
+  auto signals_json() -> std::string const& {
+    return cached_json(signals_json_, [this] { return get_all_signals(); }, "signals");
+  }
+
+  /// \return cached json array of all slots, serialized again only after a change
+  auto slots_json() -> std::string const& {
+    return cached_json(slots_json_, [this] { return get_all_slots(); }, "slots");
+  }
+
+  /// \return cached json object of signal names to connected slot names, serialized again only after a change
+  auto connections_json() -> std::string const& {
+    return cached_json(connections_json_, [this] { return get_all_connections(); }, "connections");
+  }
+
   auto connect(const std::string_view slot_name, const std::string_view signal_name) -> void {
     try {
       logger_.trace("connect called, slot: {}, signal: {}", slot_name, signal_name);
-      int slot_count = 0;
-      db_ << "SELECT count(*) FROM slots WHERE name = ?;" << std::string(slot_name) >> slot_count;
-      if (slot_count == 0) {
+      auto* slot_row{ find(slots_, slot_name) };
+      if (slot_row == nullptr) {
         std::string const err_msg = fmt::format("Slot ({}) does not exist", slot_name);
         logger_.warn(err_msg);
         throw dbus_error(err_msg);
       }
-      int signal_count = 0;
-      db_ << "SELECT count(*) FROM signals WHERE name = ?;" << std::string(signal_name) >> signal_count;
-      if (signal_count == 0) {
+      auto const* signal_row{ find(signals_, signal_name) };
+      if (signal_row == nullptr) {
         std::string const err_msg = fmt::format("Signal ({}) does not exist", signal_name);
         logger_.warn(err_msg);
         throw dbus_error(err_msg);
       }
-
-      int signal_type = 0;
-      db_ << fmt::format("SELECT type FROM signals WHERE name = '{}' LIMIT 1;", signal_name) >>
-          [&signal_type](const int result) { signal_type = result; };
-      int slot_type = 0;
-      db_ << fmt::format("SELECT type FROM slots WHERE name = '{}' LIMIT 1;", slot_name) >>
-          [&slot_type](const int result) { slot_type = result; };
-      if (signal_type != slot_type) {
-        std::string const err_msg = fmt::format("Signal: {} and slot: {}, types dont match", signal_type, slot_type);
+      if (signal_row->value.type != slot_row->value.type) {
+        std::string const err_msg =
+            fmt::format("Signal: {} and slot: {}, types dont match", std::to_underlying(signal_row->value.type),
+                        std::to_underlying(slot_row->value.type));
         logger_.warn(err_msg);
         throw dbus_error(err_msg);
       }
 
-      db_ << fmt::format("UPDATE slots SET connected_to = '{}' WHERE name = '{}';", signal_name, slot_name);
+      set_connected_to(*slot_row, signal_name);
       on_connect_cb_(slot_name, signal_name);
     } catch (const std::exception& e) {
       logger_.warn(e.what());
@@ -222,28 +237,258 @@ public:
   auto disconnect(const std::string_view slot_name) -> void {
     logger_.trace("disconnect called, slot: {}", slot_name);
     try {
-      int slot_count = 0;
-      db_ << "SELECT count(*) FROM slots WHERE name = ?;" << std::string(slot_name) >> slot_count;
-      if (slot_count == 0) {
+      auto* slot_row{ find(slots_, slot_name) };
+      if (slot_row == nullptr) {
         throw std::runtime_error("Slot does not exist");
       }
-      db_ << fmt::format("UPDATE slots SET connected_to = '' WHERE name = '{}';", slot_name);
+      set_connected_to(*slot_row, "");
       on_connect_cb_(slot_name, "");
     } catch (const std::exception& e) {
       logger_.warn(e.what());
     }
   }
 
+  /// \brief write all changes made since the last call to the database in a single transaction
+  /// On failure the changes are kept and retried on the next call.
+  auto persist() -> void {
+    if (pending_writes() == 0) {
+      return;
+    }
+    logger_.trace("persisting {} signals and {} slots", signals_.dirty.size(), slots_.dirty.size());
+    try {
+      db_ << "BEGIN;";
+      try {
+        persist_signals();
+        persist_slots();
+      } catch (...) {
+        db_ << "ROLLBACK;";
+        throw;
+      }
+      db_ << "COMMIT;";
+    } catch (const std::exception& e) {
+      logger_.error("Failed to persist ipc-ruler state: {}", e.what());
+      return;
+    }
+    signals_.mark_clean();
+    slots_.mark_clean();
+  }
+
+  /// \return generation of the latest change, a snapshot read now contains every change up to and including it
+  [[nodiscard]] auto generation() const noexcept -> std::uint64_t { return generation_; }
+
+  /// \return changes made after the given generation, oldest first
+  /// std::nullopt if some of those changes are no longer kept or the generation is unknown to this run of ipc-ruler.
+  /// The caller should then read a new snapshot of the signals and slots.
+  [[nodiscard]] auto changes_since(std::uint64_t since) const -> std::optional<std::vector<change>> {
+    if (since > generation_) {
+      return std::nullopt;
+    }
+    if (since == generation_) {
+      return std::vector<change>{};
+    }
+    if (changes_.empty() || changes_.front().generation > since + 1) {
+      return std::nullopt;
+    }
+    auto const first{ changes_.begin() + static_cast<std::ptrdiff_t>(since + 1 - changes_.front().generation) };
+    return std::vector<change>{ first, changes_.end() };
+  }
+
+  /// \brief number of changes kept for changes_since
+  static constexpr std::size_t max_changes{ 4096 };
+
+  /// \return number of signals and slots changed since the last persist
+  [[nodiscard]] auto pending_writes() const noexcept -> std::size_t { return signals_.dirty.size() + slots_.dirty.size(); }
+
 private:
+  enum struct row_state_e : std::uint8_t {
+    clean,     // equal to the database
+    updated,   // exists in the database, value has changed
+    inserted,  // not yet in the database
+  };
+
+  template <typename value_t>
+  struct row {
+    value_t value;
+    row_state_e state{ row_state_e::clean };
+  };
+
+  /// \brief rows kept in registration order, the same order the database returns them in
+  template <typename value_t>
+  struct table {
+    std::vector<row<value_t>> rows{};
+    std::unordered_map<std::string, std::size_t, details::string_hash, std::equal_to<>> index{};
+    std::vector<std::size_t> dirty{};  // rows changed since the last persist
+
+    auto mark_clean() -> void {
+      for (auto idx : dirty) {
+        rows[idx].state = row_state_e::clean;
+      }
+      dirty.clear();
+    }
+  };
+
+  template <typename value_t>
+  static auto find(table<value_t>& tbl, std::string_view name) -> row<value_t>* {
+    if (auto const itr{ tbl.index.find(name) }; itr != tbl.index.end()) {
+      return &tbl.rows[itr->second];
+    }
+    return nullptr;
+  }
+
+  template <typename value_t>
+  static auto insert(table<value_t>& tbl, value_t&& value, row_state_e state = row_state_e::inserted) -> row<value_t>& {
+    tbl.index.emplace(value.name, tbl.rows.size());
+    if (state != row_state_e::clean) {
+      tbl.dirty.emplace_back(tbl.rows.size());
+    }
+    return tbl.rows.emplace_back(row<value_t>{ std::move(value), state });
+  }
+
+  template <typename value_t>
+  static auto mark_dirty(table<value_t>& tbl, row<value_t>& changed) -> void {
+    if (changed.state != row_state_e::clean) {
+      return;  // already queued
+    }
+    changed.state = row_state_e::updated;
+    tbl.dirty.emplace_back(static_cast<std::size_t>(&changed - tbl.rows.data()));
+  }
+
+  auto set_connected_to(row<slot>& slot_row, std::string_view signal_name) -> void {
+    auto& connected_to{ slot_row.value.connected_to };
+    if (!connected_to.empty()) {
+      if (auto itr{ slots_by_signal_.find(connected_to) }; itr != slots_by_signal_.end()) {
+        std::erase(itr->second, slot_row.value.name);
+      }
+    }
+    connected_to = signal_name;
+    if (!connected_to.empty()) {
+      slots_by_signal_[connected_to].emplace_back(slot_row.value.name);
+    }
+    mark_dirty(slots_, slot_row);
+    record_change(connected_to.empty() ? change_e::disconnected : change_e::connected, slot_row.value);
+    slots_json_.reset();
+    connections_json_.reset();
+  }
+
+  auto record_change(change_e kind, signal const& value) -> void {
+    push_change(change{ .generation = ++generation_, .kind = kind, .signal_info = value, .slot_info = std::nullopt });
+  }
+
+  auto record_change(change_e kind, slot const& value) -> void {
+    push_change(change{ .generation = ++generation_, .kind = kind, .signal_info = std::nullopt, .slot_info = value });
+  }
+
+  auto push_change(change&& item) -> void {
+    if (changes_.size() == max_changes) {
+      changes_.pop_front();
+    }
+    changes_.emplace_back(std::move(item));
+  }
+
+  auto cached_json(std::optional<std::string>& cache, auto&& producer, std::string_view what) -> std::string const& {
+    if (!cache) {
+      auto const write{ glz::write_json(producer()) };
+      if (!write) {
+        fmt::println(stderr, "Failed to write {} to json: {}", what, format_error(write.error()));
+        throw dbus_error(fmt::format("Failed to write {} to json", what));
+      }
+      cache = write.value();
+    }
+    return cache.value();
+  }
+
+  auto load() -> void {
+    using std::chrono::milliseconds;
+    db_ << "SELECT name, type, last_registered, description, created_at, created_by FROM signals ORDER BY rowid;" >>
+        [this](const std::string& name, const int type, const std::uint64_t last_registered, const std::string& description,
+               const std::uint64_t created_at, const std::string& created_by) {
+          const auto last_reg = time_point_t(milliseconds(last_registered));
+          const auto cre_at = time_point_t(milliseconds(created_at));
+          insert(signals_, signal{ name, static_cast<type_e>(type), created_by, cre_at, last_reg, description },
+                 row_state_e::clean);
+        };
+    db_ << "SELECT name, type, last_registered, description, created_at, created_by, last_modified, modified_by, "
+           "connected_to FROM slots ORDER BY rowid;" >>
+        [this](const std::string& name, const int type, const std::uint64_t last_registered, const std::string& description,
+               const std::uint64_t created_at, const std::string& created_by, const std::uint64_t last_modified,
+               const std::string& modified_by, const std::string& connected_to) {
+          const auto last_reg = time_point_t(milliseconds(last_registered));
+          const auto cre_at = time_point_t(milliseconds(created_at));
+          const auto last_mod = time_point_t(milliseconds(last_modified));
+          insert(slots_,
+                 slot{ name, static_cast<type_e>(type), created_by, cre_at, last_reg, last_mod, modified_by, connected_to,
+                       description },
+                 row_state_e::clean);
+          if (!connected_to.empty()) {
+            slots_by_signal_[connected_to].emplace_back(name);
+          }
+        };
+  }
+
+  auto persist_signals() -> void {
+    auto update_row{ db_ << "UPDATE signals SET type = ?, created_by = ?, last_registered = ?, description = ? "
+                            "WHERE name = ?;" };
+    auto insert_row{ db_ << "INSERT INTO signals (name, type, created_by, created_at, last_registered, description) "
+                            "VALUES (?, ?, ?, ?, ?, ?);" };
+    for (auto idx : signals_.dirty) {
+      auto const& [value, state]{ signals_.rows[idx] };
+      if (state == row_state_e::inserted) {
+        insert_row << value.name << static_cast<int>(value.type) << value.created_by
+               << value.created_at.time_since_epoch().count() << value.last_registered.time_since_epoch().count()
+               << value.description;
+        insert_row++;
+      } else {
+        update_row << static_cast<int>(value.type) << value.created_by << value.last_registered.time_since_epoch().count()
+               << value.description << value.name;
+        update_row++;
+      }
+    }
+  }
+
+  auto persist_slots() -> void {
+    auto update_row{ db_ << "UPDATE slots SET type = ?, created_by = ?, last_registered = ?, description = ?, "
+                            "connected_to = ? WHERE name = ?;" };
+    auto insert_row{ db_ << "INSERT INTO slots (name, type, created_by, created_at, last_registered, last_modified, "
+                            "modified_by, connected_to, description) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);" };
+    for (auto idx : slots_.dirty) {
+      auto const& [value, state]{ slots_.rows[idx] };
+      if (state == row_state_e::inserted) {
+        insert_row << value.name << static_cast<int>(value.type) << value.created_by
+               << value.created_at.time_since_epoch().count() << value.last_registered.time_since_epoch().count()
+               << value.last_modified.time_since_epoch().count() << value.modified_by << value.connected_to
+               << value.description;
+        insert_row++;
+      } else {
+        update_row << static_cast<int>(value.type) << value.created_by << value.last_registered.time_since_epoch().count()
+               << value.description << value.connected_to << value.name;
+        update_row++;
+      }
+    }
+  }
+
   logger::logger logger_{ "ipc-manager" };
   sqlite::database db_;
   std::function<void(std::string_view, std::string_view)> on_connect_cb_;
+  table<signal> signals_{};
+  table<slot> slots_{};
+  // reverse index, signal name to the names of the slots connected to it
+  std::unordered_map<std::string, std::vector<std::string>, details::string_hash, std::equal_to<>> slots_by_signal_{};
+  std::optional<std::string> signals_json_{};
+  std::optional<std::string> slots_json_{};
+  std::optional<std::string> connections_json_{};
+  // seeded from the wall clock so generations handed out by a previous run of ipc-ruler are never reused
+  std::uint64_t generation_{ static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count()) };
+  std::deque<change> changes_{};
 };
 
 class ipc_manager_server {
 public:
+  /// \brief entry of the bulk registration methods, name, description and type
+  using registration_t = std::tuple<std::string, std::string, std::uint8_t>;
+
   explicit ipc_manager_server(boost::asio::io_context& ctx, std::unique_ptr<ipc_manager>&& ipc_manager)
-      : ipc_manager_{ std::move(ipc_manager) } {
+      : persist_timer_{ ctx }, published_generation_{ ipc_manager->generation() }, ipc_manager_{ std::move(ipc_manager) } {
     connection_ = std::make_shared<sdbusplus::asio::connection>(ctx, tfc::dbus::sd_bus_open_system());
     object_server_ = std::make_unique<sdbusplus::asio::object_server>(connection_);
     connection_->request_name(consts::ipc_ruler_service_name.data());
@@ -258,12 +503,16 @@ public:
     dbus_interface_->register_method(std::string(consts::connect_method),
                                      [&](const std::string& slot_name, const std::string& signal_name) {
                                        ipc_manager_->connect(slot_name, signal_name);
+                                       schedule_persist();
+                                       publish_changes();
                                        dbus_interface_->signal_property(std::string(consts::slots_property));
                                        dbus_interface_->signal_property(std::string(consts::connections_property));
                                      });
 
     dbus_interface_->register_method(std::string(consts::disconnect_method), [&](const std::string& slot_name) {
       ipc_manager_->disconnect(slot_name);
+      schedule_persist();
+      publish_changes();
       dbus_interface_->signal_property(std::string(consts::slots_property));
       dbus_interface_->signal_property(std::string(consts::connections_property));
     });
@@ -272,50 +521,128 @@ public:
         std::string(consts::register_signal),
         [&](const sdbusplus::message_t& msg, const std::string& name, const std::string& description, uint8_t type) {
           ipc_manager_->register_signal(msg.get_sender(), name, description, static_cast<type_e>(type));
+          schedule_persist();
+          publish_changes();
           dbus_interface_->signal_property(std::string(consts::signals_property));
         });
     dbus_interface_->register_method(
         std::string(consts::register_slot),
         [&](const sdbusplus::message_t& msg, const std::string& name, const std::string& description, uint8_t type) {
           ipc_manager_->register_slot(msg.get_sender(), name, description, static_cast<type_e>(type));
+          schedule_persist();
+          publish_changes();
           dbus_interface_->signal_property(std::string(consts::slots_property));
         });
 
-    dbus_interface_->register_property_r<std::string>(
-        std::string(consts::signals_property), sdbusplus::vtable::property_::emits_change, [&](const auto&) {
-          auto const write{ glz::write_json(ipc_manager_->get_all_signals()) };
-          if (!write) {
-            fmt::println(stderr, "Failed to write signals to json: {}", format_error(write.error()));
-            throw dbus_error("Failed to write signals to json");
-          }
-          return write.value();
-        });
+    // Bulk variants of the methods above, each entry is handled as the single call would be and the
+    // properties are signalled once per call instead of once per entry
+    dbus_interface_->register_method(std::string(consts::register_signals),
+                                     [&](const sdbusplus::message_t& msg, const std::vector<registration_t>& signals) {
+                                       for (auto const& [name, description, type] : signals) {
+                                         ipc_manager_->register_signal(msg.get_sender(), name, description,
+                                                                       static_cast<type_e>(type));
+                                       }
+                                       schedule_persist();
+                                       publish_changes();
+                                       dbus_interface_->signal_property(std::string(consts::signals_property));
+                                     });
+    dbus_interface_->register_method(std::string(consts::register_slots),
+                                     [&](const sdbusplus::message_t& msg, const std::vector<registration_t>& slots) {
+                                       for (auto const& [name, description, type] : slots) {
+                                         ipc_manager_->register_slot(msg.get_sender(), name, description,
+                                                                     static_cast<type_e>(type));
+                                       }
+                                       schedule_persist();
+                                       publish_changes();
+                                       dbus_interface_->signal_property(std::string(consts::slots_property));
+                                     });
+    dbus_interface_->register_method(std::string(consts::connect_many_method),
+                                     [&](const std::vector<std::tuple<std::string, std::string>>& connections) {
+                                       for (auto const& [slot_name, signal_name] : connections) {
+                                         ipc_manager_->connect(slot_name, signal_name);
+                                       }
+                                       schedule_persist();
+                                       publish_changes();
+                                       dbus_interface_->signal_property(std::string(consts::slots_property));
+                                       dbus_interface_->signal_property(std::string(consts::connections_property));
+                                     });
 
-    dbus_interface_->register_property_r<std::string>(
-        std::string(consts::slots_property), sdbusplus::vtable::property_::emits_change, [&](const auto&) {
-          auto const write{ glz::write_json(ipc_manager_->get_all_slots()) };
-          if (!write) {
-            fmt::println(stderr, "Failed to write slots to json: {}", format_error(write.error()));
-            throw dbus_error("Failed to write slots to json");
-          }
-          return write.value();
-        });
+    dbus_interface_->register_method(std::string(consts::changes_since_method), [&](std::uint64_t generation) {
+      auto const changes{ ipc_manager_->changes_since(generation) };
+      if (!changes) {
+        throw dbus_error(fmt::format("Changes since generation {} are not available, read a new snapshot", generation));
+      }
+      auto const write{ glz::write_json(changes.value()) };
+      if (!write) {
+        throw dbus_error("Failed to write changes to json");
+      }
+      return write.value();
+    });
 
-    dbus_interface_->register_property_r<std::string>(
-        std::string(consts::connections_property), sdbusplus::vtable::property_::emits_change, [&](const auto&) {
-          auto const write{ glz::write_json(ipc_manager_->get_all_connections()) };
-          if (!write) {
-            fmt::println(stderr, "Failed to write connections to json: {}", format_error(write.error()));
-            throw dbus_error("Failed to write connections to json");
-          }
-          return write.value();
-        });
+    dbus_interface_->register_property_r<std::string>(std::string(consts::signals_property),
+                                                      sdbusplus::vtable::property_::emits_change,
+                                                      [&](const auto&) { return ipc_manager_->signals_json(); });
+
+    dbus_interface_->register_property_r<std::string>(std::string(consts::slots_property),
+                                                      sdbusplus::vtable::property_::emits_change,
+                                                      [&](const auto&) { return ipc_manager_->slots_json(); });
+
+    dbus_interface_->register_property_r<std::string>(std::string(consts::connections_property),
+                                                      sdbusplus::vtable::property_::emits_change,
+                                                      [&](const auto&) { return ipc_manager_->connections_json(); });
+
+    dbus_interface_->register_property_r<std::uint64_t>(std::string(consts::generation_property),
+                                                        sdbusplus::vtable::property_::none,
+                                                        [&](const auto&) { return ipc_manager_->generation(); });
 
     dbus_interface_->register_signal<std::tuple<std::string, std::string>>("");
+    dbus_interface_->register_signal<std::tuple<std::uint64_t, std::string>>(std::string(consts::changes_signal));
     dbus_interface_->initialize();
   }
 
+  /// \brief how long changes are collected before they are written to the database
+  static constexpr auto persist_delay{ std::chrono::milliseconds(100) };
+
 private:
+  /// \brief write the managers changes behind the dbus replies, a registration storm at startup
+  /// is persisted in one transaction per persist_delay instead of one round trip per method call
+  void schedule_persist() {
+    if (persist_scheduled_) {
+      return;
+    }
+    persist_scheduled_ = true;
+    persist_timer_.expires_after(persist_delay);
+    persist_timer_.async_wait([this](std::error_code const& err) {
+      if (err) {
+        return;  // the server is being destroyed, the manager persists on destruction
+      }
+      persist_scheduled_ = false;
+      ipc_manager_->persist();
+    });
+  }
+
+  /// \brief emit the changes made by the current method call as a single Changes signal
+  /// The signal carries the generation of the last change and a json array of the changes.
+  void publish_changes() {
+    auto const changes{ ipc_manager_->changes_since(published_generation_) };
+    published_generation_ = ipc_manager_->generation();
+    if (!changes || changes->empty()) {
+      // a call producing more changes than are kept, clients will notice the gap in generations
+      return;
+    }
+    auto const write{ glz::write_json(changes.value()) };
+    if (!write) {
+      fmt::println(stderr, "Failed to write changes to json: {}", format_error(write.error()));
+      return;
+    }
+    auto message = dbus_interface_->new_signal(consts::changes_signal.data());
+    message.append(std::tuple<std::uint64_t, std::string>(published_generation_, write.value()));
+    message.signal_send();
+  }
+
+  boost::asio::steady_timer persist_timer_;
+  bool persist_scheduled_{ false };
+  std::uint64_t published_generation_;
   std::shared_ptr<sdbusplus::asio::connection> connection_;
   std::unique_ptr<sdbusplus::asio::dbus_interface> dbus_interface_;
   std::unique_ptr<sdbusplus::asio::object_server> object_server_;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+#include <optional>
 #include <string>
 
 #include <tfc/ipc/enums.hpp>
@@ -30,4 +32,24 @@ struct slot {
   std::string description;
 };
 
+enum struct change_e : std::uint8_t {
+  unknown = 0,
+  signal_added,
+  signal_updated,  // re-registration of an existing signal
+  slot_added,
+  slot_updated,  // re-registration of an existing slot
+  connected,
+  disconnected,
+};
+
+/// \brief incremental change of the ipc-ruler state
+/// Each change carries the complete record it affects so it can be applied as an upsert,
+/// applying a change twice or on top of a snapshot that already contains it is harmless.
+struct change {
+  std::uint64_t generation{};  // strictly increasing per change while ipc-ruler runs
+  change_e kind{ change_e::unknown };
+  std::optional<signal> signal_info{ std::nullopt };  // set for signal_added and signal_updated
+  std::optional<slot> slot_info{ std::nullopt };      // set for slot changes, connected and disconnected
+};
+
 }  // namespace tfc::ipc_ruler
@@ -37,3 +37,32 @@ struct glz::meta<tfc::ipc_ruler::slot> {
   // clang-format on
   static constexpr std::string_view name{ "slot" };
 };
+
+template <>
+struct glz::meta<tfc::ipc_ruler::change_e> {
+  using enum tfc::ipc_ruler::change_e;
+  // clang-format off
+  static constexpr auto value{ glz::enumerate(
+      "unknown", unknown, "Unspecified change",
+      "signal_added", signal_added, "Signal registered for the first time",
+      "signal_updated", signal_updated, "Signal registered again",
+      "slot_added", slot_added, "Slot registered for the first time",
+      "slot_updated", slot_updated, "Slot registered again",
+      "connected", connected, "Slot connected to a signal",
+      "disconnected", disconnected, "Slot disconnected from its signal") };
+  // clang-format on
+  static constexpr std::string_view name{ "change_e" };
+};
+
+template <>
+struct glz::meta<tfc::ipc_ruler::change> {
+  using change = tfc::ipc_ruler::change;
+  // clang-format off
+  static constexpr auto value{ glz::object(
+      "generation", &change::generation,
+      "kind", &change::kind,
+      "signal", &change::signal_info,
+      "slot", &change::slot_info) };
+  // clang-format on
+  static constexpr std::string_view name{ "change" };
+};
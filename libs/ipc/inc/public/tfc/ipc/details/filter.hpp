@@ -1,6 +1,12 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <concepts>
 #include <expected>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
 #include <vector>
 
 #include <boost/asio/async_result.hpp>
@@ -14,7 +20,9 @@
 #include <tfc/confman.hpp>
 #include <tfc/confman/observable.hpp>
 #include <tfc/dbus/sdbusplus_fwd.hpp>
+#include <tfc/ipc/details/rolling_window.hpp>
 #include <tfc/ipc/details/type_description.hpp>
+#include <tfc/stx/concepts.hpp>
 #include <tfc/stx/glaze_meta.hpp>
 #include <tfc/utils/pragmas.hpp>
 
@@ -31,7 +39,6 @@ enum struct filter_e : std::uint8_t {
   multiply,
   filter_out,
   // https://esphome.io/components/sensor/index.html#sensor-filters
-  // todo: make the below filters
   calibrate_linear,  // https://github.com/esphome/esphome/blob/v1.20.4/esphome/components/sensor/__init__.py#L594
   median,
   quantile,
@@ -40,6 +47,7 @@ enum struct filter_e : std::uint8_t {
   throttle,
   throttle_average,
   delta,
+  // todo: make the below filters
   lambda,
   tfc_item,  // according to item json schema see ipc/item.hpp, TODO: implement
 };
@@ -47,17 +55,35 @@ enum struct filter_e : std::uint8_t {
 template <filter_e type, typename value_t, typename...>
 struct filter;
 
+/// \brief filter that produces its result within the call, the filters pipeline runs chains of these inline
+template <typename filter_t, typename value_t>
+concept synchronous_filter = requires(filter_t const& instance, value_t&& value) {
+  { instance.process(std::move(value)) } -> std::same_as<std::expected<value_t, std::error_code>>;
+};
+
+namespace detail {
+/// \brief complete the token with the result of process(value), for filters whose result is known immediately
+auto complete_immediately(auto&& value, auto&& completion_token, auto&& process) {
+  using result_t = std::invoke_result_t<decltype(process), decltype(value)>;
+  auto exe = asio::get_associated_executor(completion_token);
+  return asio::async_compose<decltype(completion_token), void(result_t)>(
+      [copy = std::forward<decltype(value)>(value), process = std::forward<decltype(process)>(process)](
+          auto& self) mutable { self.complete(std::invoke(process, std::move(copy))); },
+      completion_token, exe);
+}
+}  // namespace detail
+
 /// \brief behaviour flip the state of boolean
 template <>
 struct filter<filter_e::invert, bool> {
   static constexpr filter_e const_value{ filter_e::invert };
   constexpr auto operator==(filter const&) const noexcept -> bool = default;
 
+  auto process(bool&& value) const -> std::expected<bool, std::error_code> { return !value; }
+
   auto async_process(bool&& value, auto&& completion_token) const {
-    // todo can we get a compile error if executor is non-existent?
-    auto exe = asio::get_associated_executor(completion_token);
-    return asio::async_compose<decltype(completion_token), void(std::expected<bool, std::error_code>)>(
-        [copy = value](auto& self) { self.complete(!copy); }, completion_token, exe);
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](bool&& arg) { return process(std::move(arg)); });
   }
 
   struct glaze {
@@ -160,14 +186,11 @@ struct filter<filter_e::offset, value_t> {
   constexpr auto operator==(filter const&) const noexcept -> bool = default;
   PRAGMA_CLANG_WARNING_POP
 
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> { return value + offset; }
+
   auto async_process(value_t&& value, auto&& completion_token) const {
-    // todo can we get a compile error if executor is non-existent?
-    auto exe = asio::get_associated_executor(completion_token);
-    return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
-        [this, copy = value](auto& self) {
-          self.complete(copy + offset);  //
-        },
-        completion_token, exe);
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](value_t&& arg) { return process(std::move(arg)); });
   }
 
   struct glaze {
@@ -188,14 +211,11 @@ struct filter<filter_e::multiply, value_t> {
   constexpr auto operator==(filter const&) const noexcept -> bool = default;
   PRAGMA_CLANG_WARNING_POP
 
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> { return value * multiply; }
+
   auto async_process(value_t&& value, auto&& completion_token) const {
-    // todo can we get a compile error if executor is non-existent?
-    auto exe = asio::get_associated_executor(completion_token);
-    return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
-        [this, copy = value](auto& self) {
-          self.complete(copy * multiply);  //
-        },
-        completion_token, exe);
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](value_t&& arg) { return process(std::move(arg)); });
   }
 
   struct glaze {
@@ -215,22 +235,21 @@ struct filter<filter_e::filter_out, value_t> {
   constexpr auto operator==(filter const&) const noexcept -> bool = default;
   PRAGMA_CLANG_WARNING_POP
 
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    // Todo should this filter be available for double?
+    // clang-format off
+    PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+    if (value == filter_out) {
+    PRAGMA_CLANG_WARNING_POP
+      // clang-format on
+      return std::unexpected(std::make_error_code(std::errc::bad_message));
+    }
+    return std::move(value);
+  }
+
   auto async_process(value_t&& value, auto&& completion_token) const {
-    auto executor{ asio::get_associated_executor(completion_token) };
-    return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
-        [this, moved_value = std::move(value)](auto& self) {
-          // Todo should this filter be available for double?
-          // clang-format off
-          PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
-          if (moved_value == filter_out) {
-          PRAGMA_CLANG_WARNING_POP
-            // clang-format on
-            self.complete(std::unexpected(std::make_error_code(std::errc::bad_message)));
-          } else {
-            self.complete(moved_value);
-          }
-        },
-        completion_token, executor);
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](value_t&& arg) { return process(std::move(arg)); });
   }
 
   struct glaze {
@@ -243,6 +262,525 @@ struct filter<filter_e::filter_out, value_t> {
 };
 
 namespace detail {
+/// \brief values the statistical filters apply to, numbers and quantities
+template <typename value_t>
+concept statistical_value =
+    ((std::integral<value_t> || std::floating_point<value_t>) && !std::same_as<value_t, bool>) ||
+    stx::is_expected_quantity<value_t>;
+
+/// \brief round to the nearest integer, saturating at the limits of the type
+/// Converting an out of range double is undefined, f.e. a negative result of an unsigned value is clamped to 0.
+template <std::integral integral_t>
+auto saturate(double sample) -> integral_t {
+  using limits = std::numeric_limits<integral_t>;
+  if (std::isnan(sample)) {
+    return integral_t{};
+  }
+  auto const rounded{ std::round(sample) };
+  if (rounded <= static_cast<double>(limits::lowest())) {
+    return limits::lowest();
+  }
+  // max of 64 bit types is not representable, the double rounds up to 2^N which is out of range
+  if (rounded >= static_cast<double>(limits::max())) {
+    return limits::max();
+  }
+  return static_cast<integral_t>(rounded);
+}
+
+/// \brief numeric view of a value used by the statistical filters, error values of quantities have no sample
+template <typename value_t>
+struct sample_traits {
+  static auto to_sample(value_t const& value) -> std::optional<double> { return static_cast<double>(value); }
+  static auto from_sample(double sample) -> value_t {
+    if constexpr (std::integral<value_t>) {
+      return saturate<value_t>(sample);
+    } else {
+      return sample;
+    }
+  }
+};
+template <typename value_t>
+  requires stx::is_expected_quantity<value_t>
+struct sample_traits<value_t> {
+  using quantity_t = typename value_t::value_type;
+  using rep_t = typename quantity_t::rep;
+  static auto to_sample(value_t const& value) -> std::optional<double> {
+    if (!value.has_value()) {
+      return std::nullopt;
+    }
+    return static_cast<double>(value->numerical_value_in(quantity_t::unit));
+  }
+  static auto from_sample(double sample) -> value_t {
+    if constexpr (std::integral<rep_t>) {
+      return saturate<rep_t>(sample) * quantity_t::reference;
+    } else {
+      return static_cast<rep_t>(sample) * quantity_t::reference;
+    }
+  }
+};
+
+/// \brief runtime state of a filter, copies start out empty and comparison ignores it so only the configuration
+/// is copied and compared
+template <typename state_t>
+struct transient {
+  transient() = default;
+  transient(transient const&) noexcept {}
+  transient(transient&&) noexcept = default;
+  auto operator=(transient const&) noexcept -> transient& {
+    value = {};
+    return *this;
+  }
+  auto operator=(transient&&) noexcept -> transient& = default;
+  ~transient() = default;
+  constexpr auto operator==(transient const&) const noexcept -> bool { return true; }
+
+  mutable state_t value{};
+};
+
+}  // namespace detail
+
+/// \brief behaviour map values through a straight line fitted to the given datapoints with least squares
+/// one datapoint only offsets the value, no datapoints leave the value unchanged
+/// The fit is computed on the first value and kept until config_changed.
+template <detail::statistical_value value_t>
+struct filter<filter_e::calibrate_linear, value_t> {
+  struct datapoint {
+    double from{};
+    double to{};
+    // clang-format off
+    PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+    // clang-format on
+    constexpr auto operator==(datapoint const&) const noexcept -> bool = default;
+    PRAGMA_CLANG_WARNING_POP
+    struct glaze {
+      static constexpr std::string_view name{ "tfc::ipc::filter::calibrate_linear::datapoint" };
+      static constexpr auto value{
+        glz::object("from", &datapoint::from, "Raw value", "to", &datapoint::to, "Calibrated value")
+      };
+    };
+  };
+  std::vector<datapoint> calibrate_linear{};
+  static constexpr filter_e type{ filter_e::calibrate_linear };
+  constexpr auto operator==(filter const&) const noexcept -> bool = default;
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    auto const sample{ detail::sample_traits<value_t>::to_sample(value) };
+    if (!sample || calibrate_linear.empty()) {
+      return std::move(value);
+    }
+    auto& fitted{ line_.value };
+    if (!fitted) {
+      fitted = fit();
+    }
+    return detail::sample_traits<value_t>::from_sample(sample.value() * fitted->slope + fitted->bias);
+  }
+
+  /// \brief drop the fit of the former datapoints, the configuration is read into the existing filter
+  void config_changed() const noexcept { line_.value.reset(); }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](value_t&& arg) { return process(std::move(arg)); });
+  }
+
+  struct line {
+    double slope{ 1.0 };
+    double bias{};
+  };
+
+  [[nodiscard]] auto fit() const -> line {
+    double const count{ static_cast<double>(calibrate_linear.size()) };
+    double sum_from{};
+    double sum_to{};
+    double sum_from_to{};
+    double sum_from_from{};
+    for (auto const& [from, to] : calibrate_linear) {
+      sum_from += from;
+      sum_to += to;
+      sum_from_to += from * to;
+      sum_from_from += from * from;
+    }
+    double const denominator{ count * sum_from_from - sum_from * sum_from };
+    line result{};
+    if (std::abs(denominator) > std::numeric_limits<double>::epsilon()) {
+      result.slope = (count * sum_from_to - sum_from * sum_to) / denominator;
+    }
+    result.bias = (sum_to - result.slope * sum_from) / count;
+    return result;
+  }
+
+  detail::transient<std::optional<line>> line_{};
+
+  struct glaze {
+    using type = filter<filter_e::calibrate_linear, value_t>;
+    static constexpr std::string_view name{ "tfc::ipc::filter::calibrate_linear" };
+    static constexpr auto value{
+      glz::object("calibrate_linear", &type::calibrate_linear, "Datapoints mapping raw values to calibrated values")
+    };
+  };
+};
+
+/// \brief behaviour median of the most recent samples
+template <detail::statistical_value value_t>
+struct filter<filter_e::median, value_t> {
+  std::size_t median_window{ 5 };
+  static constexpr filter_e type{ filter_e::median };
+  constexpr auto operator==(filter const&) const noexcept -> bool = default;
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    auto const sample{ detail::sample_traits<value_t>::to_sample(value) };
+    if (!sample) {
+      return std::move(value);
+    }
+    auto& window{ window_.value };
+    if (!window || window->capacity() != std::max<std::size_t>(median_window, 1)) {
+      window.emplace(median_window);
+    }
+    window->push(sample.value());
+    return detail::sample_traits<value_t>::from_sample(window->median());
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](value_t&& arg) { return process(std::move(arg)); });
+  }
+
+  detail::transient<std::optional<details::order_statistic_window>> window_{};
+
+  struct glaze {
+    using type = filter<filter_e::median, value_t>;
+    static constexpr std::string_view name{ "tfc::ipc::filter::median" };
+    static constexpr auto value{
+      glz::object("median_window", &type::median_window, "Number of most recent values to take the median of")
+    };
+  };
+};
+
+/// \brief behaviour quantile of the most recent samples, f.e. 0.9 outputs the value 90% of the samples are below
+template <detail::statistical_value value_t>
+struct filter<filter_e::quantile, value_t> {
+  std::size_t quantile_window{ 5 };
+  double quantile{ 0.9 };
+  static constexpr filter_e type{ filter_e::quantile };
+  // clang-format off
+  PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+  // clang-format on
+  constexpr auto operator==(filter const&) const noexcept -> bool = default;
+  PRAGMA_CLANG_WARNING_POP
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    auto const sample{ detail::sample_traits<value_t>::to_sample(value) };
+    if (!sample) {
+      return std::move(value);
+    }
+    auto& window{ window_.value };
+    if (!window || window->capacity() != std::max<std::size_t>(quantile_window, 1)) {
+      window.emplace(quantile_window);
+    }
+    window->push(sample.value());
+    return detail::sample_traits<value_t>::from_sample(window->quantile(quantile));
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](value_t&& arg) { return process(std::move(arg)); });
+  }
+
+  detail::transient<std::optional<details::order_statistic_window>> window_{};
+
+  struct glaze {
+    using type = filter<filter_e::quantile, value_t>;
+    static constexpr std::string_view name{ "tfc::ipc::filter::quantile" };
+    // clang-format off
+    static constexpr auto value{ glz::object(
+      "quantile_window", &type::quantile_window, "Number of most recent values to take the quantile of",
+      "quantile", &type::quantile, "Fraction of the values below the output, between 0 and 1"
+    ) };
+    // clang-format on
+  };
+};
+
+/// \brief behaviour arithmetic mean of the most recent samples
+template <detail::statistical_value value_t>
+struct filter<filter_e::sliding_window_moving_average, value_t> {
+  std::size_t moving_average_window{ 15 };
+  static constexpr filter_e type{ filter_e::sliding_window_moving_average };
+  constexpr auto operator==(filter const&) const noexcept -> bool = default;
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    auto const sample{ detail::sample_traits<value_t>::to_sample(value) };
+    if (!sample) {
+      return std::move(value);
+    }
+    auto& state{ state_.value };
+    if (!state || state->window.capacity() != std::max<std::size_t>(moving_average_window, 1)) {
+      state.emplace(moving_average_window);
+    }
+    if (state->window.wrapped()) {
+      // the running sum accumulates rounding errors, start over from the window once per revolution
+      state->sum = std::accumulate(state->window.values().begin(), state->window.values().end(), 0.0);
+    }
+    state->sum += sample.value();
+    if (auto const evicted{ state->window.push(sample.value()) }) {
+      state->sum -= evicted.value();
+    }
+    return detail::sample_traits<value_t>::from_sample(state->sum / static_cast<double>(state->window.size()));
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](value_t&& arg) { return process(std::move(arg)); });
+  }
+
+  struct state_t {
+    explicit state_t(std::size_t capacity) : window{ capacity } {}
+    details::ring_buffer<double> window;
+    double sum{};
+  };
+  detail::transient<std::optional<state_t>> state_{};
+
+  struct glaze {
+    using type = filter<filter_e::sliding_window_moving_average, value_t>;
+    static constexpr std::string_view name{ "tfc::ipc::filter::sliding_window_moving_average" };
+    static constexpr auto value{ glz::object("moving_average_window",
+                                             &type::moving_average_window,
+                                             "Number of most recent values to average") };
+  };
+};
+
+/// \brief behaviour exponentially weighted average, output = alpha * value + (1 - alpha) * previous output
+template <detail::statistical_value value_t>
+struct filter<filter_e::exponential_moving_average, value_t> {
+  double alpha{ 0.1 };
+  static constexpr filter_e type{ filter_e::exponential_moving_average };
+  // clang-format off
+  PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+  // clang-format on
+  constexpr auto operator==(filter const&) const noexcept -> bool = default;
+  PRAGMA_CLANG_WARNING_POP
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    auto const sample{ detail::sample_traits<value_t>::to_sample(value) };
+    if (!sample) {
+      return std::move(value);
+    }
+    auto& average{ average_.value };
+    average = average ? alpha * sample.value() + (1.0 - alpha) * average.value() : sample.value();
+    return detail::sample_traits<value_t>::from_sample(average.value());
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](value_t&& arg) { return process(std::move(arg)); });
+  }
+
+  detail::transient<std::optional<double>> average_{};
+
+  struct glaze {
+    using type = filter<filter_e::exponential_moving_average, value_t>;
+    static constexpr std::string_view name{ "tfc::ipc::filter::exponential_moving_average" };
+    static constexpr auto value{
+      glz::object("alpha", &type::alpha, "Weight of the newest value between 0 and 1, lower is smoother")
+    };
+  };
+};
+
+/// \brief behaviour drop values that differ less than delta from the last passed value
+template <detail::statistical_value value_t>
+struct filter<filter_e::delta, value_t> {
+  double delta{};
+  static constexpr filter_e type{ filter_e::delta };
+  // clang-format off
+  PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
+  // clang-format on
+  constexpr auto operator==(filter const&) const noexcept -> bool = default;
+  PRAGMA_CLANG_WARNING_POP
+
+  auto process(value_t&& value) const -> std::expected<value_t, std::error_code> {
+    auto const sample{ detail::sample_traits<value_t>::to_sample(value) };
+    if (!sample) {
+      return std::move(value);
+    }
+    auto& last{ last_.value };
+    if (last && std::abs(sample.value() - last.value()) < delta) {
+      return std::unexpected(std::make_error_code(std::errc::bad_message));
+    }
+    last = sample;
+    return std::move(value);
+  }
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    return detail::complete_immediately(std::move(value), std::forward<decltype(completion_token)>(completion_token),
+                                        [this](value_t&& arg) { return process(std::move(arg)); });
+  }
+
+  detail::transient<std::optional<double>> last_{};
+
+  struct glaze {
+    using type = filter<filter_e::delta, value_t>;
+    static constexpr std::string_view name{ "tfc::ipc::filter::delta" };
+    static constexpr auto value{
+      glz::object("delta", &type::delta, "Minimum change from the last passed value, in the unit of the signal")
+    };
+  };
+};
+
+/// \brief behaviour pass at most one value per throttle period
+/// The first value is passed immediately, the last value received within the period is passed when the period ends.
+/// Values replaced by a newer one within the period complete with operation_canceled. One timer wait per period.
+template <detail::statistical_value value_t, typename timer_type>  // example asio::steady_timer
+struct filter<filter_e::throttle, value_t, timer_type> {
+  std::chrono::milliseconds throttle{ 0 };
+  static constexpr filter_e type{ filter_e::throttle };
+  constexpr auto operator==(filter const&) const noexcept -> bool = default;
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    auto exe = asio::get_associated_executor(completion_token);
+    return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
+        [this, copy = std::move(value), state = std::weak_ptr<state_t>{}, first_call = true](
+            auto& self, std::error_code code = {}) mutable {
+          if (!first_call) {
+            auto const waiting{ state.lock() };
+            if (!waiting || code) {
+              // the filter was destroyed while waiting
+              self.complete(std::unexpected(code ? code : std::make_error_code(std::errc::operation_canceled)));
+              return;
+            }
+            // the period ended, pass the last value received within it
+            waiting->waiting = false;
+            waiting->last_pass = clock_type::now();
+            self.complete(std::move(waiting->pending.value()));
+            return;
+          }
+          first_call = false;
+          auto& current{ state_.value };
+          if (!current) {
+            current = std::make_shared<state_t>();
+          }
+          if (current->waiting) {
+            current->pending = std::move(copy);
+            self.complete(std::unexpected(std::make_error_code(std::errc::operation_canceled)));
+            return;
+          }
+          auto const now{ clock_type::now() };
+          if (!current->last_pass || now - current->last_pass.value() >= throttle) {
+            current->last_pass = now;
+            self.complete(std::move(copy));
+            return;
+          }
+          current->pending = std::move(copy);
+          current->waiting = true;
+          if (!current->timer) {
+            current->timer.emplace(asio::get_associated_executor(self));
+          }
+          current->timer->expires_at(current->last_pass.value() + throttle);
+          state = current;
+          current->timer->async_wait(std::move(self));
+        },
+        completion_token, exe);
+  }
+
+  using clock_type = typename timer_type::clock_type;
+  struct state_t {
+    std::optional<timer_type> timer{ std::nullopt };
+    std::optional<value_t> pending{ std::nullopt };
+    std::optional<typename clock_type::time_point> last_pass{ std::nullopt };
+    bool waiting{ false };
+  };
+  // shared with the pending wait which only holds a weak reference, destroying the filter cancels the wait
+  detail::transient<std::shared_ptr<state_t>> state_{};
+
+  struct glaze {
+    using type = filter;
+    static constexpr std::string_view name{ "tfc::ipc::filter::throttle" };
+    static constexpr auto value{
+      glz::object("throttle", &type::throttle, "Minimum time between values, the latest value is passed when it ends")
+    };
+  };
+};
+
+/// \brief behaviour average all values received within each throttle_average period and pass the average at its end
+/// The period starts at the first value received, values averaged into a later output complete with
+/// operation_canceled. No timer is armed while no values are received.
+template <detail::statistical_value value_t, typename timer_type>  // example asio::steady_timer
+struct filter<filter_e::throttle_average, value_t, timer_type> {
+  std::chrono::milliseconds throttle_average{ 0 };
+  static constexpr filter_e type{ filter_e::throttle_average };
+  constexpr auto operator==(filter const&) const noexcept -> bool = default;
+
+  auto async_process(value_t&& value, auto&& completion_token) const {
+    auto exe = asio::get_associated_executor(completion_token);
+    return asio::async_compose<decltype(completion_token), void(std::expected<value_t, std::error_code>)>(
+        [this, copy = std::move(value), state = std::weak_ptr<state_t>{}, first_call = true](
+            auto& self, std::error_code code = {}) mutable {
+          if (!first_call) {
+            auto const waiting{ state.lock() };
+            if (!waiting || code) {
+              // the filter was destroyed while waiting
+              self.complete(std::unexpected(code ? code : std::make_error_code(std::errc::operation_canceled)));
+              return;
+            }
+            auto const average{ waiting->sum / static_cast<double>(waiting->count) };
+            waiting->sum = 0;
+            waiting->count = 0;
+            self.complete(detail::sample_traits<value_t>::from_sample(average));
+            return;
+          }
+          first_call = false;
+          auto const sample{ detail::sample_traits<value_t>::to_sample(copy) };
+          if (!sample) {
+            self.complete(std::move(copy));
+            return;
+          }
+          auto& current{ state_.value };
+          if (!current) {
+            current = std::make_shared<state_t>();
+          }
+          current->sum += sample.value();
+          if (current->count++ > 0) {
+            self.complete(std::unexpected(std::make_error_code(std::errc::operation_canceled)));
+            return;
+          }
+          if (!current->timer) {
+            current->timer.emplace(asio::get_associated_executor(self));
+          }
+          current->timer->expires_after(throttle_average);
+          state = current;
+          current->timer->async_wait(std::move(self));
+        },
+        completion_token, exe);
+  }
+
+  struct state_t {
+    std::optional<timer_type> timer{ std::nullopt };
+    double sum{};
+    std::size_t count{};
+  };
+  // shared with the pending wait which only holds a weak reference, destroying the filter cancels the wait
+  detail::transient<std::shared_ptr<state_t>> state_{};
+
+  struct glaze {
+    using type = filter;
+    static constexpr std::string_view name{ "tfc::ipc::filter::throttle_average" };
+    static constexpr auto value{
+      glz::object("throttle_average", &type::throttle_average, "Period to average values over before passing the average")
+    };
+  };
+};
+
+namespace detail {
+/// \brief variant of the given filters and the statistical filters of value_t
+template <typename value_t, typename... filters_t>
+using with_statistical_t = std::variant<filters_t...,
+                                        filter<filter_e::calibrate_linear, value_t>,
+                                        filter<filter_e::median, value_t>,
+                                        filter<filter_e::quantile, value_t>,
+                                        filter<filter_e::sliding_window_moving_average, value_t>,
+                                        filter<filter_e::exponential_moving_average, value_t>,
+                                        filter<filter_e::throttle, value_t, asio::steady_timer>,
+                                        filter<filter_e::throttle_average, value_t, asio::steady_timer>,
+                                        filter<filter_e::delta, value_t>>;
+
 template <typename value_t>
 struct any_filter_decl;
 template <>
@@ -253,20 +791,26 @@ struct any_filter_decl<bool> {
 template <>
 struct any_filter_decl<std::int64_t> {
   using value_t = std::int64_t;
-  using type = std::
-      variant<filter<filter_e::filter_out, value_t>, filter<filter_e::offset, value_t>, filter<filter_e::multiply, value_t>>;
+  using type = with_statistical_t<value_t,
+                                  filter<filter_e::filter_out, value_t>,
+                                  filter<filter_e::offset, value_t>,
+                                  filter<filter_e::multiply, value_t>>;
 };
 template <>
 struct any_filter_decl<std::uint64_t> {
   using value_t = std::uint64_t;
-  using type = std::
-      variant<filter<filter_e::filter_out, value_t>, filter<filter_e::offset, value_t>, filter<filter_e::multiply, value_t>>;
+  using type = with_statistical_t<value_t,
+                                  filter<filter_e::filter_out, value_t>,
+                                  filter<filter_e::offset, value_t>,
+                                  filter<filter_e::multiply, value_t>>;
 };
 template <>
 struct any_filter_decl<std::double_t> {
   using value_t = std::double_t;
-  using type = std::
-      variant<filter<filter_e::filter_out, value_t>, filter<filter_e::offset, value_t>, filter<filter_e::multiply, value_t>>;
+  using type = with_statistical_t<value_t,
+                                  filter<filter_e::filter_out, value_t>,
+                                  filter<filter_e::offset, value_t>,
+                                  filter<filter_e::multiply, value_t>>;
 };
 template <>
 struct any_filter_decl<std::string> {
@@ -276,31 +820,36 @@ struct any_filter_decl<std::string> {
 template <>
 struct any_filter_decl<details::mass_t> {
   using value_t = details::mass_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = with_statistical_t<value_t, filter<filter_e::filter_out, value_t>>;
 };
 template <>
 struct any_filter_decl<details::pressure_t> {
   using value_t = details::pressure_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = with_statistical_t<value_t, filter<filter_e::filter_out, value_t>>;
 };
 template <>
 struct any_filter_decl<details::temperature_t> {
   using value_t = details::temperature_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = with_statistical_t<value_t, filter<filter_e::filter_out, value_t>>;
 };
 template <>
 struct any_filter_decl<details::length_t> {
   using value_t = details::length_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = with_statistical_t<value_t, filter<filter_e::filter_out, value_t>>;
 };
 template <>
 struct any_filter_decl<details::voltage_t> {
   using value_t = details::voltage_t;
-  using type = std::variant<filter<filter_e::filter_out, value_t>>;
+  using type = with_statistical_t<value_t, filter<filter_e::filter_out, value_t>>;
 };
 template <>
 struct any_filter_decl<details::current_t> {
   using value_t = details::current_t;
+  using type = with_statistical_t<value_t, filter<filter_e::filter_out, value_t>>;
+};
+/// \brief records are compared as a whole, their fields have no filters of their own
+template <details::concepts::is_record value_t>
+struct any_filter_decl<value_t> {
   using type = std::variant<filter<filter_e::filter_out, value_t>>;
 };
 // json?
@@ -332,12 +881,24 @@ public:
   ~filters() = default;
 
   /// \brief changes internal last_value state when filters have been processed
+  /// Chains of only synchronous filters are processed within this call, other chains are processed in a coroutine
+  /// per value. The coroutines run concurrently on purpose, the timer and throttle filters decide what to do with a
+  /// waiting value when the next one arrives, which a single coroutine taking values one by one would hold back.
+  /// Values are delivered in the order they are received. A result completing after the result of a newer value,
+  /// or after a value given to set, is dropped without calling the callback, the callback never goes back in time.
   void operator()(auto&& value)
     requires std::same_as<std::remove_cvref_t<decltype(value)>, value_t>
   {
+    auto const sequence{ ++received_ };
     if (filters_->value().empty()) {
-      last_value_ = std::forward<decltype(value)>(value);
-      std::invoke(callback_, last_value_.value());
+      deliver(sequence, std::forward<decltype(value)>(value));
+      return;
+    }
+    if (synchronous()) {
+      auto return_value{ process_inline(std::forward<decltype(value)>(value)) };
+      if (return_value.has_value()) {
+        deliver(sequence, std::move(return_value.value()));
+      }
       return;
     }
     std::expected<value_t, std::error_code> return_value{ std::forward<decltype(value)>(value) };
@@ -358,13 +919,12 @@ public:
           }
           co_return std::move(return_val);
         },
-        [this](std::exception_ptr const& exception_ptr, std::expected<value_t, std::error_code>&& return_val) {
+        [this, sequence](std::exception_ptr const& exception_ptr, std::expected<value_t, std::error_code>&& return_val) {
           if (exception_ptr) {
             std::rethrow_exception(exception_ptr);
           }
           if (return_val.has_value()) {
-            last_value_ = std::move(return_val.value());
-            std::invoke(callback_, last_value_.value());
+            deliver(sequence, std::move(return_val.value()));
           } else {
             // I have now forgotten the original value/s
           }
@@ -373,6 +933,15 @@ public:
 
   void config_updated([[maybe_unused]] config_t<value_t> const& new_filters,
                       [[maybe_unused]] config_t<value_t> const& old_filters) {
+    for (auto const& filter : new_filters) {
+      std::visit(
+          [](auto const& arg) {
+            if constexpr (requires { arg.config_changed(); }) {
+              arg.config_changed();
+            }
+          },
+          filter);
+    }
     if constexpr (std::same_as<value_t, bool>) {
       if (!last_value_.has_value()) {
         return;
@@ -400,17 +969,54 @@ public:
   void set(auto&& value)
     requires std::same_as<std::remove_cvref_t<decltype(value)>, value_t>
   {
-    last_value_ = std::forward<decltype(value)>(value);
-    std::invoke(callback_, last_value_.value());
+    deliver(++received_, std::forward<decltype(value)>(value));
   }
 
   [[nodiscard]] auto value() const noexcept -> std::optional<value_t> const& { return last_value_; }
 
+  /// \return true when every configured filter completes within the call
+  [[nodiscard]] auto synchronous() const -> bool {
+    return std::ranges::all_of(filters_->value(), [](auto const& filter) {
+      return std::visit([](auto const& arg) { return synchronous_filter<std::remove_cvref_t<decltype(arg)>, value_t>; },
+                        filter);
+    });
+  }
+
 private:
+  auto process_inline(value_t value) const -> std::expected<value_t, std::error_code> {
+    std::expected<value_t, std::error_code> return_value{ std::move(value) };
+    for (auto const& filter : filters_->value()) {
+      return_value = std::visit(
+          [&return_value](auto const& arg) -> std::expected<value_t, std::error_code> {
+            if constexpr (synchronous_filter<std::remove_cvref_t<decltype(arg)>, value_t>) {
+              return arg.process(std::move(return_value.value()));
+            } else {
+              return std::unexpected(std::make_error_code(std::errc::operation_not_supported));
+            }
+          },
+          filter);
+      if (!return_value.has_value()) {
+        break;
+      }
+    }
+    return return_value;
+  }
+
+  void deliver(std::uint64_t sequence, auto&& value) {
+    if (sequence < delivered_) {
+      return;  // a newer value has already been delivered
+    }
+    delivered_ = sequence;
+    last_value_ = std::forward<decltype(value)>(value);
+    std::invoke(callback_, last_value_.value());
+  }
+
   asio::io_context& ctx_;
   confman_t filters_;
   callback_t callback_;
   std::optional<value_t> last_value_{};
+  std::uint64_t received_{};
+  std::uint64_t delivered_{};
 };
 
 }  // namespace tfc::ipc::filter
@@ -427,14 +1033,14 @@ struct glz::meta<tfc::ipc::filter::filter_e> {
                                               "offset", offset, "Adds a constant value to each sensor value",
                                               "multiply", multiply, "Multiplies each value by a constant value",
                                               "filter_out", filter_out, "Filter out specific values to drop and forget",
-                                              "calibrate_linear", calibrate_linear,
-                                              "median", median,
-                                              "quantile", quantile,
-                                              "sliding_window_moving_average", sliding_window_moving_average,
-                                              "exponential_moving_average", exponential_moving_average,
-                                              "throttle", throttle,
-                                              "throttle_average", throttle_average,
-                                              "delta", delta,
+                                              "calibrate_linear", calibrate_linear, "Map values through a line fitted to datapoints",
+                                              "median", median, "Median of the most recent values",
+                                              "quantile", quantile, "Quantile of the most recent values",
+                                              "sliding_window_moving_average", sliding_window_moving_average, "Mean of the most recent values",
+                                              "exponential_moving_average", exponential_moving_average, "Exponentially weighted average",
+                                              "throttle", throttle, "Pass at most one value per period",
+                                              "throttle_average", throttle_average, "Pass the average of the values within each period",
+                                              "delta", delta, "Drop values that changed less than delta",
                                               "lambda", lambda) };
   // clang-format on
 };
@@ -1,26 +1,34 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <concepts>
 #include <expected>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <variant>
 
 #include <fmt/format.h>
 #include <azmq/socket.hpp>
 #include <boost/asio/compose.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/system/error_code.hpp>
 
 #include <tfc/ipc/details/dbus_ipc.hpp>
+#include <tfc/ipc/details/send_buffer.hpp>
+#include <tfc/ipc/details/shm.hpp>
 #include <tfc/ipc/details/type_description.hpp>
 #include <tfc/ipc/enums.hpp>
 #include <tfc/ipc/packet.hpp>
+#include <tfc/logger.hpp>
 #include <tfc/progbase.hpp>
 #include <tfc/stx/concepts.hpp>
 #include <tfc/utils/pragmas.hpp>
@@ -72,10 +80,11 @@ public:
   using packet_t = packet<value_t, type_desc::value_e>;
   static auto constexpr direction_v = direction_e::signal;
 
-  [[nodiscard]] static auto create(asio::io_context& ctx, std::string_view name)
+  /// \param transport transport_e::shm additionally publishes every value to a shared memory segment
+  [[nodiscard]] static auto create(asio::io_context& ctx, std::string_view name, transport_e transport = transport_e::zmq)
       -> std::expected<std::shared_ptr<signal<type_desc>>, std::error_code> {
     auto ptr = std::shared_ptr<signal<type_desc>>(new signal(ctx, name));
-    auto error = ptr->init();
+    auto error = ptr->init(transport);
     if (error) {
       return std::unexpected(error);
     }
@@ -85,39 +94,41 @@ public:
   /// @param value is sent
   /// @return std::error_code, empty if no error.
   auto send(value_t const& value) -> std::error_code {
-    last_value_ = value;
-    std::vector<std::byte> send_buffer{};
-    if (auto serialize_err{ packet_t::serialize(last_value_.value(), send_buffer) }) {
-      return serialize_err;
-    }
-    std::size_t size = socket_.send(asio::buffer(send_buffer));
-    if (size != send_buffer.size()) {
-      return std::make_error_code(std::errc::value_too_large);
-    }
-    return {};
+    update_last_value(value);
+    return publish();
   }
 
   /// @brief send value to subscriber
   /// @tparam completion_token_t a concept of type void(std::error_code, std::size_t)
   /// @param value is sent
+  /// @note the serialization buffer is borrowed from a per signal pool and returned on completion
   template <asio::completion_token_for<void(std::error_code, std::size_t)> completion_token_t>
   auto async_send(value_t const& value, completion_token_t&& token) ->
       typename asio::async_result<std::decay_t<completion_token_t>, void(std::error_code, std::size_t)>::return_type {
-    last_value_ = value;
-    auto send_buffer{ std::make_unique<std::vector<std::byte>>() };
-    if (auto serialize_error{ packet_t::serialize(last_value_.value(), *send_buffer) }) {
+    update_last_value(value);
+    auto send_buffer{ send_buffers_.acquire() };
+    if (auto serialize_error{
+            send_buffers_.template serialize<packet_t>(*send_buffer, last_value_.value(), effective_wire_format()) }) {
+      send_buffers_.release(std::move(send_buffer));
       return asio::async_compose<completion_token_t, void(std::error_code, std::size_t)>(
           [serialize_error](auto& self, std::error_code = {}, std::size_t = 0) { self.complete(serialize_error, 0); },
           token);
     }
+    publish_shm(*send_buffer);
 
     enum struct state_e { write, complete };
 
     auto& socket{ socket_ };
     return asio::async_compose<completion_token_t, void(std::error_code, std::size_t)>(
-        [&socket, buffer = std::move(send_buffer), state = state_e::write](auto& self, std::error_code err = {},
-                                                                           std::size_t bytes_sent = 0) mutable {
+        [&socket, weak_self = this->weak_from_this(), buffer = std::move(send_buffer), state = state_e::write](
+            auto& self, std::error_code err = {}, std::size_t bytes_sent = 0) mutable {
+          auto const recycle{ [&weak_self, &buffer] {
+            if (auto instance = weak_self.lock()) {
+              instance->send_buffers_.release(std::move(buffer));
+            }
+          } };
           if (err) {
+            recycle();
             self.complete(err, bytes_sent);
             return;
           }
@@ -128,6 +139,7 @@ public:
               break;
             }
             case state_e::complete: {
+              recycle();
               self.complete(err, bytes_sent);
               break;
             }
@@ -137,61 +149,143 @@ public:
   }
   [[nodiscard]] auto value() const noexcept -> auto const& { return last_value_; }
 
+  /// \brief preferred wire format, v1 without crc by default
+  /// v0 is sent instead until every subscriber has advertised v1, see effective_wire_format
+  void set_wire_format(wire_format format) noexcept { wire_format_ = format; }
+
+  [[nodiscard]] auto get_wire_format() const noexcept -> wire_format { return wire_format_; }
+
+  /// \return format values are sent with right now, the preferred one if every subscriber reads it, otherwise v0
+  [[nodiscard]] auto effective_wire_format() const noexcept -> wire_format {
+    if (wire_format_.version == version_e::v0 || (subscribers_ > 0 && v1_subscribers_ >= subscribers_)) {
+      return wire_format_;
+    }
+    return wire_format{};
+  }
+
+  /// \return serialization buffers created or grown by the pool, does not grow once sending has reached steady state
+  [[nodiscard]] auto send_buffer_allocations() const noexcept -> std::size_t { return send_buffers_.allocations(); }
+
 private:
   signal(asio::io_context& ctx, std::string_view name)
-      : transmission_base<type_desc>(name), timer_(ctx), socket_(ctx),
-        socket_monitor_(socket_.monitor(ctx, ZMQ_EVENT_HANDSHAKE_SUCCEEDED)) {}
+      : transmission_base<type_desc>(name), socket_(ctx), logger_(this->type_name()) {}
 
-  auto init() -> std::error_code {
+  auto init(transport_e transport) -> std::error_code {
+    // every (un)subscription is handed to the application, also repeated ones and those of closed pipes
+    int const verboser{ 1 };
+    if (zmq_setsockopt(socket_.native_handle(), ZMQ_XPUB_VERBOSER, &verboser, sizeof(verboser)) != 0) {
+      return std::make_error_code(static_cast<std::errc>(zmq_errno()));
+    }
     boost::system::error_code error_code;
     socket_.bind(this->endpoint(), error_code);
     if (error_code) {
       return error_code;
     }
-    register_handle_accept();
+    if (transport == transport_e::shm) {
+      auto writer{ shm::writer::create(this->full_name(), std::max(packet_t::reserve_size(), shm::default_capacity)) };
+      if (!writer) {
+        return writer.error();
+      }
+      shm_writer_.emplace(std::move(writer.value()));
+    }
+    register_subscription_drain();
     return {};
   }
 
-  void handle_event_accept(std::error_code const& error_code, azmq::message&, size_t) {
-    if (error_code) {
-      assert(false && "Handle event accept canceled!");
-      return;
+  /// \brief serialize the last value and send it to every subscriber
+  auto publish() -> std::error_code {
+    auto send_buffer{ send_buffers_.acquire() };
+    if (auto serialize_err{
+            send_buffers_.template serialize<packet_t>(*send_buffer, last_value_.value(), effective_wire_format()) }) {
+      send_buffers_.release(std::move(send_buffer));
+      return serialize_err;
     }
-    std::array<std::byte, 1024> buffer;
-    socket_monitor_.receive(asio::buffer(buffer), 0);
-    if (!last_value_.has_value()) {
-      register_handle_accept();
+    publish_shm(*send_buffer);
+    std::size_t size = socket_.send(asio::buffer(*send_buffer));
+    bool const complete{ size == send_buffer->size() };
+    send_buffers_.release(std::move(send_buffer));
+    if (!complete) {
+      return std::make_error_code(std::errc::value_too_large);
+    }
+    return {};
+  }
+
+  /// \brief same host subscribers read the value from shared memory, zmq subscribers are still served by the socket
+  void publish_shm(std::vector<std::byte> const& serialized) {
+    if (shm_writer_) {
+      [[maybe_unused]] auto err{ shm_writer_->write(serialized) };
+    }
+  }
+
+  /**@brief
+   * Late joiners receive the last value as the XPUB welcome message, which libzmq writes to each newly attached
+   * subscriber pipe before its subscription is read. Only that pipe receives it, a pipe is not sent publications
+   * until its subscription is read, so a joiner gets the last value exactly once and a reconnect storm costs one
+   * message per subscriber and no resend to everyone already connected.
+   * The welcome only applies to pipes attached after it is set, so it is set before the value is published.
+   * A value published while a pipe is attached but its subscription is not read yet is not sent to that pipe, like
+   * any other publication before subscribing, it has the previous value until the next one.
+   * libzmq copies it, values over 33 bytes allocate, so it is only set again when the value changes.
+   * The welcome is written before the subscriber has advertised its version, so it is always v0.
+   * */
+  void update_last_value(value_t const& value) {
+    if (last_value_ == value) {
       return;
     }
-    // TODO: This sleep is the worst.
-    timer_.expires_after(std::chrono::milliseconds(1));
-    timer_.async_wait([this](std::error_code const& error) {
-      if (error) {
+    last_value_ = value;
+    welcome_buffer_.clear();
+    if (packet_t::serialize(last_value_.value(), welcome_buffer_)) {
+      // a joiner must not be welcomed with an older value, an empty welcome is not sent
+      welcome_buffer_.clear();
+    }
+    auto* const socket{ socket_.native_handle() };
+    if (zmq_setsockopt(socket, ZMQ_XPUB_WELCOME_MSG, welcome_buffer_.data(), welcome_buffer_.size()) != 0) {
+      logger_.warn("Unable to set the welcome message: {}", zmq_strerror(zmq_errno()));
+    }
+  }
+
+  /// \brief the xpub socket queues subscription messages for the application, they are counted to negotiate the version
+  void register_subscription_drain() {
+    auto bind_reference = std::enable_shared_from_this<signal<type_desc>>::weak_from_this();
+    socket_.async_receive([bind_reference](std::error_code const& error_code, azmq::message& message, size_t) {
+      if (error_code) {
         return;
       }
-      async_send(last_value_.value(), [&](std::error_code err, size_t) {
-        if (err) {
-          assert(false && "Handle event accept (send) canceled!");
-          return;
-        }
-        register_handle_accept();
-      });
+      if (auto instance = bind_reference.lock()) {
+        instance->on_subscription(std::string_view{ static_cast<char const*>(message.data()), message.size() });
+        instance->register_subscription_drain();
+      }
     });
   }
 
-  void register_handle_accept() {
-    auto bind_reference = std::enable_shared_from_this<signal<type_desc>>::weak_from_this();
-    socket_monitor_.async_receive(
-        [bind_reference](std::error_code const& error_code, azmq::message& msg, size_t bytes_received) {
-          if (auto instance = bind_reference.lock()) {
-            instance->handle_event_accept(error_code, msg, bytes_received);
-          }
-        });
+  /// \param message first byte 1 for subscribe and 0 for unsubscribe followed by the topic
+  void on_subscription(std::string_view message) {
+    if (message.empty()) {
+      return;
+    }
+    bool const subscribe{ message.front() == 1 };
+    auto const topic{ message.substr(1) };
+    auto* const count{ topic.empty() ? &subscribers_ : topic == v1_subscription ? &v1_subscribers_ : nullptr };
+    if (count == nullptr) {
+      return;
+    }
+    if (subscribe) {
+      ++*count;
+    } else if (*count > 0) {
+      --*count;
+    }
   }
+
   std::optional<value_t> last_value_{ std::nullopt };
-  boost::asio::steady_timer timer_;
-  azmq::pub_socket socket_;
-  azmq::socket socket_monitor_;
+  send_buffer_pool send_buffers_{ packet_t::reserve_size() };
+  wire_format wire_format_{ .version = version_e::v1 };
+  // subscriptions to "" and to v1_subscription, every pipe subscribed to both reads v1
+  std::size_t subscribers_{};
+  std::size_t v1_subscribers_{};
+  std::vector<std::byte> welcome_buffer_{};
+  std::optional<shm::writer> shm_writer_{ std::nullopt };
+  azmq::xpub_socket socket_;
+  tfc::logger::logger logger_;
 };
 
 /**@brief slot
@@ -232,6 +326,10 @@ public:
     if (socket_.set_option(azmq::socket::subscribe(""), error_code)) {
       return error_code;
     }
+    // advertise v1 to the signal, see signal::effective_wire_format
+    if (socket_.set_option(azmq::socket::subscribe(v1_subscription.data(), v1_subscription.size()), error_code)) {
+      return error_code;
+    }
     return {};
   }
 
@@ -239,16 +337,13 @@ public:
    * @brief synchronous reception of slot data.
    * @return a new value sent to the slot
    */
-  [[nodiscard]] auto receive() -> std::expected<value_t&, std::error_code> {
-    std::array<std::byte, 1024> buffer;
+  [[nodiscard]] auto receive() -> std::expected<value_t, std::error_code> {
     boost::system::error_code code;
-    auto bytes_received = socket_.receive(buffer, 0, code);
-
-    if (bytes_received < packet_t::header_size()) {
-      return std::unexpected(ipc_errors_e::message_to_small);
+    socket_.receive(message_, 0, code);
+    if (code) {
+      return std::unexpected(code);
     }
-
-    return packet_t::deserialize(std::span(buffer.data(), bytes_received)).value;
+    return deserialize(message_);
   }
 
   /// \brief schedule an async_read on the slot
@@ -256,34 +351,22 @@ public:
   /// callback of format: void(std::expected<type_desc::value_t, std::error_code>)
   /// coroutine either asio::awaitable<std::expected<value_t, std::error_code>> or
   /// asio::experimental::coro<void, std::expected<value_t, std::error_code>>
+  /// \note the packet is received into a zmq message owned by libzmq, values of any size are received whole
+  /// and small values live inside the message itself, so no buffer is allocated per receive.
   template <typename completion_token_t>
   auto async_receive(completion_token_t&& token)
       -> asio::async_result<std::decay_t<completion_token_t>, void(std::expected<value_t, std::error_code>)>::return_type {
-    enum struct state_e { read, complete };
-
-    std::unique_ptr<std::vector<std::byte>> receive_buffer{ std::make_unique<std::vector<std::byte>>() };
-    receive_buffer->resize(4096, {});
-    // todo receive header first then value
-
     azmq::sub_socket& socket{ socket_ };
     return asio::async_compose<completion_token_t, void(std::expected<value_t, std::error_code>)>(
-        [&socket, state = state_e::read, buffer = std::move(receive_buffer)](auto& self, std::error_code err = {},
-                                                                             std::size_t bytes_received = 0) mutable {
-          if (err) {
-            self.complete(std::unexpected(err));
-            return;
-          }
-          switch (state) {
-            case state_e::read: {
-              state = state_e::complete;
-              azmq::async_receive(socket, asio::buffer(*buffer), std::move(self));
-              break;
-            }
-            case state_e::complete: {
-              self.complete(packet_t::deserialize(std::span{ buffer->data(), bytes_received }));
-              break;
+        [&socket](auto& self) mutable {
+          socket.async_receive([self = std::move(self)](boost::system::error_code const& err, azmq::message& msg,
+                                                        std::size_t) mutable {
+            if (err) {
+              self.complete(std::unexpected(err));
+              return;
             }
-          }
+            self.complete(deserialize(msg));
+          });
         },
         token, socket_);
   }
@@ -297,7 +380,12 @@ public:
   }
 
 private:
+  static auto deserialize(azmq::message const& msg) -> std::expected<value_t, std::error_code> {
+    return packet_t::deserialize(std::span{ static_cast<std::byte const*>(msg.data()), msg.size() });
+  }
+
   azmq::sub_socket socket_;
+  azmq::message message_{};  // reused by synchronous receive
 };
 
 template <typename type_desc>
@@ -306,12 +394,21 @@ public:
   using value_t = type_desc::value_t;
   static auto constexpr direction_v = slot<type_desc>::direction_v;
 
-  [[nodiscard]] static auto create(asio::io_context& ctx, std::string_view name)
+  /// \param transport transport_e::shm reads from the signals shared memory segment when it has one, otherwise zmq is used
+  [[nodiscard]] static auto create(asio::io_context& ctx, std::string_view name, transport_e transport = transport_e::zmq)
       -> std::shared_ptr<slot_callback<type_desc>> {
-    return std::shared_ptr<slot_callback<type_desc>>(new slot_callback<type_desc>{ ctx, name });
+    return std::shared_ptr<slot_callback<type_desc>>(new slot_callback<type_desc>{ ctx, name, transport });
   }
 
   auto connect(std::string_view signal_name, tfc::stx::invocable<value_t> auto&& callback) -> std::error_code {
+    shm_thread_ = {};
+    if (transport_ == transport_e::shm) {
+      shm::reader reader{};
+      if (!reader.open(signal_name)) {
+        register_shm_read(std::move(reader), signal_name, std::forward<decltype(callback)>(callback));
+        return {};
+      }
+    }
     if (auto error = slot_.connect(signal_name)) {
       return error;
     }
@@ -322,7 +419,10 @@ public:
   /**
    * @brief disconnect from signal
    */
-  auto disconnect(std::string_view signal_name) { return slot_.disconnect(signal_name.data()); }
+  auto disconnect(std::string_view signal_name) {
+    shm_thread_ = {};
+    return slot_.disconnect(signal_name.data());
+  }
 
   [[nodiscard]] auto value() const -> std::optional<value_t> { return last_value_; }
 
@@ -333,23 +433,79 @@ public:
   [[nodiscard]] auto full_name() const -> std::string { return slot_.full_name(); }
 
 private:
-  slot_callback(asio::io_context& ctx, std::string_view name) : slot_{ ctx, name } {}
+  static constexpr auto shm_poll_interval{ std::chrono::milliseconds(50) };
+
+  slot_callback(asio::io_context& ctx, std::string_view name, transport_e transport)
+      : ctx_{ ctx }, slot_{ ctx, name }, transport_{ transport } {}
   void async_new_state(std::expected<value_t, std::error_code> new_value, tfc::stx::invocable<value_t> auto&& callback) {
     if (!new_value) {
       return;
     }
-
+    update(std::move(new_value.value()), callback);
+    register_read(std::forward<decltype(callback)>(callback));
+  }
+  void update(value_t&& new_value, tfc::stx::invocable<value_t> auto& callback) {
     // Here we get unfiltered new value and test whether the value matches the current value
     auto const& last_value = value();
     // clang-format off
     PRAGMA_CLANG_WARNING_PUSH_OFF(-Wfloat-equal)
-    if (!last_value.has_value() || new_value.value() != last_value.value()) {
+    if (!last_value.has_value() || new_value != last_value.value()) {
     PRAGMA_CLANG_WARNING_POP
       // clang-format on
-      last_value_ = std::move(new_value.value());
+      last_value_ = std::move(new_value);
       callback(last_value_.value());
     }
-    register_read(std::forward<decltype(callback)>(callback));
+  }
+  /// \brief Waits on the shared memory segment in a dedicated thread and posts new values to the io_context,
+  /// so the callback is invoked from the same context as with the zmq transport.
+  /// Stopping the thread wakes the wait, shm_poll_interval only bounds it if the stop lands right before it sleeps.
+  void register_shm_read(shm::reader&& shm_reader, std::string_view signal_name, tfc::stx::invocable<value_t> auto&& callback) {
+    auto deliver{ [&callback] {
+      if constexpr (std::is_lvalue_reference_v<decltype(callback)>) {
+        return [&callback](value_t&& new_value, slot_callback& self) { self.update(std::move(new_value), callback); };
+      } else {
+        return [callb = std::make_shared<std::decay_t<decltype(callback)>>(std::move(callback))](value_t&& new_value,
+                                                                                               slot_callback& self) {
+          self.update(std::move(new_value), *callb);
+        };
+      }
+    }() };
+    shm_thread_ = std::jthread{ [bind_reference = this->weak_from_this(), &ctx = ctx_, reader = std::move(shm_reader),
+                                 name = std::string{ signal_name }, deliver](std::stop_token stop) mutable {
+      std::vector<std::byte> buffer{};
+      // open and try_read may remap the segment, notify runs on the thread stopping us
+      std::mutex remap{};
+      std::stop_callback const wake{ stop, [&reader, &remap] {
+        std::lock_guard const lock{ remap };
+        reader.notify();
+      } };
+      auto const read{ [&reader, &remap, &buffer] {
+        std::lock_guard const lock{ remap };
+        return reader.try_read(buffer);
+      } };
+      while (!stop.stop_requested()) {
+        if (read()) {
+          auto new_value{ slot<type_desc>::packet_t::deserialize(std::span{ buffer.data(), buffer.size() }) };
+          if (!new_value) {
+            continue;
+          }
+          asio::post(ctx, [bind_reference, deliver, moved_value = std::move(new_value.value())]() mutable {
+            if (auto sptr = bind_reference.lock()) {
+              deliver(std::move(moved_value), *sptr);
+            }
+          });
+          continue;
+        }
+        if (reader.closed()) {
+          // the signal has restarted, attach to its new segment
+          std::this_thread::sleep_for(shm_poll_interval);
+          std::lock_guard const lock{ remap };
+          [[maybe_unused]] auto err{ reader.open(name) };
+          continue;
+        }
+        reader.wait(shm_poll_interval);
+      }
+    } };
   }
   void register_read(tfc::stx::invocable<value_t> auto&& callback) {
     auto bind_reference = std::enable_shared_from_this<slot_callback<type_desc>>::weak_from_this();
@@ -375,7 +531,10 @@ private:
     }
   }
   std::optional<value_t> last_value_{ std::nullopt };
+  asio::io_context& ctx_;
   slot<type_desc> slot_;
+  transport_e transport_{ transport_e::zmq };
+  std::jthread shm_thread_{};
 };
 
 template <typename return_t, template <typename description_t> typename ipc_base_t>
@@ -406,6 +565,7 @@ struct make_any_ptr {
         return ipc_base_t<type_voltage>::create(std::forward<decltype(args)>(args)...);
       case type_e::_current:
         return ipc_base_t<type_current>::create(std::forward<decltype(args)>(args)...);
+      case type_e::_struct:  // the record is not known at runtime
       case type_e::unknown:
         return std::monostate{};
     }
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <mp-units/systems/si.h>
+
+namespace tfc::ipc::details {
+
+namespace concepts {
+/// \brief fixed layout struct which can be sent member by member without parsing
+/// The members are listed by a dbus_reflection, the same requirement as sdbusplus::concepts::dbus_reflectable, so the
+/// record is mirrored on D-Bus and its schema can be hashed. Example:
+/// struct axis_state {
+///   std::int64_t position{};
+///   double velocity{};
+///   std::uint16_t error{};
+///   constexpr auto operator==(axis_state const&) const noexcept -> bool = default;
+///   static constexpr auto dbus_reflection{ [](auto&& self) { return stx::to_tuple(std::forward<decltype(self)>(self)); } };
+/// };
+template <typename given_t>
+concept is_record = std::is_class_v<given_t> && std::is_trivially_copyable_v<given_t> &&
+                    std::is_standard_layout_v<given_t> && std::is_aggregate_v<given_t> &&
+                    std::equality_comparable<given_t> && requires {
+                      given_t::dbus_reflection;
+                      requires std::invocable<decltype(given_t::dbus_reflection), given_t&&>;
+                    };
+}  // namespace concepts
+
+namespace schema {
+static constexpr std::uint64_t fnv_offset{ 0xcbf29ce484222325ULL };
+static constexpr std::uint64_t fnv_prime{ 0x100000001b3ULL };
+
+enum struct kind_e : std::uint8_t {
+  boolean = 1,
+  signed_integer,
+  unsigned_integer,
+  floating_point,
+  enumeration,
+  array,
+  quantity,
+  record_begin,
+  record_end,
+  opaque,
+};
+
+/// \brief FNV-1a of the little endian bytes of value
+constexpr auto mix(std::uint64_t hash, std::uint64_t value) noexcept -> std::uint64_t {
+  for (std::size_t idx = 0; idx < sizeof(value); idx++) {
+    hash ^= (value >> (8 * idx)) & 0xffU;
+    hash *= fnv_prime;
+  }
+  return hash;
+}
+constexpr auto mix(std::uint64_t hash, kind_e kind) noexcept -> std::uint64_t {
+  return mix(hash, std::to_underlying(kind));
+}
+
+template <typename>
+struct is_std_array : std::false_type {};
+template <typename element_t, std::size_t size>
+struct is_std_array<std::array<element_t, size>> : std::true_type {};
+
+template <typename record_t>
+constexpr auto mix_record(std::uint64_t hash) noexcept -> std::uint64_t;
+
+template <typename member_t>
+constexpr auto mix_member(std::uint64_t hash) noexcept -> std::uint64_t {
+  if constexpr (std::same_as<member_t, bool>) {
+    return mix(hash, kind_e::boolean);
+  } else if constexpr (std::is_enum_v<member_t>) {
+    return mix_member<std::underlying_type_t<member_t>>(mix(hash, kind_e::enumeration));
+  } else if constexpr (std::signed_integral<member_t>) {
+    return mix(mix(hash, kind_e::signed_integer), sizeof(member_t));
+  } else if constexpr (std::unsigned_integral<member_t>) {
+    return mix(mix(hash, kind_e::unsigned_integer), sizeof(member_t));
+  } else if constexpr (std::floating_point<member_t>) {
+    return mix(mix(hash, kind_e::floating_point), sizeof(member_t));
+  } else if constexpr (is_std_array<member_t>::value) {
+    return mix_member<typename member_t::value_type>(mix(mix(hash, kind_e::array), std::tuple_size_v<member_t>));
+  } else if constexpr (mp_units::Quantity<member_t>) {
+    // the unit is not part of the hash, only its representation
+    return mix_member<typename member_t::rep>(mix(hash, kind_e::quantity));
+  } else if constexpr (concepts::is_record<member_t>) {
+    return mix_record<member_t>(hash);
+  } else {
+    return mix(mix(hash, kind_e::opaque), sizeof(member_t));
+  }
+}
+
+template <typename record_t>
+constexpr auto mix_record(std::uint64_t hash) noexcept -> std::uint64_t {
+  using members_t = decltype(record_t::dbus_reflection(record_t{}));
+  hash = mix(mix(mix(hash, kind_e::record_begin), sizeof(record_t)), alignof(record_t));
+  [&hash]<std::size_t... idx>(std::index_sequence<idx...>) {
+    ((hash = mix_member<std::remove_cvref_t<std::tuple_element_t<idx, members_t>>>(hash)), ...);
+  }(std::make_index_sequence<std::tuple_size_v<members_t>>{});
+  return mix(hash, kind_e::record_end);
+}
+}  // namespace schema
+
+/// \brief hash of the member layout of a record, sent in front of its bytes so a slot rejects values of another layout
+/// Member names and units are not part of the hash, renaming a member keeps the record compatible.
+/// TODO: register the json schema of the record with the ipc-ruler, the ruler only stores the type as _struct so far
+/// and tooling reads the schema from the Type property on D-Bus. Needs a schema column in the ruler database and
+/// RegisterSignal/RegisterSlot calls carrying it.
+template <concepts::is_record record_t>
+inline constexpr std::uint64_t schema_hash_v{ schema::mix_record<record_t>(schema::fnv_offset) };
+
+namespace wire {
+/// \return bytes member_t takes on the wire, members are written back to back without the padding of the struct
+template <typename member_t>
+consteval auto packed_size() noexcept -> std::size_t {
+  if constexpr (schema::is_std_array<member_t>::value) {
+    return std::tuple_size_v<member_t> * packed_size<typename member_t::value_type>();
+  } else if constexpr (mp_units::Quantity<member_t>) {
+    return sizeof(typename member_t::rep);
+  } else if constexpr (concepts::is_record<member_t>) {
+    using members_t = decltype(member_t::dbus_reflection(member_t{}));
+    return []<std::size_t... idx>(std::index_sequence<idx...>) {
+      return (std::size_t{} + ... + packed_size<std::remove_cvref_t<std::tuple_element_t<idx, members_t>>>());
+    }(std::make_index_sequence<std::tuple_size_v<members_t>>{});
+  } else {
+    return sizeof(member_t);
+  }
+}
+
+/// \brief member without padding, copied as a whole
+template <typename member_t>
+concept is_copied_whole = std::is_arithmetic_v<member_t> || std::is_enum_v<member_t> || mp_units::Quantity<member_t> ||
+                          (schema::is_std_array<member_t>::value &&
+                           packed_size<member_t>() == sizeof(member_t) &&
+                           (std::is_arithmetic_v<typename member_t::value_type> ||
+                            std::is_enum_v<typename member_t::value_type>));
+
+/// \brief write the members listed by dbus_reflection to out, each as its own bytes
+/// \return end of the written bytes
+template <typename member_t>
+auto write(member_t const& member, std::byte* out) noexcept -> std::byte* {
+  if constexpr (is_copied_whole<member_t>) {
+    static_assert(packed_size<member_t>() == sizeof(member_t), "a quantity is expected to hold only its value");
+    std::memcpy(out, &member, packed_size<member_t>());
+    return out + packed_size<member_t>();
+  } else if constexpr (schema::is_std_array<member_t>::value) {
+    for (auto const& element : member) {
+      out = write(element, out);
+    }
+    return out;
+  } else if constexpr (concepts::is_record<member_t>) {
+    std::apply([&out](auto const&... members) { ((out = write(members, out)), ...); }, member_t::dbus_reflection(member));
+    return out;
+  } else {
+    static_assert(std::has_unique_object_representations_v<member_t>,
+                  "members which are not reflected must not have padding, it would be sent uninitialized");
+    std::memcpy(out, &member, sizeof(member_t));
+    return out + sizeof(member_t);
+  }
+}
+
+/// \brief read the members listed by dbus_reflection from in, the counterpart of write
+/// The reflection lists every member in declaration order, as for sdbusplus, so the record is aggregate initialized.
+/// \return end of the read bytes
+template <typename member_t>
+auto read(std::byte const* in, member_t& member) noexcept -> std::byte const* {
+  if constexpr (is_copied_whole<member_t>) {
+    std::memcpy(&member, in, packed_size<member_t>());
+    return in + packed_size<member_t>();
+  } else if constexpr (schema::is_std_array<member_t>::value) {
+    for (auto& element : member) {
+      in = read(in, element);
+    }
+    return in;
+  } else if constexpr (concepts::is_record<member_t>) {
+    // dbus_reflection may return copies of the members, the record is built from the values read in member order
+    using reflected_t = decltype(member_t::dbus_reflection(member_t{}));
+    auto members{ []<std::size_t... idx>(std::index_sequence<idx...>) {
+      return std::tuple<std::remove_cvref_t<std::tuple_element_t<idx, reflected_t>>...>{};
+    }(std::make_index_sequence<std::tuple_size_v<reflected_t>>{}) };
+    std::apply([&in](auto&... values) { ((in = read(in, values)), ...); }, members);
+    member = std::make_from_tuple<member_t>(std::move(members));
+    return in;
+  } else {
+    std::memcpy(&member, in, sizeof(member_t));
+    return in + sizeof(member_t);
+  }
+}
+}  // namespace wire
+
+/// \brief bytes a record takes on the wire after its schema hash, independent of the padding the ABI adds
+template <concepts::is_record record_t>
+inline constexpr std::size_t packed_size_v{ wire::packed_size<record_t>() };
+
+}  // namespace tfc::ipc::details
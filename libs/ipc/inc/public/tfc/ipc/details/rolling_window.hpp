@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <set>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace tfc::ipc::details {
+
+/// \brief fixed capacity buffer of the most recent values, storage is allocated once on construction
+template <typename value_t>
+class ring_buffer {
+public:
+  explicit ring_buffer(std::size_t capacity) : storage_(std::max<std::size_t>(capacity, 1)) {}
+
+  /// \brief append value
+  /// \return the oldest value when it was evicted to make room
+  auto push(value_t value) -> std::optional<value_t> {
+    if (size_ < storage_.size()) {
+      storage_[size_++] = std::move(value);
+      return std::nullopt;
+    }
+    std::optional<value_t> evicted{ std::exchange(storage_[head_], std::move(value)) };
+    head_ = (head_ + 1) % storage_.size();
+    return evicted;
+  }
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return storage_.size(); }
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+  [[nodiscard]] auto full() const noexcept -> bool { return size_ == storage_.size(); }
+  /// \return true when the next push overwrites the first slot of the storage
+  [[nodiscard]] auto wrapped() const noexcept -> bool { return full() && head_ == 0; }
+
+  /// \return the stored values in unspecified order
+  [[nodiscard]] auto values() const noexcept -> std::span<value_t const> { return { storage_.data(), size_ }; }
+
+private:
+  std::vector<value_t> storage_;
+  std::size_t head_{};
+  std::size_t size_{};
+};
+
+/**@brief
+ * Sliding window answering order statistics (median, quantiles) of its samples in O(log n) per sample.
+ * The samples are split in two ordered sets where every sample in `low_` is less than or equal to every sample in
+ * `high_`, the requested rank is the largest sample of `low_`. The node of the evicted sample is reused for the
+ * incoming one, so a full window does not allocate.
+ * */
+class order_statistic_window {
+public:
+  explicit order_statistic_window(std::size_t capacity) : arrival_{ capacity } {}
+
+  void push(double sample) {
+    std::multiset<double>::node_type node{};
+    if (auto evicted{ arrival_.push(sample) }) {
+      node = extract(evicted.value());
+    }
+    auto& target{ !low_.empty() && sample <= *low_.rbegin() ? low_ : high_ };
+    if (node) {
+      node.value() = sample;
+      target.insert(std::move(node));
+    } else {
+      target.emplace(sample);
+    }
+  }
+
+  /// \return the sample at rank (0 is the smallest), the window must not be empty
+  [[nodiscard]] auto at_rank(std::size_t rank) -> double {
+    assert(rank < size());
+    while (low_.size() > rank + 1) {
+      high_.insert(low_.extract(std::prev(low_.end())));
+    }
+    while (low_.size() < rank + 1) {
+      low_.insert(high_.extract(high_.begin()));
+    }
+    return *low_.rbegin();
+  }
+
+  /// \return the median, the mean of the two middle samples for an even number of samples
+  [[nodiscard]] auto median() -> double {
+    auto const lower{ at_rank((size() - 1) / 2) };
+    if (size() % 2 == 1) {
+      return lower;
+    }
+    return (lower + *high_.begin()) / 2;
+  }
+
+  /// \return the sample below which the given fraction [0, 1] of the samples lie
+  [[nodiscard]] auto quantile(double fraction) -> double {
+    auto const position{ std::ceil(static_cast<double>(size()) * std::clamp(fraction, 0.0, 1.0)) };
+    return at_rank(std::clamp<std::size_t>(static_cast<std::size_t>(std::max(position, 1.0)) - 1, 0, size() - 1));
+  }
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return arrival_.capacity(); }
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return arrival_.size(); }
+
+private:
+  auto extract(double sample) -> std::multiset<double>::node_type {
+    auto& source{ !low_.empty() && sample <= *low_.rbegin() ? low_ : high_ };
+    auto iter{ source.find(sample) };
+    assert(iter != source.end());
+    return source.extract(iter);
+  }
+
+  ring_buffer<double> arrival_;
+  std::multiset<double> low_{};
+  std::multiset<double> high_{};
+};
+
+}  // namespace tfc::ipc::details
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+#include <tfc/ipc/packet.hpp>
+
+namespace tfc::ipc::details {
+
+/**@brief
+ * Pool of serialization buffers owned by a single signal.
+ * Buffers retain their capacity when returned to the pool, so once the pool has
+ * warmed up sending a value of the same or smaller size does not allocate.
+ * A buffer is checked out for the lifetime of a single (async) send and returned
+ * on its completion, which allows multiple sends to be in flight at once.
+ * */
+class send_buffer_pool {
+public:
+  using buffer_t = std::vector<std::byte>;
+  using handle_t = std::unique_ptr<buffer_t>;
+
+  /// \param initial_capacity bytes reserved for each newly created buffer
+  explicit send_buffer_pool(std::size_t initial_capacity) : initial_capacity_{ initial_capacity } {
+    free_.reserve(free_list_reserve);
+  }
+
+  /// \return a buffer from the pool, a new one is allocated if none are free
+  [[nodiscard]] auto acquire() -> handle_t {
+    if (free_.empty()) {
+      allocations_++;
+      auto buffer{ std::make_unique<buffer_t>() };
+      buffer->reserve(initial_capacity_);
+      return buffer;
+    }
+    auto buffer{ std::move(free_.back()) };
+    free_.pop_back();
+    return buffer;
+  }
+
+  /// \brief give buffer back to the pool, its capacity is kept for the next send
+  void release(handle_t&& buffer) {
+    if (!buffer) {
+      return;
+    }
+    if (free_.size() == free_.capacity()) {
+      allocations_++;
+    }
+    free_.emplace_back(std::move(buffer));
+  }
+
+  /// \brief serialize value into buffer, reusing its capacity
+  template <typename packet_t>
+  auto serialize(buffer_t& buffer, typename packet_t::value_t const& value, wire_format format = {}) -> std::error_code {
+    auto const capacity{ buffer.capacity() };
+    buffer.clear();
+    auto err{ packet_t::serialize(value, buffer, format) };
+    if (buffer.capacity() != capacity) {
+      allocations_++;
+    }
+    return err;
+  }
+
+  /// \return number of buffers this pool created or grew, the pool misses, constant in steady state
+  [[nodiscard]] auto allocations() const noexcept -> std::size_t { return allocations_; }
+
+private:
+  static constexpr std::size_t free_list_reserve{ 4 };
+  std::size_t initial_capacity_{};
+  std::size_t allocations_{};
+  std::vector<handle_t> free_{};
+};
+
+}  // namespace tfc::ipc::details
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+namespace tfc::ipc::details::shm {
+
+/// \return name of the shared memory object backing the given signal
+/// \param signal_name full name of signal, <exe>.<proc>.<type>.<name>
+[[nodiscard]] inline auto segment_name(std::string_view signal_name) -> std::string {
+  return fmt::format("/tfc.{}", signal_name);
+}
+
+/**@brief
+ * Layout at the start of a shared memory segment, followed by `capacity` bytes of payload.
+ * The payload is a serialized packet guarded by a seqlock, `sequence` is odd while the writer
+ * is updating the payload and even when it is consistent. `sequence` doubles as the futex word
+ * readers sleep on.
+ * */
+struct segment_header {
+  static constexpr std::uint32_t magic_v{ 0x74666373 };  // "tfcs"
+  std::uint32_t magic{ magic_v };
+  std::atomic<std::uint32_t> sequence{};
+  std::atomic<std::uint32_t> waiters{};
+  std::atomic<std::uint32_t> closed{};
+  std::atomic<std::uint64_t> capacity{};
+  std::atomic<std::uint64_t> size{};
+};
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free);
+
+static constexpr std::size_t default_capacity{ 4096 };
+
+inline void futex_wake(std::atomic<std::uint32_t>& word) {
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+/// \brief sleep while word equals expected, returns on change, spurious wakeup or timeout
+inline void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected, std::chrono::nanoseconds timeout) {
+  auto const secs{ std::chrono::duration_cast<std::chrono::seconds>(timeout) };
+  timespec const spec{ .tv_sec = secs.count(), .tv_nsec = (timeout - secs).count() };
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, &spec, nullptr, 0);
+}
+
+/**@brief
+ * RAII owner of an mmap'ed shared memory object
+ * */
+class mapping {
+public:
+  mapping() = default;
+  mapping(int file_descriptor, std::size_t bytes) : fd_{ file_descriptor }, bytes_{ bytes } {}
+  mapping(mapping const&) = delete;
+  auto operator=(mapping const&) -> mapping& = delete;
+  mapping(mapping&& other) noexcept
+      : fd_{ std::exchange(other.fd_, -1) }, bytes_{ std::exchange(other.bytes_, 0) },
+        addr_{ std::exchange(other.addr_, nullptr) } {}
+  auto operator=(mapping&& other) noexcept -> mapping& {
+    if (this != &other) {
+      reset();
+      fd_ = std::exchange(other.fd_, -1);
+      bytes_ = std::exchange(other.bytes_, 0);
+      addr_ = std::exchange(other.addr_, nullptr);
+    }
+    return *this;
+  }
+  ~mapping() { reset(); }
+
+  /// \brief map (or remap) the first `bytes` of the shared memory object
+  auto map(std::size_t bytes) -> std::error_code {
+    void* addr{};
+    if (addr_ == nullptr) {
+      addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    } else {
+      addr = mremap(addr_, bytes_, bytes, MREMAP_MAYMOVE);
+    }
+    if (addr == MAP_FAILED) {
+      return { errno, std::system_category() };
+    }
+    addr_ = addr;
+    bytes_ = bytes;
+    return {};
+  }
+
+  [[nodiscard]] auto fd() const noexcept -> int { return fd_; }
+  [[nodiscard]] auto header() const noexcept -> segment_header* { return static_cast<segment_header*>(addr_); }
+  [[nodiscard]] auto payload() const noexcept -> std::byte* { return static_cast<std::byte*>(addr_) + sizeof(segment_header); }
+  [[nodiscard]] auto mapped_capacity() const noexcept -> std::size_t {
+    return bytes_ > sizeof(segment_header) ? bytes_ - sizeof(segment_header) : 0;
+  }
+
+private:
+  void reset() noexcept {
+    if (addr_ != nullptr) {
+      munmap(addr_, bytes_);
+      addr_ = nullptr;
+    }
+    if (fd_ != -1) {
+      close(fd_);
+      fd_ = -1;
+    }
+  }
+  int fd_{ -1 };
+  std::size_t bytes_{};
+  void* addr_{ nullptr };
+};
+
+/**@brief
+ * Single producer side of a shared memory segment, owned by a signal.
+ * Publishing is a memcpy between two sequence stores, a futex wake is only
+ * issued when a reader is sleeping on the segment.
+ * */
+class writer {
+public:
+  [[nodiscard]] static auto create(std::string_view signal_name, std::size_t capacity = default_capacity)
+      -> std::expected<writer, std::error_code> {
+    std::string name{ segment_name(signal_name) };
+    shm_unlink(name.c_str());  // stale segment of a previous instance, readers of it will reopen once it is closed
+    int const file_descriptor{ shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP) };
+    if (file_descriptor == -1) {
+      return std::unexpected(std::error_code{ errno, std::system_category() });
+    }
+    writer result{ std::move(name), mapping{ file_descriptor, 0 } };
+    if (auto err{ result.resize(capacity) }) {
+      return std::unexpected(err);
+    }
+    new (result.mapping_.header()) segment_header{};
+    result.mapping_.header()->capacity.store(result.mapping_.mapped_capacity(), std::memory_order_release);
+    return result;
+  }
+
+  writer(writer const&) = delete;
+  auto operator=(writer const&) -> writer& = delete;
+  writer(writer&&) noexcept = default;
+  auto operator=(writer&&) noexcept -> writer& = default;
+  ~writer() {
+    if (auto* header{ mapping_.header() }) {
+      header->closed.store(1, std::memory_order_release);
+      header->sequence.fetch_add(2, std::memory_order_release);
+      futex_wake(header->sequence);
+      shm_unlink(name_.c_str());
+    }
+  }
+
+  /// \brief publish serialized packet to readers, grows the segment if needed
+  auto write(std::span<std::byte const> payload) -> std::error_code {
+    auto* header{ mapping_.header() };
+    if (payload.size() > mapping_.mapped_capacity()) {
+      if (auto err{ resize(std::max(payload.size(), mapping_.mapped_capacity() * 2)) }) {
+        return err;
+      }
+      header = mapping_.header();
+      header->capacity.store(mapping_.mapped_capacity(), std::memory_order_release);
+    }
+    auto const sequence{ header->sequence.load(std::memory_order_relaxed) };
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(mapping_.payload(), payload.data(), payload.size());
+    header->size.store(payload.size(), std::memory_order_relaxed);
+    header->sequence.store(sequence + 2, std::memory_order_release);
+    // Keeps the sequence store ahead of the waiters load, pairs with the fence in reader::wait. Without it a reader
+    // registering as a waiter could miss the new sequence while we miss its registration, and it sleeps a full timeout.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->waiters.load(std::memory_order_relaxed) > 0) {
+      futex_wake(header->sequence);
+    }
+    return {};
+  }
+
+  [[nodiscard]] auto name() const noexcept -> std::string_view { return name_; }
+
+private:
+  writer(std::string&& name, mapping&& map) : name_{ std::move(name) }, mapping_{ std::move(map) } {}
+
+  auto resize(std::size_t capacity) -> std::error_code {
+    auto const bytes{ sizeof(segment_header) + capacity };
+    if (ftruncate(mapping_.fd(), static_cast<off_t>(bytes)) == -1) {
+      return { errno, std::system_category() };
+    }
+    return mapping_.map(bytes);
+  }
+
+  std::string name_;
+  mapping mapping_;
+};
+
+/**@brief
+ * Consumer side of a shared memory segment, any number of readers may attach to one writer.
+ * Reading does not enter the kernel, waiting for a new value sleeps on the sequence futex.
+ * */
+class reader {
+public:
+  reader() = default;
+
+  /// \brief attach to the segment of signal_name, fails if the signal has not enabled the shm transport
+  auto open(std::string_view signal_name) -> std::error_code {
+    std::string const name{ segment_name(signal_name) };
+    int const file_descriptor{ shm_open(name.c_str(), O_RDWR, 0) };
+    if (file_descriptor == -1) {
+      return { errno, std::system_category() };
+    }
+    struct stat info {};
+    if (fstat(file_descriptor, &info) == -1 || static_cast<std::size_t>(info.st_size) < sizeof(segment_header)) {
+      close(file_descriptor);
+      return std::make_error_code(std::errc::no_such_device);
+    }
+    mapping map{ file_descriptor, 0 };
+    if (auto err{ map.map(static_cast<std::size_t>(info.st_size)) }) {
+      return err;
+    }
+    if (map.header()->magic != segment_header::magic_v) {
+      return std::make_error_code(std::errc::wrong_protocol_type);
+    }
+    mapping_ = std::move(map);
+    last_sequence_ = 0;
+    return {};
+  }
+
+  [[nodiscard]] auto is_open() const noexcept -> bool { return mapping_.header() != nullptr; }
+
+  /// \return true if the writer has gone away, the segment should be reopened
+  [[nodiscard]] auto closed() const noexcept -> bool {
+    return !is_open() || mapping_.header()->closed.load(std::memory_order_acquire) != 0;
+  }
+
+  /// \brief copy the latest value into buffer if it has changed since the previous read
+  /// \return true if buffer holds a new value
+  auto try_read(std::vector<std::byte>& buffer) -> bool {
+    auto* header{ mapping_.header() };
+    for (std::size_t attempt = 0; attempt < max_read_attempts; attempt++) {
+      auto const sequence{ header->sequence.load(std::memory_order_acquire) };
+      if (sequence == last_sequence_ || header->closed.load(std::memory_order_relaxed) != 0) {
+        return false;
+      }
+      if ((sequence & 1U) != 0) {
+        continue;  // writer is mid update
+      }
+      if (header->capacity.load(std::memory_order_acquire) > mapping_.mapped_capacity()) {
+        if (mapping_.map(sizeof(segment_header) + header->capacity.load(std::memory_order_acquire))) {
+          return false;
+        }
+        header = mapping_.header();
+      }
+      auto const size{ std::min<std::size_t>(header->size.load(std::memory_order_relaxed), mapping_.mapped_capacity()) };
+      buffer.resize(size);
+      std::memcpy(buffer.data(), mapping_.payload(), size);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (header->sequence.load(std::memory_order_relaxed) == sequence) {
+        last_sequence_ = sequence;
+        return true;
+      }
+    }
+    return false;  // writer died mid update or is publishing faster than we can copy, retried on next wakeup
+  }
+
+  /// \brief sleep until the writer publishes past the last read value or timeout elapses
+  void wait(std::chrono::nanoseconds timeout) {
+    auto* header{ mapping_.header() };
+    header->waiters.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in writer::write, either the writer sees us waiting or the futex sees its new sequence
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    futex_wait(header->sequence, last_sequence_, timeout);
+    header->waiters.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  /// \brief wake any thread sleeping in wait on this segment, used to interrupt a reader on shutdown
+  /// \note must not run concurrently with open or try_read, which may remap the segment
+  void notify() const {
+    if (is_open()) {
+      futex_wake(mapping_.header()->sequence);
+    }
+  }
+
+private:
+  static constexpr std::size_t max_read_attempts{ 1024 };
+  mapping mapping_{};
+  std::uint32_t last_sequence_{};
+};
+
+}  // namespace tfc::ipc::details::shm
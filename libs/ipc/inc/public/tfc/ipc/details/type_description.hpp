@@ -7,6 +7,7 @@
 
 #include <mp-units/systems/si.h>
 
+#include <tfc/ipc/details/record.hpp>
 #include <tfc/ipc/enums.hpp>
 #include <tfc/stx/concepts.hpp>
 
@@ -16,8 +17,8 @@ namespace concepts {
 using stx::is_any_of;
 using stx::is_expected_quantity;
 template <typename given_t>
-concept is_supported_type =
-    is_any_of<given_t, bool, std::int64_t, std::uint64_t, double, std::string> || is_expected_quantity<given_t>;
+concept is_supported_type = is_any_of<given_t, bool, std::int64_t, std::uint64_t, double, std::string> ||
+                            is_expected_quantity<given_t> || is_record<given_t>;
 }  // namespace concepts
 
 template <concepts::is_supported_type value_type, type_e type_enum>
@@ -48,5 +49,9 @@ using voltage_t = std::expected<mp_units::quantity<mp_units::si::nano<mp_units::
 using type_voltage = type_description<voltage_t, type_e::_voltage>;
 using current_t = std::expected<mp_units::quantity<mp_units::si::nano<mp_units::si::ampere>, std::int64_t>, current_error_e>;
 using type_current = type_description<current_t, type_e::_current>;
+/// \brief fixed layout struct sent as its raw bytes, subscribers read the fields without parsing
+/// \example tfc::ipc::signal<tfc::ipc::details::type_record<axis_state>>
+template <concepts::is_record record_t>
+using type_record = type_description<record_t, type_e::_struct>;
 
 }  // namespace tfc::ipc::details
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <string_view>
@@ -15,8 +16,17 @@ enum struct direction_e : std::uint8_t {
   slot = 2,
 };
 
+/// \brief Transport used between a signal and its connected slots
+/// \note zmq is always available, shm is an opt-in same host fast path which falls back to zmq
+enum struct transport_e : std::uint8_t {
+  zmq = 0,
+  shm = 1,
+};
+
 /// \brief Finite set of types which can be sent over this protocol
 /// \note _json is sent as packet<std::string, _json>
+/// \note _struct is the family of fixed layout records, see type_record, the concrete record is told apart by the
+/// schema hash leading its value
 enum struct type_e : std::uint8_t {
   unknown = 0,
   _bool = 1,          // NOLINT
@@ -31,6 +41,7 @@ enum struct type_e : std::uint8_t {
   _temperature = 10,  // NOLINT
   _voltage = 11,      // NOLINT
   _current = 12,      // NOLINT
+  _struct = 13,       // NOLINT
   // TODO: Add
   //  Standard units
   //  _duration = 7,
@@ -39,15 +50,26 @@ enum struct type_e : std::uint8_t {
   //  _humitidy = 11,
 };
 
-static constexpr std::array<std::string_view, 13> type_e_iterable{ "unknown",     "bool",    "i64",    "u64",    "double",
-                                                                   "string",      "json",    "mass",   "length", "pressure",
-                                                                   "temperature", "voltage", "current" };
+static constexpr std::array<std::string_view, 14> type_e_iterable{ "unknown",     "bool",    "i64",     "u64",    "double",
+                                                                   "string",      "json",    "mass",    "length", "pressure",
+                                                                   "temperature", "voltage", "current", "struct" };
 
 auto constexpr enum_name(type_e type) -> std::string_view {
   return type_e_iterable[std::to_underlying(type)];
 }
 
+/// \brief type of a type name or of a full signal name, a dot separated segment naming a type is preferred
+/// so a name like "exe.proc.bool.construct" is a bool
 auto constexpr enum_cast(std::string_view name) -> type_e {
+  for (std::size_t begin = 0; begin <= name.size();) {
+    auto const end{ std::min(name.find('.', begin), name.size()) };
+    for (std::size_t idx = 1; idx < type_e_iterable.size(); idx++) {
+      if (name.substr(begin, end - begin) == type_e_iterable[idx]) {
+        return static_cast<type_e>(idx);
+      }
+    }
+    begin = end + 1;
+  }
   for (std::size_t idx = type_e_iterable.size() - 1; idx > 0; idx--) {
     if (name.contains(type_e_iterable[idx])) {
       return static_cast<type_e>(idx);
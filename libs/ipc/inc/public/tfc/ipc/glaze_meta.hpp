@@ -43,7 +43,8 @@ struct meta<tfc::ipc::details::type_e> {
     tfc::ipc::details::type_e_iterable[std::to_underlying(_pressure)], _pressure, "Pressure in millipascals",
     tfc::ipc::details::type_e_iterable[std::to_underlying(_temperature)], _temperature, "Temperature in microcelsius",
     tfc::ipc::details::type_e_iterable[std::to_underlying(_voltage)], _voltage, "Potential in nanovolts",
-    tfc::ipc::details::type_e_iterable[std::to_underlying(_current)], _current, "Current in nanoamperes"
+    tfc::ipc::details::type_e_iterable[std::to_underlying(_current)], _current, "Current in nanoamperes",
+    tfc::ipc::details::type_e_iterable[std::to_underlying(_struct)], _struct, "Fixed layout struct sent as raw bytes"
   ) };
   // clang-format on
 };
@@ -2,11 +2,14 @@
 
 #include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <expected>
 #include <optional>
 #include <random>
+#include <span>
 #include <string>
+#include <system_error>
 #include <vector>
 
 #include <mp-units/systems/angular.h>
@@ -212,6 +215,9 @@ struct item {
 
   [[nodiscard]] static auto from_json(std::string_view json) -> std::expected<item, glz::error_ctx>;
   [[nodiscard]] auto to_json() const -> std::expected<std::string, glz::error_ctx>;
+  /// \brief compact binary encoding, see tfc/ipc/item_binary.hpp to read single fields without decoding the item
+  [[nodiscard]] static auto from_binary(std::span<std::byte const> bytes) -> std::expected<item, std::error_code>;
+  [[nodiscard]] auto to_binary() const -> std::vector<std::byte>;
   [[nodiscard]] auto id() const -> std::string;
 
   // ids
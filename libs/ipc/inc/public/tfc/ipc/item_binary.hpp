@@ -0,0 +1,518 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <tfc/ipc/item.hpp>
+#include <tfc/ipc/packet.hpp>
+#include <tfc/stx/concepts.hpp>
+
+namespace tfc::ipc::item::binary {
+
+/**@brief
+ * Compact binary encoding of an item, little endian
+ * | version (1) | presence mask (u32, bit n is set if field n has a value) | value of every present field |
+ * Values follow in field_e order. Fixed size values are written raw, quantities and time points as their number.
+ * Strings and the supplier are prefixed by their LEB128 varint length.
+ * items is prefixed by its u32 length and holds a varint count followed by every child as its u32 length and its own
+ * encoding, so children can be skipped or viewed without decoding them.
+ * Fields are only ever appended, an encoding with a bit this version does not know is rejected.
+ * */
+enum struct field_e : std::uint8_t {
+  item_id = 0,
+  batch_id,
+  barcode,
+  qr_code,
+  category,
+  fao_species,
+  sub_type,
+  item_weight,
+  target_weight,
+  min_weight,
+  max_weight,
+  length,
+  width,
+  height,
+  area,
+  volume,
+  temperature,
+  angle,
+  color,
+  quality,
+  entry_timestamp,
+  production_date,
+  expiration_date,
+  last_exchange,
+  description,
+  supplier,
+  destination,
+  items,
+};
+
+static constexpr std::uint8_t version{ 1 };
+static constexpr std::size_t header_size{ sizeof(version) + sizeof(std::uint32_t) };
+
+// clang-format off
+/// \brief member of every field_e, in order
+inline constexpr auto members{ std::make_tuple(
+    &item::item_id, &item::batch_id, &item::barcode, &item::qr_code, &item::category, &item::fao_species, &item::sub_type,
+    &item::item_weight, &item::target_weight, &item::min_weight, &item::max_weight, &item::length, &item::width,
+    &item::height, &item::area, &item::volume, &item::temperature, &item::angle, &item::color, &item::quality,
+    &item::entry_timestamp, &item::production_date, &item::expiration_date, &item::last_exchange, &item::description,
+    &item::supplier, &item::destination, &item::items) };
+// clang-format on
+static constexpr std::size_t field_count{ std::tuple_size_v<decltype(members)> };
+static_assert(field_count == std::to_underlying(field_e::items) + 1);
+static_assert(field_count <= 32, "the presence mask is 32 bits");
+
+/// \brief value type of the optional member of field
+template <field_e field>
+using member_t =
+    typename std::remove_cvref_t<decltype(std::declval<item>().*std::get<std::to_underlying(field)>(members))>::value_type;
+
+namespace detail {
+template <typename value_t>
+concept variable_size = stx::is_any_of<value_t, std::string, details::supplier, std::vector<item>>;
+
+template <typename>
+struct is_time_point : std::false_type {};
+template <typename clock_t, typename duration_t>
+struct is_time_point<std::chrono::time_point<clock_t, duration_t>> : std::true_type {};
+
+template <typename value_t>
+  requires(!variable_size<value_t>)
+constexpr auto fixed_size() noexcept -> std::size_t {
+  if constexpr (std::same_as<value_t, uuids::uuid>) {
+    return 16;
+  } else if constexpr (std::is_enum_v<value_t>) {
+    return sizeof(value_t);
+  } else if constexpr (std::same_as<value_t, fao::species>) {
+    return 4;  // outside_spec and the three letters
+  } else if constexpr (std::same_as<value_t, details::color>) {
+    return 3;
+  } else if constexpr (std::same_as<value_t, details::destination>) {
+    return 0;
+  } else if constexpr (mp_units::Quantity<value_t>) {
+    return sizeof(typename value_t::rep);
+  } else {
+    static_assert(is_time_point<value_t>::value, "field type has no binary encoding");
+    return sizeof(typename value_t::rep);
+  }
+}
+
+inline void append(std::vector<std::byte>& buffer, void const* data, std::size_t size) {
+  auto const offset{ buffer.size() };
+  buffer.resize(offset + size);
+  if (size > 0) {
+    std::memcpy(buffer.data() + offset, data, size);
+  }
+}
+
+inline void append_varint(std::vector<std::byte>& buffer, std::uint64_t value) {
+  auto const offset{ buffer.size() };
+  buffer.resize(offset + ipc::details::wire_v1::varint_size(value));
+  ipc::details::wire_v1::write_varint(buffer.data() + offset, value);
+}
+
+inline void append_string(std::vector<std::byte>& buffer, std::string_view value) {
+  append_varint(buffer, value.size());
+  append(buffer, value.data(), value.size());
+}
+
+/// \brief reserve a u32 length, returns its offset for patch_length
+inline auto reserve_length(std::vector<std::byte>& buffer) -> std::size_t {
+  auto const offset{ buffer.size() };
+  buffer.resize(offset + sizeof(std::uint32_t));
+  return offset;
+}
+
+inline void patch_length(std::vector<std::byte>& buffer, std::size_t offset) {
+  auto const length{ static_cast<std::uint32_t>(buffer.size() - offset - sizeof(std::uint32_t)) };
+  std::memcpy(buffer.data() + offset, &length, sizeof(length));
+}
+
+/// \brief read a varint prefixed string from the front of input and advance input past it
+inline auto take_string(std::span<std::byte const>& input) -> std::optional<std::string_view> {
+  std::uint64_t size{};
+  auto const varint_size{ ipc::details::wire_v1::read_varint(input, size) };
+  if (varint_size == 0 || size > input.size() - varint_size) {
+    return std::nullopt;
+  }
+  std::string_view const result{ reinterpret_cast<char const*>(input.data() + varint_size), static_cast<std::size_t>(size) };
+  input = input.subspan(varint_size + size);
+  return result;
+}
+
+inline auto take_length(std::span<std::byte const>& input) -> std::optional<std::span<std::byte const>> {
+  std::uint32_t length{};
+  if (input.size() < sizeof(length)) {
+    return std::nullopt;
+  }
+  std::memcpy(&length, input.data(), sizeof(length));
+  if (length > input.size() - sizeof(length)) {
+    return std::nullopt;
+  }
+  auto const result{ input.subspan(sizeof(length), length) };
+  input = input.subspan(sizeof(length) + length);
+  return result;
+}
+
+template <typename value_t>
+  requires(!variable_size<value_t>)
+void write(std::vector<std::byte>& buffer, value_t const& value) {
+  if constexpr (std::same_as<value_t, uuids::uuid>) {
+    append(buffer, value.as_bytes().data(), fixed_size<value_t>());
+  } else if constexpr (std::is_enum_v<value_t>) {
+    append(buffer, &value, sizeof(value));
+  } else if constexpr (std::same_as<value_t, fao::species>) {
+    append(buffer, &value.outside_spec, sizeof(value.outside_spec));
+    append(buffer, value.code.data(), value.code.size());
+  } else if constexpr (std::same_as<value_t, details::color>) {
+    std::array const rgb{ value.red, value.green, value.blue };
+    append(buffer, rgb.data(), rgb.size());
+  } else if constexpr (std::same_as<value_t, details::destination>) {
+  } else if constexpr (mp_units::Quantity<value_t>) {
+    auto const number{ value.numerical_value_in(value_t::unit) };
+    append(buffer, &number, sizeof(number));
+  } else {
+    auto const number{ value.time_since_epoch().count() };
+    append(buffer, &number, sizeof(number));
+  }
+}
+
+template <typename value_t>
+  requires(!variable_size<value_t>)
+auto read(std::span<std::byte const> input) -> value_t {
+  if constexpr (std::same_as<value_t, uuids::uuid>) {
+    std::array<std::uint8_t, 16> bytes{};
+    std::memcpy(bytes.data(), input.data(), bytes.size());
+    return uuids::uuid{ bytes };
+  } else if constexpr (std::is_enum_v<value_t>) {
+    value_t result{};
+    std::memcpy(&result, input.data(), sizeof(result));
+    return result;
+  } else if constexpr (std::same_as<value_t, fao::species>) {
+    fao::species result{};
+    result.outside_spec = input.front() != std::byte{ 0 };
+    std::memcpy(result.code.data(), input.data() + 1, result.code.size());
+    return result;
+  } else if constexpr (std::same_as<value_t, details::color>) {
+    return { .red = static_cast<std::uint8_t>(input[0]),
+             .green = static_cast<std::uint8_t>(input[1]),
+             .blue = static_cast<std::uint8_t>(input[2]) };
+  } else if constexpr (std::same_as<value_t, details::destination>) {
+    return {};
+  } else if constexpr (mp_units::Quantity<value_t>) {
+    typename value_t::rep number{};
+    std::memcpy(&number, input.data(), sizeof(number));
+    return number * value_t::reference;
+  } else {
+    typename value_t::rep number{};
+    std::memcpy(&number, input.data(), sizeof(number));
+    return value_t{ typename value_t::duration{ number } };
+  }
+}
+}  // namespace detail
+
+/// \brief append the encoding of value to buffer
+inline void encode(item const& value, std::vector<std::byte>& buffer);
+
+/// \brief lazy range of the children of an encoded item, every child is parsed when it is dereferenced
+class children;
+
+/**@brief
+ * Read only view of an encoded item, nothing is decoded up front.
+ * parse checks the framing of the fields once and remembers where each field starts, get decodes a single field.
+ * Strings are returned as views into the buffer, which must outlive the view.
+ * */
+class view {
+public:
+  /// \brief value type returned by get, strings are not copied and children are not parsed
+  template <field_e field>
+  using value_t = std::conditional_t<
+      std::same_as<member_t<field>, std::string>,
+      std::string_view,
+      std::conditional_t<std::same_as<member_t<field>, std::vector<item>>, children, member_t<field>>>;
+
+  [[nodiscard]] static auto parse(std::span<std::byte const> bytes) -> std::expected<view, std::error_code>;
+
+  [[nodiscard]] auto has(field_e field) const noexcept -> bool { return ((mask_ >> std::to_underlying(field)) & 1U) != 0; }
+
+  /// \return the decoded field, std::nullopt when the item has no value for it
+  template <field_e field>
+  [[nodiscard]] auto get() const -> std::optional<value_t<field>>;
+
+  /// \return the children of the item, empty if it has none
+  [[nodiscard]] auto items() const -> children;
+
+  /// \brief decode every field, children included
+  [[nodiscard]] auto to_item() const -> std::expected<item, std::error_code>;
+
+  [[nodiscard]] auto bytes() const noexcept -> std::span<std::byte const> { return bytes_; }
+
+private:
+  [[nodiscard]] auto field_bytes(field_e field) const noexcept -> std::span<std::byte const> {
+    auto const idx{ std::to_underlying(field) };
+    return bytes_.subspan(offsets_[idx], sizes_[idx]);
+  }
+
+  std::span<std::byte const> bytes_{};
+  std::uint32_t mask_{};
+  std::array<std::uint32_t, field_count> offsets_{};  // start of the value of every present field, after its prefix
+  std::array<std::uint32_t, field_count> sizes_{};
+};
+
+class children {
+public:
+  class iterator {
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = std::expected<view, std::error_code>;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    explicit iterator(std::span<std::byte const> remaining) : remaining_{ remaining } {}
+
+    [[nodiscard]] auto operator*() const -> value_type {
+      auto rest{ remaining_ };
+      return view::parse(detail::take_length(rest).value());  // framing is checked by the parent view
+    }
+    auto operator++() -> iterator& {
+      std::ignore = detail::take_length(remaining_);
+      return *this;
+    }
+    auto operator++(int) -> iterator {
+      auto copy{ *this };
+      ++*this;
+      return copy;
+    }
+    [[nodiscard]] auto operator==(iterator const& rhs) const noexcept -> bool {
+      return remaining_.size() == rhs.remaining_.size();
+    }
+
+  private:
+    std::span<std::byte const> remaining_{};
+  };
+
+  children() = default;
+  children(std::span<std::byte const> framed, std::uint64_t count) : framed_{ framed }, count_{ count } {}
+
+  [[nodiscard]] auto begin() const -> iterator { return iterator{ framed_ }; }
+  [[nodiscard]] auto end() const -> iterator { return iterator{ framed_.last(0) }; }
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return static_cast<std::size_t>(count_); }
+  [[nodiscard]] auto empty() const noexcept -> bool { return count_ == 0; }
+
+private:
+  std::span<std::byte const> framed_{};  // every child as its u32 length and encoding
+  std::uint64_t count_{};
+};
+static_assert(std::forward_iterator<children::iterator>);
+
+inline void encode(item const& value, std::vector<std::byte>& buffer) {
+  auto const start{ buffer.size() };
+  buffer.resize(start + header_size);
+  buffer[start] = std::byte{ version };
+  std::uint32_t mask{};
+  [&]<std::size_t... idx>(std::index_sequence<idx...>) {
+    (
+        [&] {
+          auto const& member{ value.*std::get<idx>(members) };
+          if (!member.has_value()) {
+            return;
+          }
+          mask |= 1U << idx;
+          using member_value_t = std::remove_cvref_t<decltype(member.value())>;
+          if constexpr (std::same_as<member_value_t, std::string>) {
+            detail::append_string(buffer, member.value());
+          } else if constexpr (std::same_as<member_value_t, details::supplier>) {
+            auto const& supplier{ member.value() };
+            std::size_t content_size{};
+            for (std::string_view const text : { supplier.name, supplier.contact_info, supplier.country }) {
+              content_size += ipc::details::wire_v1::varint_size(text.size()) + text.size();
+            }
+            detail::append_varint(buffer, content_size);
+            detail::append_string(buffer, supplier.name);
+            detail::append_string(buffer, supplier.contact_info);
+            detail::append_string(buffer, supplier.country);
+          } else if constexpr (std::same_as<member_value_t, std::vector<item>>) {
+            auto const length{ detail::reserve_length(buffer) };
+            detail::append_varint(buffer, member->size());
+            for (auto const& child : member.value()) {
+              auto const child_length{ detail::reserve_length(buffer) };
+              encode(child, buffer);
+              detail::patch_length(buffer, child_length);
+            }
+            detail::patch_length(buffer, length);
+          } else {
+            detail::write(buffer, member.value());
+          }
+        }(),
+        ...);
+  }(std::make_index_sequence<field_count>{});
+  std::memcpy(buffer.data() + start + sizeof(version), &mask, sizeof(mask));
+}
+
+inline auto view::parse(std::span<std::byte const> bytes) -> std::expected<view, std::error_code> {
+  if (bytes.size() < header_size) {
+    return std::unexpected(std::make_error_code(std::errc::message_size));
+  }
+  if (bytes.front() != std::byte{ version }) {
+    return std::unexpected(std::make_error_code(std::errc::protocol_not_supported));
+  }
+  view result{};
+  result.bytes_ = bytes;
+  std::memcpy(&result.mask_, bytes.data() + sizeof(version), sizeof(result.mask_));
+  if constexpr (field_count < 32) {
+    if ((result.mask_ >> field_count) != 0) {
+      return std::unexpected(std::make_error_code(std::errc::protocol_not_supported));
+    }
+  }
+  auto remaining{ bytes.subspan(header_size) };
+  bool valid{ true };
+  [&]<std::size_t... idx>(std::index_sequence<idx...>) {
+    (
+        [&] {
+          if (!valid || !result.has(static_cast<field_e>(idx))) {
+            return;
+          }
+          using member_value_t = member_t<static_cast<field_e>(idx)>;
+          std::optional<std::span<std::byte const>> value{};
+          if constexpr (std::same_as<member_value_t, std::string> || std::same_as<member_value_t, details::supplier>) {
+            auto const content{ detail::take_string(remaining) };
+            if (content.has_value()) {
+              value = std::as_bytes(std::span{ content->data(), content->size() });
+            }
+            if constexpr (std::same_as<member_value_t, details::supplier>) {
+              if (value.has_value()) {
+                auto fields{ value.value() };
+                if (!detail::take_string(fields) || !detail::take_string(fields) || !detail::take_string(fields) ||
+                    !fields.empty()) {
+                  value = std::nullopt;
+                }
+              }
+            }
+          } else if constexpr (std::same_as<member_value_t, std::vector<item>>) {
+            value = detail::take_length(remaining);
+            if (value.has_value()) {
+              // check the framing of the children, their content is checked when they are parsed
+              auto framed{ value.value() };
+              std::uint64_t count{};
+              auto const varint_size{ ipc::details::wire_v1::read_varint(framed, count) };
+              framed = framed.subspan(varint_size);
+              for (std::uint64_t child = 0; varint_size != 0 && child < count && value.has_value(); child++) {
+                if (!detail::take_length(framed)) {
+                  value = std::nullopt;
+                }
+              }
+              if (varint_size == 0 || !framed.empty()) {
+                value = std::nullopt;
+              }
+            }
+          } else {
+            if (remaining.size() >= detail::fixed_size<member_value_t>()) {
+              value = remaining.first(detail::fixed_size<member_value_t>());
+              remaining = remaining.subspan(detail::fixed_size<member_value_t>());
+            }
+          }
+          if (!value.has_value()) {
+            valid = false;
+            return;
+          }
+          result.offsets_[idx] = static_cast<std::uint32_t>(value->data() - bytes.data());
+          result.sizes_[idx] = static_cast<std::uint32_t>(value->size());
+        }(),
+        ...);
+  }(std::make_index_sequence<field_count>{});
+  if (!valid || !remaining.empty()) {
+    return std::unexpected(std::make_error_code(std::errc::message_size));
+  }
+  return result;
+}
+
+template <field_e field>
+inline auto view::get() const -> std::optional<value_t<field>> {
+  if (!has(field)) {
+    return std::nullopt;
+  }
+  auto const input{ field_bytes(field) };
+  using member_value_t = member_t<field>;
+  if constexpr (std::same_as<member_value_t, std::string>) {
+    return std::string_view{ reinterpret_cast<char const*>(input.data()), input.size() };
+  } else if constexpr (std::same_as<member_value_t, details::supplier>) {
+    auto fields{ input };
+    auto const name{ detail::take_string(fields).value() };  // checked by parse
+    auto const contact_info{ detail::take_string(fields).value() };
+    auto const country{ detail::take_string(fields).value() };
+    return details::supplier{ .name = std::string{ name },
+                              .contact_info = std::string{ contact_info },
+                              .country = std::string{ country } };
+  } else if constexpr (std::same_as<member_value_t, std::vector<item>>) {
+    std::uint64_t count{};
+    auto const varint_size{ ipc::details::wire_v1::read_varint(input, count) };
+    return children{ input.subspan(varint_size), count };
+  } else {
+    return detail::read<member_value_t>(input);
+  }
+}
+
+inline auto view::items() const -> children {
+  return get<field_e::items>().value_or(children{});
+}
+
+inline auto view::to_item() const -> std::expected<item, std::error_code> {
+  item result{};
+  std::error_code error{};
+  [&]<std::size_t... idx>(std::index_sequence<idx...>) {
+    (
+        [&] {
+          constexpr auto field{ static_cast<field_e>(idx) };
+          auto& member{ result.*std::get<idx>(members) };
+          auto value{ get<field>() };
+          if (!value.has_value()) {
+            return;
+          }
+          if constexpr (std::same_as<member_t<field>, std::string>) {
+            member.emplace(value.value());
+          } else if constexpr (std::same_as<member_t<field>, std::vector<item>>) {
+            auto& items{ member.emplace() };
+            items.reserve(value->size());
+            for (auto const child : value.value()) {
+              if (!child.has_value()) {
+                error = child.error();
+                return;
+              }
+              auto decoded{ child->to_item() };
+              if (!decoded.has_value()) {
+                error = decoded.error();
+                return;
+              }
+              items.emplace_back(std::move(decoded.value()));
+            }
+          } else {
+            member = std::move(value);
+          }
+        }(),
+        ...);
+  }(std::make_index_sequence<field_count>{});
+  if (error) {
+    return std::unexpected(error);
+  }
+  return result;
+}
+
+}  // namespace tfc::ipc::item::binary
@@ -1,15 +1,24 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <expected>
 #include <ranges>
+#include <span>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <tfc/ipc/details/crc32c.hpp>
+#include <tfc/ipc/details/record.hpp>
+#include <tfc/ipc/details/type_description.hpp>
 #include <tfc/ipc/enums.hpp>
 
 namespace tfc::ipc::details {
@@ -17,15 +26,28 @@ namespace tfc::ipc::details {
 /// \brief Enum specifying protocol version
 /// This can be changed in the future to retain backwards compatibility and still
 /// be able to change the protocol structure
-enum struct version_e : std::uint8_t { unknown, v0 };
+/// The version is the first byte of every packet, a receiver accepts any version it knows
+/// regardless of which version it sends itself.
+enum struct version_e : std::uint8_t { unknown, v0, v1 };
 
+/// \brief how a packet is written to the wire, v0 is understood by every receiver
+struct wire_format {
+  version_e version{ version_e::v0 };
+  bool crc{ false };  // append a CRC-32C of the packet, only supported by v1
+};
+
+/// \brief subscription a slot adds next to "" to advertise it reads v1
+/// Every packet already matches "", so the extra topic does not change what the slot receives.
+inline constexpr std::string_view v1_subscription{ "\x02" };
+static_assert(v1_subscription.front() == static_cast<char>(version_e::v1));
+
+/// \brief v0 header, fixed 10 bytes
 template <type_e type_enum>
 struct header_t {
   static constexpr auto type_v{ type_enum };
   version_e version{ version_e::v0 };
   type_e type{ type_v };
   std::size_t value_size{};  // populated in deserialize
-  // Todo crc
   static constexpr auto size() -> std::size_t { return sizeof(version) + sizeof(type) + sizeof(value_size); }
   static void serialize(header_t& header, auto&& buffer) {
     std::copy_n(reinterpret_cast<std::byte*>(&header.version), sizeof(version), std::back_inserter(buffer));
@@ -45,13 +67,61 @@ struct header_t {
     }
     if (result.version != version_e::v0) {
       return std::make_error_code(std::errc::wrong_protocol_type);
-      // TODO: explicit version error
     }
     return {};
   }
 };
 static_assert(header_t<type_e::unknown>::size() == 10);
 
+/**@brief
+ * v1 layout, little endian
+ * | version (1) | type (1) | flags (1) | value size (LEB128 varint, 1-10) | value | crc32c (4, if flags has crc) |
+ * The crc covers every byte before it. Values of fundamental and std::expected<quantity, enum> types are below
+ * 128 bytes so their header is always 4 bytes. Records are | schema hash (8) | members in reflection order |, each
+ * member as its own bytes without the padding of the struct, their size is fixed so the varint is as well.
+ * */
+namespace wire_v1 {
+enum struct flags_e : std::uint8_t {
+  none = 0,
+  crc = 1 << 0,
+};
+static constexpr std::size_t fixed_header_size{ 3 };  // version, type and flags
+static constexpr std::size_t crc_size{ sizeof(std::uint32_t) };
+static constexpr std::size_t max_varint_size{ 10 };
+
+constexpr auto varint_size(std::uint64_t value) noexcept -> std::size_t {
+  std::size_t size{ 1 };
+  while (value >= 0x80) {
+    value >>= 7U;
+    size++;
+  }
+  return size;
+}
+
+inline auto write_varint(std::byte* out, std::uint64_t value) noexcept -> std::size_t {
+  std::size_t idx{};
+  while (value >= 0x80) {
+    out[idx++] = std::byte{ static_cast<std::uint8_t>(value | 0x80U) };
+    value >>= 7U;
+  }
+  out[idx++] = std::byte{ static_cast<std::uint8_t>(value) };
+  return idx;
+}
+
+/// \return number of bytes consumed, 0 if input does not hold a complete varint
+inline auto read_varint(std::span<std::byte const> input, std::uint64_t& value) noexcept -> std::size_t {
+  value = 0;
+  for (std::size_t idx = 0; idx < std::min(input.size(), max_varint_size); idx++) {
+    auto const byte{ static_cast<std::uint64_t>(input[idx]) };
+    value |= (byte & 0x7fU) << (7 * idx);
+    if ((byte & 0x80U) == 0) {
+      return idx + 1;
+    }
+  }
+  return 0;
+}
+}  // namespace wire_v1
+
 /// \brief packet struct to de/serialize data to socket
 template <typename value_type, type_e type_enum>
 struct packet {
@@ -61,109 +131,255 @@ struct packet {
   header_t<type_enum> header{};
   value_t value{};
 
+  static constexpr bool record_v{ concepts::is_record<value_t> };
+  /// \brief values with a size known at compile time up to the one byte of expected/unexpected
+  static constexpr bool fixed_layout_v{ std::is_fundamental_v<value_t> || concepts::is_expected_quantity<value_t> ||
+                                        record_v };
+
+  /// \return bytes needed to serialize any value of value_t, for dynamically sized values only the header size is known
+  static constexpr auto reserve_size() -> std::size_t {
+    if constexpr (fixed_layout_v) {
+      return header_t<type_enum>::size() + max_value_size();
+    } else {
+      return header_t<type_enum>::size();
+    }
+  }
+
   // value size is populated
-  static auto serialize(value_t const& value, std::vector<std::byte>& buffer) -> std::error_code {
-    header_t<type_enum> my_header{};
+  static auto serialize(value_t const& value, std::vector<std::byte>& buffer, wire_format format = {}) -> std::error_code {
+    switch (format.version) {
+      case version_e::v0:
+        if (format.crc) {
+          return std::make_error_code(std::errc::protocol_not_supported);
+        }
+        return serialize_v0(value, buffer);
+      case version_e::v1:
+        return serialize_v1(value, buffer, format.crc);
+      case version_e::unknown:
+        break;
+    }
+    return std::make_error_code(std::errc::protocol_not_supported);
+  }
 
+  static constexpr auto deserialize(std::ranges::view auto&& buffer) -> std::expected<value_t, std::error_code> {
+    std::span<std::byte const> const bytes{ std::ranges::data(buffer), std::ranges::size(buffer) };
+    if (bytes.empty()) {
+      return std::unexpected(std::make_error_code(std::errc::message_size));
+    }
+    switch (static_cast<version_e>(bytes.front())) {
+      case version_e::v0:
+        return deserialize_v0(bytes);
+      case version_e::v1:
+        return deserialize_v1(bytes);
+      case version_e::unknown:
+        break;
+    }
+    return std::unexpected(std::make_error_code(std::errc::protocol_not_supported));
+  }
+
+private:
+  static constexpr auto max_value_size() -> std::size_t {
+    if constexpr (std::is_fundamental_v<value_t>) {
+      return sizeof(value_t);
+    } else if constexpr (concepts::is_expected_quantity<value_t>) {
+      return 1 + std::max(sizeof(typename value_t::value_type::rep), sizeof(typename value_t::error_type));
+    } else if constexpr (record_v) {
+      return sizeof(schema_hash_v<value_t>) + packed_size_v<value_t>;
+    } else {
+      return 0;
+    }
+  }
+
+  static auto value_size(value_t const& value) -> std::size_t {
     if constexpr (std::is_fundamental_v<value_t>) {
-      my_header.value_size = sizeof(value_t);
+      return sizeof(value_t);
     } else if constexpr (concepts::is_expected_quantity<value_t>) {
       if constexpr (std::is_enum_v<typename value_t::error_type>) {
         // + 1 byte to indicate whether it is expected or unexpected
         static_assert(std::is_fundamental_v<typename value_t::value_type::rep>);
         if (value.has_value()) {
-          my_header.value_size = sizeof(typename value_t::value_type::rep{}) + 1;
-        } else {
-          my_header.value_size = sizeof(typename value_t::error_type{}) + 1;
+          return sizeof(typename value_t::value_type::rep{}) + 1;
         }
+        return sizeof(typename value_t::error_type{}) + 1;
       } else {
         []<bool flag = false> {
           static_assert(flag, "Only std::expected<quantity, enum> is supported.");
         }
         ();
       }
+    } else if constexpr (record_v) {
+      return max_value_size();
     } else {
       static_assert(std::is_member_function_pointer_v<decltype(&value_t::size)>, "Serialize for value type not supported");
       static_assert(std::is_same_v<decltype(value_t().size()), std::size_t>);
-      my_header.value_size = value.size();
+      return value.size();
     }
+  }
 
-    const std::size_t buffer_size{ header_t<type_enum>::size() + my_header.value_size };
-    buffer.reserve(buffer_size);
-    header_t<type_enum>::serialize(my_header, buffer);
-
+  /// \brief write value_size(value) bytes of value to out
+  static void write_value(value_t const& value, std::byte* out) {
     if constexpr (std::is_fundamental_v<value_t>) {
-      std::copy_n(reinterpret_cast<std::byte const*>(&value), my_header.value_size, std::back_inserter(buffer));
+      std::memcpy(out, &value, sizeof(value_t));
     } else if constexpr (concepts::is_expected_quantity<value_t>) {
       if (value.has_value()) {
-        buffer.push_back(std::byte{ static_cast<std::uint8_t>(true) });  // indicate this is expected
-        std::copy_n(reinterpret_cast<std::byte const*>(&value.value()), sizeof(typename value_t::value_type::rep),
-                    std::back_inserter(buffer));
+        *out = std::byte{ static_cast<std::uint8_t>(true) };  // indicate this is expected
+        std::memcpy(out + 1, &value.value(), sizeof(typename value_t::value_type::rep));
       } else {
-        buffer.push_back(std::byte{ static_cast<std::uint8_t>(false) });  // indicate this is unexpected
-        std::copy_n(reinterpret_cast<std::byte const*>(&value.error()), sizeof(typename value_t::error_type),
-                    std::back_inserter(buffer));
+        *out = std::byte{ static_cast<std::uint8_t>(false) };  // indicate this is unexpected
+        std::memcpy(out + 1, &value.error(), sizeof(typename value_t::error_type));
       }
+    } else if constexpr (record_v) {
+      std::memcpy(out, &schema_hash_v<value_t>, sizeof(schema_hash_v<value_t>));
+      wire::write(value, out + sizeof(schema_hash_v<value_t>));
     } else {
       // has member function data
       static_assert(std::is_pointer_v<decltype(value.data())>);
-      // Todo why copy the data instead of creating a view into the data?
-      // we should use std::span
-      std::copy_n(reinterpret_cast<std::byte const*>(value.data()), my_header.value_size, std::back_inserter(buffer));
+      std::memcpy(out, value.data(), value.size());
+    }
+  }
+
+  static auto read_value(std::span<std::byte const> payload) -> std::expected<value_t, std::error_code> {
+    value_t result{};
+    if constexpr (std::is_fundamental_v<value_t>) {
+      static_assert(sizeof(value_t) <= 8);
+      if (payload.size() != sizeof(value_t)) {
+        return std::unexpected(std::make_error_code(std::errc::message_size));
+      }
+      std::memcpy(&result, payload.data(), sizeof(value_t));
+    } else if constexpr (concepts::is_expected_quantity<value_t>) {
+      if (payload.empty()) {
+        return std::unexpected(std::make_error_code(std::errc::message_size));
+      }
+      bool const expected_cond{ payload.front() != std::byte{ 0 } };
+      payload = payload.subspan(1);
+      if (expected_cond) {
+        typename value_t::value_type::rep substitute{};
+        if (payload.size() != sizeof(substitute)) {
+          return std::unexpected(std::make_error_code(std::errc::message_size));
+        }
+        std::memcpy(&substitute, payload.data(), sizeof(substitute));
+        result = substitute * value_t::value_type::reference;
+      } else {
+        using error_type = typename value_t::error_type;
+        error_type substitute{};
+        if (payload.size() != sizeof(error_type)) {
+          return std::unexpected(std::make_error_code(std::errc::message_size));
+        }
+        std::memcpy(&substitute, payload.data(), sizeof(error_type));
+        result = std::unexpected{ substitute };
+      }
+    } else if constexpr (record_v) {
+      if (payload.size() != max_value_size()) {
+        return std::unexpected(std::make_error_code(std::errc::message_size));
+      }
+      std::uint64_t hash{};
+      std::memcpy(&hash, payload.data(), sizeof(hash));
+      if (hash != schema_hash_v<value_t>) {
+        // the signal sends a record of another layout
+        return std::unexpected(std::make_error_code(std::errc::wrong_protocol_type));
+      }
+      wire::read(payload.data() + sizeof(hash), result);
+    } else {
+      // has member function data
+      result.resize(payload.size());
+      std::memcpy(result.data(), payload.data(), payload.size());
     }
+    return result;
+  }
 
-    if (buffer.size() != buffer_size) {
-      return std::make_error_code(std::errc::message_size);
+  static auto serialize_v0(value_t const& value, std::vector<std::byte>& buffer) -> std::error_code {
+    header_t<type_enum> my_header{};
+    my_header.value_size = value_size(value);
+
+    const std::size_t buffer_size{ buffer.size() + header_t<type_enum>::size() + my_header.value_size };
+    buffer.reserve(buffer_size);
+    header_t<type_enum>::serialize(my_header, buffer);
+    auto const offset{ buffer.size() };
+    buffer.resize(buffer_size);
+    write_value(value, buffer.data() + offset);
+    return {};
+  }
+
+  static auto serialize_v1(value_t const& value, std::vector<std::byte>& buffer, bool crc) -> std::error_code {
+    std::size_t const size{ value_size(value) };
+    std::size_t header_size{};
+    if constexpr (fixed_layout_v) {
+      // expected quantities vary in size, below 0x80 so the varint is a single byte regardless
+      static_assert(record_v || max_value_size() < 0x80, "fixed layout values must fit a single byte varint");
+      header_size = wire_v1::fixed_header_size + wire_v1::varint_size(max_value_size());
+    } else {
+      header_size = wire_v1::fixed_header_size + wire_v1::varint_size(size);
+    }
+    auto const offset{ buffer.size() };
+    buffer.resize(offset + header_size + size + (crc ? wire_v1::crc_size : 0));
+    std::byte* out{ buffer.data() + offset };
+
+    out[0] = std::byte{ std::to_underlying(version_e::v1) };
+    out[1] = std::byte{ std::to_underlying(type_v) };
+    out[2] = std::byte{ std::to_underlying(crc ? wire_v1::flags_e::crc : wire_v1::flags_e::none) };
+    if constexpr (fixed_layout_v && !record_v) {
+      out[wire_v1::fixed_header_size] = std::byte{ static_cast<std::uint8_t>(size) };
+    } else {
+      wire_v1::write_varint(out + wire_v1::fixed_header_size, size);
+    }
+    write_value(value, out + header_size);
+    if (crc) {
+      auto const checksum{ crc32c::compute(std::span{ out, header_size + size }) };
+      std::memcpy(out + header_size + size, &checksum, sizeof(checksum));
     }
     return {};
   }
 
-  static constexpr auto deserialize(std::ranges::view auto&& buffer) -> std::expected<value_t, std::error_code> {
+  static auto deserialize_v0(std::span<std::byte const> buffer) -> std::expected<value_t, std::error_code> {
     if (buffer.size() < header_t<type_enum>::size()) {
       return std::unexpected(std::make_error_code(std::errc::message_size));
     }
 
-    packet<value_t, type_v> result{};
-    auto buffer_iter{ std::begin(buffer) };
-    header_t<type_enum>::deserialize(result.header, buffer_iter);
+    header_t<type_enum> header{};
+    header_t<type_enum>::deserialize(header, std::begin(buffer));
 
-    if (result.header.type != type_v) {
+    if (header.type != type_v) {
       return std::unexpected{ std::make_error_code(std::errc::bad_message) };
     }
 
     // todo partial buffer?
-    if (buffer.size() != header_t<type_enum>::size() + result.header.value_size) {
+    if (buffer.size() != header_t<type_enum>::size() + header.value_size) {
       return std::unexpected(std::make_error_code(std::errc::message_size));
     }
+    return read_value(buffer.subspan(header_t<type_enum>::size()));
+  }
 
-    if constexpr (std::is_fundamental_v<value_t>) {
-      static_assert(sizeof(value_t) <= 8);
-      std::copy_n(buffer_iter, result.header.value_size, reinterpret_cast<std::byte*>(&result.value));
-    } else if constexpr (concepts::is_expected_quantity<value_t>) {
-      bool expected_cond{};
-      std::copy_n(buffer_iter, sizeof(bool), reinterpret_cast<std::byte*>(&expected_cond));
-      buffer_iter += sizeof(bool);
-      if (expected_cond) {
-        typename value_t::value_type::rep substitute{};
-        std::copy_n(buffer_iter, result.header.value_size - 1, reinterpret_cast<std::byte*>(&substitute));
-        result.value = substitute * value_t::value_type::reference;
-      } else {
-        using error_type = typename value_t::error_type;
-        error_type substitute{};
-        if constexpr (std::is_trivial_v<error_type>) {
-          std::copy_n(buffer_iter, sizeof(error_type), reinterpret_cast<std::byte*>(&substitute));
-        } else {
-          substitute.resize(result.header.value_size);
-          std::copy_n(buffer_iter, result.header.value_size - 1, reinterpret_cast<std::byte*>(substitute.data()));
-        }
-        result.value = std::unexpected{ substitute };
+  static auto deserialize_v1(std::span<std::byte const> buffer) -> std::expected<value_t, std::error_code> {
+    if (buffer.size() < wire_v1::fixed_header_size + 1) {
+      return std::unexpected(std::make_error_code(std::errc::message_size));
+    }
+    if (static_cast<type_e>(buffer[1]) != type_v) {
+      return std::unexpected{ std::make_error_code(std::errc::bad_message) };
+    }
+    auto const flags{ static_cast<std::uint8_t>(buffer[2]) };
+    if ((flags & ~std::to_underlying(wire_v1::flags_e::crc)) != 0) {
+      return std::unexpected{ std::make_error_code(std::errc::bad_message) };
+    }
+    bool const crc{ (flags & std::to_underlying(wire_v1::flags_e::crc)) != 0 };
+
+    std::uint64_t size{};
+    auto const varint_size{ wire_v1::read_varint(buffer.subspan(wire_v1::fixed_header_size), size) };
+    if (varint_size == 0) {
+      return std::unexpected(std::make_error_code(std::errc::message_size));
+    }
+    auto const header_size{ wire_v1::fixed_header_size + varint_size };
+    auto const payload_size{ buffer.size() - header_size };
+    if (payload_size < (crc ? wire_v1::crc_size : 0) || size != payload_size - (crc ? wire_v1::crc_size : 0)) {
+      return std::unexpected(std::make_error_code(std::errc::message_size));
+    }
+    if (crc) {
+      std::uint32_t checksum{};
+      std::memcpy(&checksum, buffer.data() + header_size + size, sizeof(checksum));
+      if (checksum != crc32c::compute(buffer.first(header_size + size))) {
+        return std::unexpected{ std::make_error_code(std::errc::illegal_byte_sequence) };
       }
-    } else {
-      // has member function data
-      result.value.resize(result.header.value_size);
-      std::copy_n(buffer_iter, result.header.value_size, reinterpret_cast<std::byte*>(result.value.data()));
     }
-    return std::move(result.value);
+    return read_value(buffer.subspan(header_size, size));
   }
 };
 
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <system_error>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+namespace tfc::ipc {
+
+namespace asio = boost::asio;
+
+/**@brief
+ * Stages updates of many signals and publishes them together.
+ * Intended for devices that produce many values per process data cycle, each signal is registered
+ * once with add() and values are staged during the cycle. flush() at the end of the cycle sends the
+ * staged values back to back without a completion handler per value. A signal staged more than once
+ * within a batch only publishes its latest value.
+ * If the owner does not flush within max_latency of the first staged value the batch is flushed by a timer.
+ * The timer is armed by the first value staged after a flush and cancelled by the flush, so a group flushed every
+ * cycle never wakes up on it.
+ * @code{.cpp}
+ * tfc::ipc::publish_group group{ ctx };
+ * auto& staged{ group.add(signal) };
+ * staged.stage(true);
+ * group.flush();
+ * @endcode
+ * */
+class publish_group {
+  struct member_base {
+    virtual ~member_base() = default;
+    virtual auto publish() -> std::error_code = 0;
+    bool staged{ false };
+  };
+
+public:
+  static constexpr auto default_max_latency{ std::chrono::milliseconds(1) };
+
+  struct metrics_t {
+    std::uint64_t batches{};          // number of non empty flushes
+    std::uint64_t values{};           // number of values published
+    std::uint64_t coalesced{};        // staged values replaced by a newer value before being published
+    std::uint64_t errors{};           // values that failed to publish
+    std::uint64_t deadline_flushes{};  // batches flushed by the max latency timer instead of the owner
+    std::size_t largest_batch{};
+    std::chrono::nanoseconds last_flush_duration{};
+  };
+
+  /// \brief handle to a registered signal, stays valid for the lifetime of the group
+  template <typename signal_t>
+  class member final : public member_base {
+  public:
+    using value_t = typename signal_t::value_t;
+
+    member(publish_group& group, signal_t& signal) : group_{ group }, signal_{ signal } {}
+
+    /// \brief stage value to be published on the next flush
+    void stage(value_t const& value) {
+      if (staged) {
+        group_.metrics_.coalesced++;
+      } else {
+        group_.mark_staged(*this);
+      }
+      value_ = value;
+    }
+
+  private:
+    auto publish() -> std::error_code override { return signal_.send(value_.value()); }
+
+    publish_group& group_;
+    signal_t& signal_;
+    std::optional<value_t> value_{ std::nullopt };
+  };
+
+  explicit publish_group(asio::io_context& ctx, std::chrono::nanoseconds max_latency = default_max_latency)
+      : max_latency_{ max_latency }, deadline_{ ctx } {}
+  publish_group(publish_group const&) = delete;
+  auto operator=(publish_group const&) -> publish_group& = delete;
+  publish_group(publish_group&&) = delete;
+  auto operator=(publish_group&&) -> publish_group& = delete;
+  ~publish_group() = default;
+
+  /// \brief register a signal with the group, the signal must outlive the group
+  /// \return handle used to stage values of the signal
+  template <typename signal_t>
+  auto add(signal_t& signal) -> member<signal_t>& {
+    auto owned{ std::make_unique<member<signal_t>>(*this, signal) };
+    auto& result{ *owned };
+    members_.emplace_back(std::move(owned));
+    staged_.reserve(members_.size());
+    return result;
+  }
+
+  /// \brief publish all staged values
+  /// \return the last error encountered, the remaining values are published regardless
+  auto flush() -> std::error_code {
+    if (staged_.empty()) {
+      return {};
+    }
+    auto const start{ std::chrono::steady_clock::now() };
+    std::error_code result{};
+    for (auto* staged : staged_) {
+      staged->staged = false;
+      if (auto err{ staged->publish() }) {
+        metrics_.errors++;
+        result = err;
+      }
+    }
+    metrics_.batches++;
+    metrics_.values += staged_.size();
+    metrics_.largest_batch = std::max(metrics_.largest_batch, staged_.size());
+    staged_.clear();
+    batch_++;
+    deadline_.cancel();
+    metrics_.last_flush_duration = std::chrono::steady_clock::now() - start;
+    return result;
+  }
+
+  [[nodiscard]] auto pending() const noexcept -> std::size_t { return staged_.size(); }
+
+  [[nodiscard]] auto metrics() const noexcept -> metrics_t const& { return metrics_; }
+
+private:
+  void mark_staged(member_base& staged) {
+    staged.staged = true;
+    staged_.emplace_back(&staged);
+    if (staged_.size() == 1) {
+      arm_deadline();
+    }
+  }
+
+  void arm_deadline() {
+    deadline_.expires_after(max_latency_);
+    deadline_.async_wait([this, batch = batch_](std::error_code const& err) {
+      // cancelled by a flush or the group being destroyed, an expiry already queued when the batch was flushed is stale
+      if (err || batch != batch_) {
+        return;
+      }
+      metrics_.deadline_flushes++;
+      flush();
+    });
+  }
+
+  std::chrono::nanoseconds max_latency_;
+  asio::steady_timer deadline_;
+  std::uint64_t batch_{};  // incremented by every flush
+  std::vector<std::unique_ptr<member_base>> members_{};
+  std::vector<member_base*> staged_{};
+  metrics_t metrics_{};
+};
+
+}  // namespace tfc::ipc
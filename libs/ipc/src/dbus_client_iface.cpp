@@ -1,6 +1,8 @@
 #include <tfc/ipc/details/dbus_client_iface.hpp>
 
+#include <fmt/chrono.h>
 #include <fmt/core.h>
+#include <boost/asio/post.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <glaze/glaze.hpp>
 #include <sdbusplus/asio/connection.hpp>
@@ -33,16 +35,67 @@ auto ipc_manager_client::register_signal(const std::string_view name,
                                          const std::string_view description,
                                          ipc::details::type_e type,
                                          std::function<void(std::error_code const&)>&& handler) -> void {
-  connection_->async_method_call(std::move(handler), ipc_ruler_service_name_, ipc_ruler_object_path_,
-                                 ipc_ruler_interface_name_, consts::register_signal.data(), name, description,
-                                 static_cast<uint8_t>(type));
+  queue_registration(pending_signals_,
+                     registration{ std::string{ name }, std::string{ description }, type, std::move(handler) });
 }
 auto ipc_manager_client::register_slot(const std::string_view name,
                                        const std::string_view description,
                                        ipc::details::type_e type,
                                        std::function<void(std::error_code const&)>&& handler) -> void {
-  connection_->async_method_call(std::move(handler), ipc_ruler_service_name_, ipc_ruler_object_path_,
-                                 ipc_ruler_interface_name_, "RegisterSlot", name, description, static_cast<uint8_t>(type));
+  queue_registration(pending_slots_,
+                     registration{ std::string{ name }, std::string{ description }, type, std::move(handler) });
+}
+auto ipc_manager_client::queue_registration(std::vector<registration>& queue, registration&& entry) -> void {
+  if (!first_registration_) {
+    first_registration_ = std::chrono::steady_clock::now();
+  }
+  queue.emplace_back(std::move(entry));
+  if (!flush_posted_) {
+    flush_posted_ = true;
+    asio::post(connection_->get_io_context(), [weak_self = std::weak_ptr{ lifetime_ }] {
+      if (auto const self{ weak_self.lock() }) {
+        (*self)->flush_registrations();
+      }
+    });
+  }
+}
+auto ipc_manager_client::flush_registrations() -> void {
+  flush_posted_ = false;
+  if (!pending_signals_.empty()) {
+    send_registrations(consts::register_signals, std::exchange(pending_signals_, {}));
+  }
+  if (!pending_slots_.empty()) {
+    send_registrations(consts::register_slots, std::exchange(pending_slots_, {}));
+  }
+}
+auto ipc_manager_client::send_registrations(std::string_view method, std::vector<registration>&& batch) -> void {
+  std::vector<std::tuple<std::string, std::string, std::uint8_t>> entries{};
+  entries.reserve(batch.size());
+  for (auto const& entry : batch) {
+    entries.emplace_back(entry.name, entry.description, static_cast<std::uint8_t>(entry.type));
+  }
+  registration_stats_.batches++;
+  registration_stats_.endpoints += batch.size();
+  batches_in_flight_++;
+  connection_->async_method_call(
+      [this, weak_self = std::weak_ptr{ lifetime_ }, handlers = std::move(batch)](std::error_code const& err) {
+        // the retry handlers call back into the client, a reply arriving after it is gone is dropped
+        if (weak_self.expired()) {
+          return;
+        }
+        batches_in_flight_--;
+        if (!registration_stats_.startup_duration && batches_in_flight_ == 0 && pending_signals_.empty() &&
+            pending_slots_.empty()) {
+          registration_stats_.startup_duration = std::chrono::steady_clock::now() - first_registration_.value();
+          logger_.info("Registered {} signals and slots in {} calls, took {}", registration_stats_.endpoints,
+                       registration_stats_.batches,
+                       std::chrono::duration_cast<std::chrono::milliseconds>(registration_stats_.startup_duration.value()));
+        }
+        for (auto const& entry : handlers) {
+          std::invoke(entry.handler, err);
+        }
+      },
+      ipc_ruler_service_name_, ipc_ruler_object_path_, ipc_ruler_interface_name_, method.data(), entries);
 }
 struct retry_callable {
   std::shared_ptr<asio::steady_timer> timer;
@@ -132,12 +185,60 @@ auto ipc_manager_client::connections(std::function<void(std::map<std::string, st
         }
       });
 }
+auto ipc_manager_client::generation(std::function<void(std::error_code const&, std::uint64_t)>&& handler) -> void {
+  sdbusplus::asio::getProperty<std::uint64_t>(
+      *connection_, ipc_ruler_service_name_, ipc_ruler_object_path_, ipc_ruler_interface_name_,
+      consts::generation_property.data(),
+      [captured_handler = std::move(handler)](const boost::system::error_code& error, std::uint64_t response) {
+        captured_handler(error, response);
+      });
+}
+auto ipc_manager_client::changes_since(std::uint64_t generation,
+                                       std::function<void(std::error_code const&, std::vector<change> const&)>&& handler)
+    -> void {
+  connection_->async_method_call(
+      [captured_handler = std::move(handler)](const boost::system::error_code& error, const std::string& response) {
+        if (error) {
+          captured_handler(error, {});
+          return;
+        }
+        auto changes = glz::read_json<std::vector<change>>(response);
+        if (!changes) {
+          fmt::println(stderr, "Changes since parse error: {}", glz::format_error(changes.error(), response));
+          captured_handler(std::make_error_code(std::errc::bad_message), {});
+          return;
+        }
+        captured_handler({}, changes.value());
+      },
+      ipc_ruler_service_name_, ipc_ruler_object_path_, ipc_ruler_interface_name_, consts::changes_since_method.data(),
+      generation);
+}
+auto ipc_manager_client::register_changes_callback(
+    std::function<void(std::uint64_t, std::vector<change> const&)> const& changes_callback)
+    -> std::unique_ptr<sdbusplus::bus::match::match> {
+  return make_match(fmt::format("{},member='{}'", connection_match_rule_, consts::changes_signal),
+                    [changes_callback](sdbusplus::message_t& msg) {
+                      auto const [generation, json] = msg.unpack<std::tuple<std::uint64_t, std::string>>();
+                      auto changes = glz::read_json<std::vector<change>>(json);
+                      if (!changes) {
+                        fmt::println(stderr, "Changes signal parse error: {}", glz::format_error(changes.error(), json));
+                        return;
+                      }
+                      std::invoke(changes_callback, generation, changes.value());
+                    });
+}
 auto ipc_manager_client::connect(std::string_view slot_name,
                                  std::string_view signal_name,
                                  std::function<void(std::error_code const&)>&& handler) -> void {
   connection_->async_method_call(std::move(handler), ipc_ruler_service_name_, ipc_ruler_object_path_,
                                  ipc_ruler_interface_name_, consts::connect_method.data(), slot_name, signal_name);
 }
+auto ipc_manager_client::connect_many(std::vector<std::pair<std::string, std::string>> const& connections,
+                                      std::function<void(std::error_code const&)>&& handler) -> void {
+  std::vector<std::tuple<std::string, std::string>> entries{ connections.begin(), connections.end() };
+  connection_->async_method_call(std::move(handler), ipc_ruler_service_name_, ipc_ruler_object_path_,
+                                 ipc_ruler_interface_name_, consts::connect_many_method.data(), entries);
+}
 auto ipc_manager_client::disconnect(std::string_view slot_name, std::function<void(std::error_code const&)>&& handler)
     -> void {
   connection_->async_method_call(std::move(handler), ipc_ruler_service_name_, ipc_ruler_object_path_,
@@ -160,6 +261,9 @@ auto ipc_manager_client::make_match(const std::string& match_rule,
   return std::make_unique<sdbusplus::bus::match::match>(*connection_, match_rule, callback);
 }
 auto ipc_manager_client::match_callback(sdbusplus::message_t& msg) -> void {
+  if (msg.get_member() != consts::connection_change) {
+    return;  // other signals of the ipc manager interface, f.e. Changes
+  }
   auto container = msg.unpack<std::tuple<std::string, std::string>>();
   std::string const slot_name = std::get<0>(container);
   std::string const signal_name = std::get<1>(container);
@@ -46,6 +46,13 @@ void ipc_manager_client_mock::register_signal_retry(std::string_view name,
   for (auto& callback : callbacks_) {
     callback(dbus_message);
   }
+
+  std::vector<change> const changes{
+    change{ .generation = ++generation_, .kind = change_e::signal_added, .signal_info = signals_.back() }
+  };
+  for (auto& callback : changes_callbacks_) {
+    callback(generation_, changes);
+  }
 }
 auto ipc_manager_client_mock::register_properties_change_callback(
     std::function<void(sdbusplus::message_t&)> const& property_callback) -> std::unique_ptr<sdbusplus::bus::match::match> {
@@ -53,4 +60,11 @@ auto ipc_manager_client_mock::register_properties_change_callback(
   return nullptr;
 }
 
+auto ipc_manager_client_mock::register_changes_callback(
+    std::function<void(std::uint64_t, std::vector<change> const&)> const& changes_callback)
+    -> std::unique_ptr<sdbusplus::bus::match::match> {
+  changes_callbacks_.emplace_back(changes_callback);
+  return nullptr;
+}
+
 }  // namespace tfc::ipc_ruler
@@ -13,6 +13,7 @@ PRAGMA_CLANG_WARNING_POP
 
 #include <tfc/ipc/details/item_glaze_meta.hpp>
 #include <tfc/ipc/item.hpp>
+#include <tfc/ipc/item_binary.hpp>
 
 namespace tfc::ipc::item {
 
@@ -39,6 +40,24 @@ auto item::from_json(std::string_view json) -> std::expected<item, glz::error_ct
 auto item::to_json() const -> std::expected<std::string, glz::error_ctx> {
   return glz::write_json(*this);
 }
+auto item::from_binary(std::span<std::byte const> bytes) -> std::expected<item, std::error_code> {
+  auto const view{ binary::view::parse(bytes) };
+  if (!view.has_value()) {
+    return std::unexpected(view.error());
+  }
+  auto temporary{ view->to_item() };
+  if (!temporary.has_value()) {
+    return temporary;
+  }
+  // We are receiving this item, update exchange
+  temporary->last_exchange = std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::system_clock::now());
+  return temporary;
+}
+auto item::to_binary() const -> std::vector<std::byte> {
+  std::vector<std::byte> buffer{};
+  binary::encode(*this, buffer);
+  return buffer;
+}
 auto item::id() const -> std::string {
   if (item_id.has_value()) {
     return uuids::to_string(item_id.value());
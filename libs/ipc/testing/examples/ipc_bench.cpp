@@ -0,0 +1,824 @@
+// Multi process fan-out benchmark and soak test of the ipc layer.
+//
+// The orchestrator starts a private D-Bus daemon and an in memory ipc-ruler, then for every point of the sweep it
+// starts N publisher and M subscriber processes (this executable again with --role). Every subscriber has one slot per
+// publisher signal, so each value is fanned out to M processes. Values carry their steady clock send time, which is
+// shared by every process on the host, so subscribers measure the end to end latency of each value they receive.
+//
+//   tfc_ipc_bench --types int64 double string --rates 1000 10000 0 --publishers 1 4 --subscribers 1 8 --duration 10
+//
+// A rate of 0 sends as fast as possible. The results are printed as a JSON array, one object per sweep point.
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <expected>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+#include <boost/asio.hpp>
+#include <boost/program_options.hpp>
+#include <glaze/glaze.hpp>
+
+#include <tfc/ipc.hpp>
+#include <tfc/progbase.hpp>
+
+extern char** environ;  // NOLINT(readability-redundant-declaration)
+
+namespace asio = boost::asio;
+namespace bpo = boost::program_options;
+
+namespace {
+
+std::atomic<std::uint64_t> allocations{};
+
+}  // namespace
+
+// every allocation of the process is counted, reported per message for the measured part of the run
+auto operator new(std::size_t size) -> void* {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr{ std::malloc(std::max<std::size_t>(size, 1)) }) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+
+constexpr auto registration_timeout{ std::chrono::seconds{ 30 } };
+constexpr auto settle_time{ std::chrono::milliseconds{ 500 } };
+constexpr auto drain_time{ std::chrono::milliseconds{ 500 } };
+
+/**@brief
+ * Log linear histogram of nanosecond latencies, 16 buckets per power of two so a bucket is at most 6.25% wide.
+ * Subscribers report their buckets and the orchestrator merges them to get percentiles over every received value.
+ * The largest sample is tracked exactly, a bucket midpoint can be up to 3% off.
+ * */
+class latency_histogram {
+public:
+  static constexpr std::uint32_t sub_buckets{ 16 };
+  static constexpr std::uint32_t sub_bucket_bits{ std::countr_zero(sub_buckets) };
+
+  void add(std::uint64_t nanoseconds) {
+    buckets_[index(nanoseconds)]++;
+    max_ = std::max(max_, nanoseconds);
+  }
+
+  void merge(std::map<std::uint32_t, std::uint64_t> const& buckets, std::uint64_t max) {
+    for (auto const& [idx, count] : buckets) {
+      buckets_[idx] += count;
+    }
+    max_ = std::max(max_, max);
+  }
+
+  /// \return the middle of the bucket holding the value below which fraction of the samples lie, 0 if empty
+  [[nodiscard]] auto percentile(double fraction) const -> std::uint64_t {
+    std::uint64_t total{};
+    for (auto const& [idx, count] : buckets_) {
+      total += count;
+    }
+    if (total == 0) {
+      return 0;
+    }
+    auto const rank{ std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(total)))) };
+    std::uint64_t seen{};
+    for (auto const& [idx, count] : buckets_) {
+      seen += count;
+      if (seen >= rank) {
+        return midpoint(idx);
+      }
+    }
+    return midpoint(buckets_.rbegin()->first);
+  }
+
+  [[nodiscard]] auto buckets() const noexcept -> std::map<std::uint32_t, std::uint64_t> const& { return buckets_; }
+
+  /// \return the largest sample, 0 if empty
+  [[nodiscard]] auto max() const noexcept -> std::uint64_t { return max_; }
+
+private:
+  [[nodiscard]] static auto index(std::uint64_t value) noexcept -> std::uint32_t {
+    if (value < sub_buckets) {
+      return static_cast<std::uint32_t>(value);
+    }
+    auto const shift{ static_cast<std::uint32_t>(std::bit_width(value)) - 1 - sub_bucket_bits };
+    return (shift + 1) * sub_buckets + static_cast<std::uint32_t>((value >> shift) & (sub_buckets - 1));
+  }
+
+  [[nodiscard]] static auto midpoint(std::uint32_t idx) noexcept -> std::uint64_t {
+    if (idx < sub_buckets) {
+      return idx;
+    }
+    auto const shift{ idx / sub_buckets - 1 };
+    auto const lower{ static_cast<std::uint64_t>(sub_buckets + idx % sub_buckets) << shift };
+    return lower + ((std::uint64_t{ 1 } << shift) >> 1);
+  }
+
+  std::map<std::uint32_t, std::uint64_t> buckets_{};
+  std::uint64_t max_{};
+};
+
+/// \brief what a publisher or subscriber process measured, printed as one JSON line when it is done
+struct process_report {
+  std::uint64_t messages{};
+  double seconds{};
+  std::uint64_t cpu_ns{};
+  std::uint64_t allocations{};
+  std::map<std::uint32_t, std::uint64_t> latency{};
+  std::uint64_t max_latency_ns{};
+};
+
+struct point_report {
+  std::string type{};
+  std::uint64_t rate{};
+  std::size_t publishers{};
+  std::size_t subscribers{};
+  std::size_t payload_bytes{};
+  std::uint64_t sent{};
+  std::uint64_t expected{};
+  std::uint64_t received{};
+  double seconds{};
+  double throughput{};
+  double p50_us{};
+  double p99_us{};
+  double p999_us{};
+  double max_us{};
+  double publisher_cpu_us_per_message{};
+  double subscriber_cpu_us_per_message{};
+  double publisher_allocations_per_message{};
+  double subscriber_allocations_per_message{};
+  std::string error{};
+};
+
+}  // namespace
+
+template <>
+struct glz::meta<process_report> {
+  // clang-format off
+  static constexpr auto value{ glz::object(
+      "messages", &process_report::messages,
+      "seconds", &process_report::seconds,
+      "cpu_ns", &process_report::cpu_ns,
+      "allocations", &process_report::allocations,
+      "latency", &process_report::latency,
+      "max_latency_ns", &process_report::max_latency_ns) };
+  // clang-format on
+};
+
+template <>
+struct glz::meta<point_report> {
+  using report = point_report;
+  // clang-format off
+  static constexpr auto value{ glz::object(
+      "type", &report::type,
+      "rate", &report::rate,
+      "publishers", &report::publishers,
+      "subscribers", &report::subscribers,
+      "payload_bytes", &report::payload_bytes,
+      "sent", &report::sent,
+      "expected", &report::expected,
+      "received", &report::received,
+      "seconds", &report::seconds,
+      "throughput", &report::throughput,
+      "p50_us", &report::p50_us,
+      "p99_us", &report::p99_us,
+      "p999_us", &report::p999_us,
+      "max_us", &report::max_us,
+      "publisher_cpu_us_per_message", &report::publisher_cpu_us_per_message,
+      "subscriber_cpu_us_per_message", &report::subscriber_cpu_us_per_message,
+      "publisher_allocations_per_message", &report::publisher_allocations_per_message,
+      "subscriber_allocations_per_message", &report::subscriber_allocations_per_message,
+      "error", &report::error) };
+  // clang-format on
+};
+
+namespace {
+
+struct options {
+  std::string role{ "orchestrator" };
+  std::vector<std::string> types{ "int64", "double", "string" };
+  std::vector<std::uint64_t> rates{ 1000, 10000 };
+  std::vector<std::size_t> publishers{ 1 };
+  std::vector<std::size_t> subscribers{ 1, 4 };
+  std::uint64_t duration{ 5 };
+  std::size_t payload_bytes{ 256 };
+  std::string ruler{ TFC_IPC_RULER_PATH };
+  std::string bus{};
+  std::string output{};
+  std::size_t point{};  // sweep point index, keeps the process names of one point apart from the previous ones
+};
+
+auto now_ns() -> std::uint64_t {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+auto cpu_ns() -> std::uint64_t {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  auto const to_ns{ [](timeval const& time) {
+    return static_cast<std::uint64_t>(time.tv_sec) * 1'000'000'000 + static_cast<std::uint64_t>(time.tv_usec) * 1'000;
+  } };
+  return to_ns(usage.ru_utime) + to_ns(usage.ru_stime);
+}
+
+/// \brief the send time travels in the value, as the value itself or as the leading digits of a padded string
+template <typename value_t>
+auto encode(std::uint64_t timestamp, std::size_t payload_bytes) -> value_t {
+  if constexpr (std::same_as<value_t, std::string>) {
+    auto text{ fmt::format("{}:", timestamp) };
+    text.resize(std::max(payload_bytes, text.size()), 'x');
+    return text;
+  } else {
+    return static_cast<value_t>(timestamp);
+  }
+}
+
+template <typename value_t>
+auto decode(value_t const& value) -> std::uint64_t {
+  if constexpr (std::same_as<value_t, std::string>) {
+    std::uint64_t timestamp{};
+    std::from_chars(value.data(), value.data() + value.size(), timestamp);
+    return timestamp;
+  } else {
+    return static_cast<std::uint64_t>(value);
+  }
+}
+
+/// \brief call func with the type description named name, the types able to carry a timestamp
+template <typename func_t>
+auto with_type(std::string_view name, func_t&& func) -> bool {
+  using tfc::ipc::details::type_double;
+  using tfc::ipc::details::type_int;
+  using tfc::ipc::details::type_string;
+  using tfc::ipc::details::type_uint;
+  if (name == type_int::type_name) {
+    func.template operator()<type_int>();
+  } else if (name == type_uint::type_name) {
+    func.template operator()<type_uint>();
+  } else if (name == type_double::type_name) {
+    func.template operator()<type_double>();
+  } else if (name == type_string::type_name) {
+    func.template operator()<type_string>();
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void print_line(std::string_view line) {
+  fmt::print("{}\n", line);
+  std::fflush(stdout);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// publisher and subscriber processes
+
+/// \brief waits for "go" on stdin, sends rate values per second for the duration and prints its report
+template <typename type_desc>
+auto publish(asio::io_context& ctx, options const& opts) -> asio::awaitable<void> {
+  using value_t = typename type_desc::value_t;
+  tfc::ipc_ruler::ipc_manager_client client{ ctx };
+  tfc::ipc::signal<type_desc> signal{ ctx, client, "value", "tfc_ipc_bench publisher" };
+
+  asio::posix::stream_descriptor input{ ctx, dup(STDIN_FILENO) };
+  std::string line{};
+  co_await asio::async_read_until(input, asio::dynamic_buffer(line), '\n', asio::use_awaitable);
+
+  auto const start_cpu{ cpu_ns() };
+  auto const start_allocations{ allocations.load(std::memory_order_relaxed) };
+  auto const start{ std::chrono::steady_clock::now() };
+  auto const end{ start + std::chrono::seconds{ opts.duration } };
+  asio::steady_timer timer{ ctx };
+  process_report report{};
+  auto const rate{ opts.rates.front() };
+  if (rate == 0) {
+    while (std::chrono::steady_clock::now() < end) {
+      std::ignore = signal.send(encode<value_t>(now_ns(), opts.payload_bytes));
+      report.messages++;
+      co_await asio::post(ctx, asio::use_awaitable);
+    }
+  } else {
+    auto const period{ std::chrono::nanoseconds{ 1'000'000'000 / rate } };
+    auto const count{ rate * opts.duration };
+    auto deadline{ start };
+    for (std::uint64_t idx = 0; idx < count; idx++) {
+      std::ignore = signal.send(encode<value_t>(now_ns(), opts.payload_bytes));
+      report.messages++;
+      deadline += period;
+      timer.expires_at(deadline);
+      co_await timer.async_wait(asio::use_awaitable);
+    }
+  }
+  report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  report.cpu_ns = cpu_ns() - start_cpu;
+  report.allocations = allocations.load(std::memory_order_relaxed) - start_allocations;
+  print_line(glz::write_json(report).value_or("{}"));
+  ctx.stop();
+}
+
+/// \brief one slot per publisher, prints "connected" once every slot is connected and its report when stdin closes
+template <typename type_desc>
+auto subscribe(asio::io_context& ctx, options const& opts) -> asio::awaitable<void> {
+  using value_t = typename type_desc::value_t;
+  tfc::ipc_ruler::ipc_manager_client client{ ctx };
+
+  process_report report{};
+  latency_histogram histogram{};
+  std::uint64_t start_cpu{};
+  std::uint64_t start_allocations{};
+  std::chrono::steady_clock::time_point first{};
+  std::chrono::steady_clock::time_point last{};
+  auto const on_value{ [&](value_t const& value) {
+    auto const received{ now_ns() };
+    if (report.messages++ == 0) {
+      start_cpu = cpu_ns();
+      start_allocations = allocations.load(std::memory_order_relaxed);
+      first = std::chrono::steady_clock::now();
+    }
+    last = std::chrono::steady_clock::now();
+    histogram.add(received - std::min(received, decode(value)));
+  } };
+
+  std::vector<std::unique_ptr<tfc::ipc::slot<type_desc>>> slots{};
+  for (std::size_t idx = 0; idx < opts.publishers.front(); idx++) {
+    slots.emplace_back(std::make_unique<tfc::ipc::slot<type_desc>>(ctx, client, fmt::format("pub{}", idx),
+                                                                    "tfc_ipc_bench subscriber", on_value));
+  }
+
+  asio::steady_timer timer{ ctx };
+  while (!std::ranges::all_of(slots, [](auto const& slot) { return slot->connection().has_value(); })) {
+    timer.expires_after(std::chrono::milliseconds{ 10 });
+    co_await timer.async_wait(asio::use_awaitable);
+  }
+  print_line("connected");
+
+  asio::posix::stream_descriptor input{ ctx, dup(STDIN_FILENO) };
+  std::string line{};
+  // ends with end of file once the orchestrator is done sending
+  std::ignore =
+      co_await asio::async_read_until(input, asio::dynamic_buffer(line), '\n', asio::as_tuple(asio::use_awaitable));
+
+  if (report.messages > 0) {
+    report.seconds = std::chrono::duration<double>(last - first).count();
+    report.cpu_ns = cpu_ns() - start_cpu;
+    report.allocations = allocations.load(std::memory_order_relaxed) - start_allocations;
+  }
+  report.latency = histogram.buckets();
+  report.max_latency_ns = histogram.max();
+  print_line(glz::write_json(report).value_or("{}"));
+  ctx.stop();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// orchestrator
+
+struct child {
+  pid_t pid{ -1 };
+  std::unique_ptr<asio::posix::stream_descriptor> input{};   // stdin of the child
+  std::unique_ptr<asio::posix::stream_descriptor> output{};  // stdout of the child
+  std::string buffer{};
+};
+
+/// \brief start a process, its stdin and stdout are pipes when ctx is given, otherwise its stdout goes to our stderr
+auto spawn(std::string const& path, std::vector<std::string> const& args, asio::io_context* ctx)
+    -> std::expected<child, std::error_code> {
+  std::vector<char*> argv{};
+  argv.reserve(args.size() + 1);
+  for (auto const& arg : args) {
+    argv.emplace_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.emplace_back(nullptr);
+
+  std::array<int, 2> input{ -1, -1 };
+  std::array<int, 2> output{ -1, -1 };
+  posix_spawn_file_actions_t actions{};
+  posix_spawn_file_actions_init(&actions);
+  if (ctx != nullptr) {
+    if (pipe2(input.data(), O_CLOEXEC) == -1 || pipe2(output.data(), O_CLOEXEC) == -1) {
+      std::error_code const err{ errno, std::system_category() };
+      posix_spawn_file_actions_destroy(&actions);
+      return std::unexpected(err);
+    }
+    posix_spawn_file_actions_adddup2(&actions, input[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, output[1], STDOUT_FILENO);
+  } else {
+    posix_spawn_file_actions_adddup2(&actions, STDERR_FILENO, STDOUT_FILENO);
+  }
+  pid_t pid{};
+  int const result{ posix_spawnp(&pid, path.c_str(), &actions, nullptr, argv.data(), environ) };
+  posix_spawn_file_actions_destroy(&actions);
+  if (ctx == nullptr) {
+    if (result != 0) {
+      return std::unexpected(std::error_code{ result, std::system_category() });
+    }
+    return child{ .pid = pid };
+  }
+  close(input[0]);
+  close(output[1]);
+  if (result != 0) {
+    close(input[1]);
+    close(output[0]);
+    return std::unexpected(std::error_code{ result, std::system_category() });
+  }
+  return child{ .pid = pid,
+                .input = std::make_unique<asio::posix::stream_descriptor>(*ctx, input[1]),
+                .output = std::make_unique<asio::posix::stream_descriptor>(*ctx, output[0]) };
+}
+
+void terminate(child& proc, int signal_number = SIGTERM) {
+  if (proc.pid > 0) {
+    kill(proc.pid, signal_number);
+    waitpid(proc.pid, nullptr, 0);
+    proc.pid = -1;
+  }
+}
+
+auto read_line(child& proc) -> asio::awaitable<std::string> {
+  auto const size{ co_await asio::async_read_until(*proc.output, asio::dynamic_buffer(proc.buffer), '\n',
+                                                   asio::use_awaitable) };
+  std::string line{ proc.buffer.substr(0, size - 1) };
+  proc.buffer.erase(0, size);
+  co_return line;
+}
+
+auto read_report(child& proc) -> asio::awaitable<process_report> {
+  auto const line{ co_await read_line(proc) };
+  process_report report{};
+  if (auto const err{ glz::read_json(report, line) }) {
+    throw std::runtime_error{ fmt::format("unreadable report: {}", line) };
+  }
+  co_return report;
+}
+
+/// \brief poll the ipc-ruler until every name is registered
+auto wait_registered(asio::io_context& ctx,
+                     tfc::ipc_ruler::ipc_manager_client& client,
+                     std::vector<std::string> const& signal_names,
+                     std::vector<std::string> const& slot_names) -> asio::awaitable<void> {
+  auto const contains_all{ [](auto const& entries, std::vector<std::string> const& names) {
+    return std::ranges::all_of(names, [&entries](std::string const& name) {
+      return std::ranges::any_of(entries, [&name](auto const& entry) { return entry.name == name; });
+    });
+  } };
+  bool signals_found{};
+  bool slots_found{};
+  asio::steady_timer timer{ ctx };
+  auto const deadline{ std::chrono::steady_clock::now() + registration_timeout };
+  while (!signals_found || !slots_found) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      throw std::runtime_error{ "timed out waiting for the ipc-ruler to know every signal and slot" };
+    }
+    client.signals([&](auto const& signals) { signals_found = contains_all(signals, signal_names); });
+    client.slots([&](auto const& slots) { slots_found = contains_all(slots, slot_names); });
+    timer.expires_after(std::chrono::milliseconds{ 50 });
+    co_await timer.async_wait(asio::use_awaitable);
+  }
+}
+
+auto connect_all(asio::io_context& ctx,
+                 tfc::ipc_ruler::ipc_manager_client& client,
+                 std::vector<std::pair<std::string, std::string>> const& connections) -> asio::awaitable<void> {
+  std::optional<std::error_code> result{};
+  client.connect_many(connections, [&result](std::error_code const& err) { result = err; });
+  asio::steady_timer timer{ ctx };
+  while (!result.has_value()) {
+    timer.expires_after(std::chrono::milliseconds{ 10 });
+    co_await timer.async_wait(asio::use_awaitable);
+  }
+  if (result.value()) {
+    throw std::system_error{ result.value(), "ConnectMany" };
+  }
+}
+
+/// \brief common arguments of the publisher and subscriber processes of one sweep point
+auto child_args(options const& opts, std::string_view role, std::string id, std::string_view type, std::uint64_t rate,
+                std::size_t publishers) -> std::vector<std::string> {
+  return { std::string{ tfc::base::get_exe_name() },
+           "--role",
+           std::string{ role },
+           "--id",
+           std::move(id),
+           "--types",
+           std::string{ type },
+           "--rates",
+           fmt::format("{}", rate),
+           "--publishers",
+           fmt::format("{}", publishers),
+           "--duration",
+           fmt::format("{}", opts.duration),
+           "--payload-bytes",
+           fmt::format("{}", opts.payload_bytes),
+           "--log-level",
+           "warn" };
+}
+
+auto run_point(asio::io_context& ctx,
+               tfc::ipc_ruler::ipc_manager_client& client,
+               options const& opts,
+               point_report point) -> asio::awaitable<point_report> {
+  std::string const self{ std::filesystem::read_symlink("/proc/self/exe").string() };
+  std::vector<child> publishers{};
+  std::vector<child> subscribers{};
+  std::vector<std::string> signal_names{};
+  std::vector<std::string> slot_names{};
+  std::vector<std::pair<std::string, std::string>> connections{};
+  auto const exe{ tfc::base::get_exe_name() };
+
+  auto const start{ [&](std::string_view role, std::string id, std::vector<child>& into) {
+    auto proc{ spawn(self, child_args(opts, role, std::move(id), point.type, point.rate, point.publishers), &ctx) };
+    if (!proc) {
+      throw std::system_error{ proc.error(), fmt::format("unable to start {}", role) };
+    }
+    into.emplace_back(std::move(proc.value()));
+  } };
+
+  // the watchdog ends every child if the point hangs, which fails the pending reads
+  asio::steady_timer watchdog{ ctx };
+  watchdog.expires_after(registration_timeout * 2 + std::chrono::seconds{ opts.duration });
+  watchdog.async_wait([&](std::error_code const& err) {
+    if (!err) {
+      for (auto& proc : publishers) {
+        kill(proc.pid, SIGKILL);
+      }
+      for (auto& proc : subscribers) {
+        kill(proc.pid, SIGKILL);
+      }
+    }
+  });
+
+  try {
+    for (std::size_t pub = 0; pub < point.publishers; pub++) {
+      auto id{ fmt::format("p{}pub{}", opts.point, pub) };
+      signal_names.emplace_back(fmt::format("{}.{}.{}.value", exe, id, point.type));
+      start("publisher", std::move(id), publishers);
+    }
+    for (std::size_t sub = 0; sub < point.subscribers; sub++) {
+      auto id{ fmt::format("p{}sub{}", opts.point, sub) };
+      for (std::size_t pub = 0; pub < point.publishers; pub++) {
+        slot_names.emplace_back(fmt::format("{}.{}.{}.pub{}", exe, id, point.type, pub));
+        connections.emplace_back(slot_names.back(), signal_names[pub]);
+      }
+      start("subscriber", std::move(id), subscribers);
+    }
+
+    co_await wait_registered(ctx, client, signal_names, slot_names);
+    co_await connect_all(ctx, client, connections);
+    for (auto& proc : subscribers) {
+      std::ignore = co_await read_line(proc);
+    }
+    // zmq subscriptions are asynchronous, give them time to reach the publishers
+    asio::steady_timer timer{ ctx };
+    timer.expires_after(settle_time);
+    co_await timer.async_wait(asio::use_awaitable);
+
+    for (auto& proc : publishers) {
+      co_await asio::async_write(*proc.input, asio::buffer(std::string_view{ "go\n" }), asio::use_awaitable);
+    }
+    std::uint64_t publisher_cpu{};
+    std::uint64_t publisher_allocations{};
+    for (auto& proc : publishers) {
+      auto const report{ co_await read_report(proc) };
+      point.sent += report.messages;
+      point.seconds = std::max(point.seconds, report.seconds);
+      publisher_cpu += report.cpu_ns;
+      publisher_allocations += report.allocations;
+    }
+
+    timer.expires_after(drain_time);
+    co_await timer.async_wait(asio::use_awaitable);
+    latency_histogram histogram{};
+    double receive_seconds{};
+    std::uint64_t subscriber_cpu{};
+    std::uint64_t subscriber_allocations{};
+    for (auto& proc : subscribers) {
+      proc.input->close();
+      auto const report{ co_await read_report(proc) };
+      point.received += report.messages;
+      receive_seconds = std::max(receive_seconds, report.seconds);
+      subscriber_cpu += report.cpu_ns;
+      subscriber_allocations += report.allocations;
+      histogram.merge(report.latency, report.max_latency_ns);
+    }
+
+    auto const per{ [](std::uint64_t total, std::uint64_t count) {
+      return count == 0 ? 0.0 : static_cast<double>(total) / static_cast<double>(count);
+    } };
+    point.expected = point.sent * point.subscribers;
+    point.throughput = receive_seconds > 0 ? static_cast<double>(point.received) / receive_seconds : 0.0;
+    point.p50_us = static_cast<double>(histogram.percentile(0.5)) / 1000.0;
+    point.p99_us = static_cast<double>(histogram.percentile(0.99)) / 1000.0;
+    point.p999_us = static_cast<double>(histogram.percentile(0.999)) / 1000.0;
+    point.max_us = static_cast<double>(histogram.max()) / 1000.0;
+    point.publisher_cpu_us_per_message = per(publisher_cpu, point.sent) / 1000.0;
+    point.subscriber_cpu_us_per_message = per(subscriber_cpu, point.received) / 1000.0;
+    point.publisher_allocations_per_message = per(publisher_allocations, point.sent);
+    point.subscriber_allocations_per_message = per(subscriber_allocations, point.received);
+  } catch (std::exception const& exc) {
+    point.error = exc.what();
+  }
+  watchdog.cancel();
+  for (auto& proc : publishers) {
+    terminate(proc);
+  }
+  for (auto& proc : subscribers) {
+    terminate(proc);
+  }
+  co_return point;
+}
+
+auto orchestrate(asio::io_context& ctx, options opts) -> asio::awaitable<void> {
+  tfc::ipc_ruler::ipc_manager_client client{ ctx };
+
+  // the ipc-ruler is up once it answers
+  bool ready{};
+  asio::steady_timer timer{ ctx };
+  for (auto const deadline{ std::chrono::steady_clock::now() + registration_timeout }; !ready;) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      fmt::println(stderr, "ipc-ruler did not answer on {}", opts.bus);
+      ctx.stop();
+      co_return;
+    }
+    client.signals([&ready](auto const&) { ready = true; });
+    timer.expires_after(std::chrono::milliseconds{ 100 });
+    co_await timer.async_wait(asio::use_awaitable);
+  }
+
+  std::vector<point_report> reports{};
+  for (auto const& type : opts.types) {
+    for (auto const rate : opts.rates) {
+      for (auto const publishers : opts.publishers) {
+        for (auto const subscribers : opts.subscribers) {
+          point_report point{ .type = type,
+                              .rate = rate,
+                              .publishers = publishers,
+                              .subscribers = subscribers,
+                              .payload_bytes = type == tfc::ipc::details::type_string::type_name ? opts.payload_bytes : 0 };
+          fmt::println(stderr, "{} rate {} publishers {} subscribers {}", type, rate, publishers, subscribers);
+          reports.emplace_back(co_await run_point(ctx, client, opts, std::move(point)));
+          if (!reports.back().error.empty()) {
+            fmt::println(stderr, "  failed: {}", reports.back().error);
+          }
+          opts.point++;
+        }
+      }
+    }
+  }
+
+  auto const json{ glz::write_json(reports).value_or("[]") };
+  if (opts.output.empty()) {
+    print_line(json);
+  } else if (auto const err{ glz::buffer_to_file(json, opts.output) }) {
+    fmt::println(stderr, "Unable to write {}", opts.output);
+  }
+  ctx.stop();
+}
+
+/// \brief start a D-Bus daemon of our own and point the system bus of every process we start at it
+auto start_bus() -> std::expected<child, std::string> {
+  std::array<int, 2> address{ -1, -1 };
+  if (pipe2(address.data(), O_CLOEXEC) == -1) {
+    return std::unexpected(std::error_code{ errno, std::system_category() }.message());
+  }
+  posix_spawn_file_actions_t actions{};
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, address[1], STDOUT_FILENO);
+  std::array<char const*, 6> argv{ "dbus-daemon", "--session", "--nofork", "--nopidfile", "--print-address=1", nullptr };
+  pid_t pid{};
+  int const result{ posix_spawnp(&pid, argv[0], &actions, nullptr, const_cast<char* const*>(argv.data()), environ) };
+  posix_spawn_file_actions_destroy(&actions);
+  close(address[1]);
+  if (result != 0) {
+    close(address[0]);
+    return std::unexpected(
+        fmt::format("unable to start dbus-daemon: {}", std::error_code{ result, std::system_category() }.message()));
+  }
+  std::string line{};
+  char character{};
+  while (read(address[0], &character, 1) == 1 && character != '\n') {
+    line += character;
+  }
+  close(address[0]);
+  if (line.empty()) {
+    child daemon{ .pid = pid };
+    terminate(daemon);
+    return std::unexpected("dbus-daemon did not print its address");
+  }
+  setenv("DBUS_SYSTEM_BUS_ADDRESS", line.c_str(), 1);
+  return child{ .pid = pid };
+}
+
+auto run_orchestrator(options const& opts) -> int {
+  // confman files of the ipc-ruler, publishers and subscribers
+  auto const config_directory{ std::filesystem::temp_directory_path() / fmt::format("tfc_ipc_bench_{}", getpid()) };
+  std::filesystem::create_directories(config_directory);
+  setenv("CONFIGURATION_DIRECTORY", config_directory.c_str(), 1);
+
+  child bus{};
+  if (opts.bus.empty()) {
+    auto started{ start_bus() };
+    if (!started) {
+      fmt::println(stderr, "{}", started.error());
+      return EXIT_FAILURE;
+    }
+    bus = std::move(started.value());
+  } else {
+    setenv("DBUS_SYSTEM_BUS_ADDRESS", opts.bus.c_str(), 1);
+  }
+  auto ruler{ spawn(opts.ruler, { opts.ruler, "--memory", "--log-level", "warn" }, nullptr) };
+  if (!ruler) {
+    fmt::println(stderr, "Unable to start {}: {}", opts.ruler, ruler.error().message());
+    terminate(bus);
+    return EXIT_FAILURE;
+  }
+
+  int exit_code{ EXIT_SUCCESS };
+  {
+    asio::io_context ctx{};
+    asio::co_spawn(ctx, orchestrate(ctx, opts), [&exit_code](std::exception_ptr const& exc) {
+      if (exc) {
+        exit_code = EXIT_FAILURE;
+        try {
+          std::rethrow_exception(exc);
+        } catch (std::exception const& err) {
+          fmt::println(stderr, "{}", err.what());
+        }
+      }
+    });
+    ctx.run();
+  }
+  terminate(ruler.value());
+  terminate(bus);
+  std::error_code ignore{};
+  std::filesystem::remove_all(config_directory, ignore);
+  return exit_code;
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  options opts{};
+  auto description{ tfc::base::default_description() };
+  // clang-format off
+  description.add_options()
+    ("role", bpo::value<std::string>(&opts.role)->default_value(opts.role), "orchestrator, publisher or subscriber, the orchestrator starts the others")
+    ("types", bpo::value<std::vector<std::string>>(&opts.types)->multitoken()->default_value(opts.types, fmt::format("{}", fmt::join(opts.types, " "))), "Value types to sweep: int64, uint64, double or string")
+    ("rates", bpo::value<std::vector<std::uint64_t>>(&opts.rates)->multitoken()->default_value(opts.rates, fmt::format("{}", fmt::join(opts.rates, " "))), "Values per second of each publisher to sweep, 0 sends as fast as possible")
+    ("publishers", bpo::value<std::vector<std::size_t>>(&opts.publishers)->multitoken()->default_value(opts.publishers, fmt::format("{}", fmt::join(opts.publishers, " "))), "Numbers of publisher processes to sweep")
+    ("subscribers", bpo::value<std::vector<std::size_t>>(&opts.subscribers)->multitoken()->default_value(opts.subscribers, fmt::format("{}", fmt::join(opts.subscribers, " "))), "Numbers of subscriber processes to sweep, each subscribes to every publisher")
+    ("duration", bpo::value<std::uint64_t>(&opts.duration)->default_value(opts.duration), "Seconds each publisher sends for")
+    ("payload-bytes", bpo::value<std::size_t>(&opts.payload_bytes)->default_value(opts.payload_bytes), "Size of string values")
+    ("ruler", bpo::value<std::string>(&opts.ruler)->default_value(opts.ruler), "ipc-ruler executable, started with --memory")
+    ("bus", bpo::value<std::string>(&opts.bus), "D-Bus address to use instead of starting a dbus-daemon")
+    ("output", bpo::value<std::string>(&opts.output), "Write the JSON results to this file instead of stdout");
+  // clang-format on
+  tfc::base::init(argc, argv, description);
+
+  if (opts.role == "orchestrator") {
+    return run_orchestrator(opts);
+  }
+
+  asio::io_context ctx{};
+  bool const known{ with_type(opts.types.front(), [&]<typename type_desc>() {
+    if (opts.role == "publisher") {
+      asio::co_spawn(ctx, publish<type_desc>(ctx, opts), asio::detached);
+    } else {
+      asio::co_spawn(ctx, subscribe<type_desc>(ctx, opts), asio::detached);
+    }
+  }) };
+  if (!known) {
+    fmt::println(stderr, "Unknown type: {}", opts.types.front());
+    return EXIT_FAILURE;
+  }
+  ctx.run();
+  return EXIT_SUCCESS;
+}
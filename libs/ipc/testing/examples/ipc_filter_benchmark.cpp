@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <fmt/core.h>
+#include <boost/asio.hpp>
+#include <sdbusplus/asio/connection.hpp>
+
+#include <tfc/dbus/sd_bus.hpp>
+#include <tfc/ipc/details/filter.hpp>
+#include <tfc/progbase.hpp>
+#include <tfc/stubs/confman.hpp>
+
+namespace asio = boost::asio;
+
+using tfc::ipc::filter::filter;
+using tfc::ipc::filter::filter_e;
+using value_t = std::int64_t;
+using config_t = tfc::ipc::filter::config_t<value_t>;
+using callback_t = std::function<void(value_t)>;
+using filters_t = tfc::ipc::filter::
+    filters<value_t, callback_t, tfc::confman::stub_config<tfc::ipc::filter::observable_config_t<value_t>>>;
+
+namespace {
+
+constexpr std::size_t iterations{ 1000000 };
+
+auto three_stage_chain() -> config_t {
+  return { filter<filter_e::offset, value_t>{ .offset = 2 }, filter<filter_e::multiply, value_t>{ .multiply = 3 },
+           filter<filter_e::filter_out, value_t>{ .filter_out = -1 } };
+}
+
+void report(std::string_view label, std::chrono::steady_clock::duration elapsed, std::size_t received) {
+  std::chrono::duration<double> const seconds{ elapsed };
+  fmt::print("{:<10} {:>12.0f} values/sec  received {}\n", label, static_cast<double>(iterations) / seconds.count(),
+             received);
+}
+
+/// \brief the filters pipeline, the chain is synchronous so every value is processed within the call
+void bench_inline(std::shared_ptr<sdbusplus::asio::connection> const& connection) {
+  std::size_t received{};
+  filters_t filters{ connection, "inline", [&received](value_t) { received++; } };
+  filters.config().make_change().value() = three_stage_chain();
+  auto const start{ std::chrono::steady_clock::now() };
+  for (std::size_t idx = 0; idx < iterations; idx++) {
+    filters(static_cast<value_t>(idx));
+  }
+  report("inline", std::chrono::steady_clock::now() - start, received);
+}
+
+/// \brief a coroutine per value awaiting each stage, how every chain was processed before the inline path
+void bench_coroutine(asio::io_context& ctx) {
+  std::size_t received{};
+  auto const chain{ three_stage_chain() };
+  auto const start{ std::chrono::steady_clock::now() };
+  for (std::size_t idx = 0; idx < iterations; idx++) {
+    asio::co_spawn(
+        ctx,
+        [&chain, value = static_cast<value_t>(idx)] mutable -> asio::awaitable<std::expected<value_t, std::error_code>> {
+          std::expected<value_t, std::error_code> return_value{ value };
+          for (auto const& stage : chain) {
+            return_value = co_await std::visit(
+                [&return_value](auto const& arg) {
+                  return arg.async_process(std::move(return_value.value()), asio::use_awaitable);
+                },
+                stage);
+            if (!return_value.has_value()) {
+              break;
+            }
+          }
+          co_return return_value;
+        },
+        [&received](std::exception_ptr const&, std::expected<value_t, std::error_code> const& return_value) {
+          if (return_value.has_value()) {
+            received++;
+          }
+        });
+  }
+  ctx.run();
+  ctx.restart();
+  report("coroutine", std::chrono::steady_clock::now() - start, received);
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  tfc::base::init(argc, argv);
+
+  asio::io_context ctx{};
+  auto connection{ std::make_shared<sdbusplus::asio::connection>(ctx, tfc::dbus::sd_bus_open_system()) };
+
+  fmt::print("offset -> multiply -> filter_out, {} values\n", iterations);
+  bench_inline(connection);
+  bench_coroutine(ctx);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+#include <mp-units/systems/si.h>
+#include <boost/asio.hpp>
+
+#include <tfc/ipc/details/impl.hpp>
+#include <tfc/progbase.hpp>
+
+namespace asio = boost::asio;
+using tfc::ipc::details::transport_e;
+
+namespace {
+
+constexpr std::size_t iterations{ 10000 };
+constexpr auto receive_timeout{ std::chrono::seconds(1) };
+
+template <typename type_desc>
+auto make_value(std::size_t idx) -> typename type_desc::value_t {
+  using value_t = typename type_desc::value_t;
+  if constexpr (std::same_as<value_t, bool>) {
+    return idx % 2 == 0;
+  } else if constexpr (std::same_as<value_t, double>) {
+    return static_cast<double>(idx) * 0.5;
+  } else if constexpr (std::same_as<value_t, tfc::ipc::details::mass_t>) {
+    return static_cast<std::int64_t>(idx) * mp_units::si::gram;
+  } else {
+    // 4 KiB json document, a changing prefix defeats the slots duplicate value filter
+    std::string json{ fmt::format(R"({{"idx":{},"pad":")", idx) };
+    json.resize(4096 - 2, 'x');
+    json += R"("})";
+    return json;
+  }
+}
+
+/// \brief round trip latency from signal send until the slot callback runs, one value in flight at a time
+template <typename type_desc>
+void bench(asio::io_context& ctx, transport_e transport, std::string_view label) {
+  std::string const name{ fmt::format("bench_{}_{}", type_desc::type_name, std::to_underlying(transport)) };
+  auto signal{ tfc::ipc::details::signal<type_desc>::create(ctx, name, transport) };
+  if (!signal) {
+    fmt::print("{:<8} {:<5} unable to create signal: {}\n", type_desc::type_name, label, signal.error().message());
+    return;
+  }
+  auto slot{ tfc::ipc::details::slot_callback<type_desc>::create(ctx, name, transport) };
+  std::size_t received{};
+  if (auto err{ slot->connect(signal.value()->full_name(), [&received](auto const&) { received++; }) }) {
+    fmt::print("{:<8} {:<5} unable to connect slot: {}\n", type_desc::type_name, label, err.message());
+    return;
+  }
+
+  auto const wait_for{ [&ctx, &received](std::size_t count) {
+    auto const deadline{ std::chrono::steady_clock::now() + receive_timeout };
+    while (received < count && std::chrono::steady_clock::now() < deadline) {
+      ctx.run_one_for(std::chrono::milliseconds(1));
+    }
+    return received >= count;
+  } };
+
+  // zmq subscriptions are asynchronous, keep sending until the slot is attached
+  std::size_t sent{};
+  while (received == 0 && sent < 1000) {
+    std::ignore = signal.value()->send(make_value<type_desc>(sent++));
+    wait_for(1);
+  }
+
+  std::vector<std::chrono::nanoseconds> samples{};
+  samples.reserve(iterations);
+  for (std::size_t idx = 0; idx < iterations; idx++) {
+    auto const expected{ received + 1 };
+    auto const value{ make_value<type_desc>(sent++) };
+    auto const start{ std::chrono::steady_clock::now() };
+    std::ignore = signal.value()->send(value);
+    if (!wait_for(expected)) {
+      fmt::print("{:<8} {:<5} timed out after {} values\n", type_desc::type_name, label, idx);
+      return;
+    }
+    samples.emplace_back(std::chrono::steady_clock::now() - start);
+  }
+  std::ranges::sort(samples);
+  auto const percentile{ [&samples](double fraction) {
+    return std::chrono::duration<double, std::micro>(samples[static_cast<std::size_t>(fraction * (samples.size() - 1))])
+        .count();
+  } };
+  fmt::print("{:<8} {:<5} p50 {:>9.2f} us  p99 {:>9.2f} us  max {:>9.2f} us\n", type_desc::type_name, label,
+             percentile(0.5), percentile(0.99), percentile(1.0));
+}
+
+template <typename type_desc>
+void bench_both(asio::io_context& ctx) {
+  bench<type_desc>(ctx, transport_e::zmq, "zmq");
+  bench<type_desc>(ctx, transport_e::shm, "shm");
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  tfc::base::init(argc, argv);
+
+  asio::io_context ctx{};
+
+  bench_both<tfc::ipc::details::type_bool>(ctx);
+  bench_both<tfc::ipc::details::type_double>(ctx);
+  bench_both<tfc::ipc::details::type_mass>(ctx);
+  bench_both<tfc::ipc::details::type_json>(ctx);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/core.h>
+#include <mp-units/systems/si.h>
+
+#include <tfc/ipc/details/type_description.hpp>
+#include <tfc/ipc/packet.hpp>
+#include <tfc/progbase.hpp>
+
+using tfc::ipc::details::version_e;
+using tfc::ipc::details::wire_format;
+
+namespace {
+
+constexpr std::size_t iterations{ 1000000 };
+
+template <typename type_desc>
+auto make_value() -> typename type_desc::value_t {
+  using value_t = typename type_desc::value_t;
+  if constexpr (std::same_as<value_t, bool>) {
+    return true;
+  } else if constexpr (std::same_as<value_t, double>) {
+    return 4.21337;
+  } else if constexpr (std::same_as<value_t, tfc::ipc::details::mass_t>) {
+    return 1337 * mp_units::si::gram;
+  } else {
+    return std::string(4096, 'x');
+  }
+}
+
+/// \brief serialize and deserialize the same value repeatedly into a reused buffer, the way a signal does
+template <typename type_desc>
+void bench(wire_format format, std::string_view label) {
+  using packet_t = tfc::ipc::details::packet<typename type_desc::value_t, type_desc::value_e>;
+  auto const value{ make_value<type_desc>() };
+  std::vector<std::byte> buffer{};
+  buffer.reserve(packet_t::reserve_size());
+
+  auto const serialize_start{ std::chrono::steady_clock::now() };
+  for (std::size_t idx = 0; idx < iterations; idx++) {
+    buffer.clear();
+    std::ignore = packet_t::serialize(value, buffer, format);
+  }
+  std::chrono::duration<double, std::nano> const serialize_time{ std::chrono::steady_clock::now() - serialize_start };
+
+  std::size_t valid{};
+  auto const deserialize_start{ std::chrono::steady_clock::now() };
+  for (std::size_t idx = 0; idx < iterations; idx++) {
+    valid += packet_t::deserialize(std::span{ buffer }).has_value() ? 1 : 0;
+  }
+  std::chrono::duration<double, std::nano> const deserialize_time{ std::chrono::steady_clock::now() - deserialize_start };
+
+  fmt::print("{:<8} {:<7} {:>5} bytes  serialize {:>8.1f} ns  deserialize {:>8.1f} ns{}\n", type_desc::type_name, label,
+             buffer.size(), serialize_time.count() / iterations, deserialize_time.count() / iterations,
+             valid == iterations ? "" : "  (deserialize failed)");
+}
+
+template <typename type_desc>
+void bench_all() {
+  bench<type_desc>(wire_format{ .version = version_e::v0, .crc = false }, "v0");
+  bench<type_desc>(wire_format{ .version = version_e::v1, .crc = false }, "v1");
+  bench<type_desc>(wire_format{ .version = version_e::v1, .crc = true }, "v1+crc");
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  tfc::base::init(argc, argv);
+
+  bench_all<tfc::ipc::details::type_bool>();
+  bench_all<tfc::ipc::details::type_double>();
+  bench_all<tfc::ipc::details::type_mass>();
+  bench_all<tfc::ipc::details::type_json>();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <tfc/ipc/item.hpp>
+#include <tfc/ipc/item_binary.hpp>
+#include <tfc/progbase.hpp>
+
+namespace item = tfc::ipc::item;
+using item::binary::field_e;
+
+namespace {
+
+constexpr std::size_t work_per_point{ 200000 };
+
+auto make_tub(std::size_t children) -> item::item {
+  auto tub{ item::make() };
+  tub.barcode = "5701234567890";
+  tub.category = item::details::category_e::tub;
+  tub.fao_species = item::fao::atlantic_cod;
+  tub.item_weight = std::int64_t{ 25000000 } * item::item::milligram_64bit::reference;
+  tub.supplier = item::details::supplier{ .name = "Vessel", .contact_info = "+354 000 0000", .country = "IS" };
+  auto& fishes{ tub.items.emplace() };
+  fishes.reserve(children);
+  for (std::size_t idx = 0; idx < children; idx++) {
+    auto& fish{ fishes.emplace_back(item::make()) };
+    fish.fao_species = item::fao::haddock;
+    fish.item_weight = static_cast<std::int64_t>(1000 + idx) * item::item::milligram_64bit::reference;
+  }
+  return tub;
+}
+
+/// \return nanoseconds per call of function
+auto measure(std::size_t iterations, auto&& function) -> double {
+  auto const start{ std::chrono::steady_clock::now() };
+  for (std::size_t idx = 0; idx < iterations; idx++) {
+    function();
+  }
+  std::chrono::duration<double, std::nano> const elapsed{ std::chrono::steady_clock::now() - start };
+  return elapsed.count() / static_cast<double>(iterations);
+}
+
+void bench(std::size_t children) {
+  auto const tub{ make_tub(children) };
+  auto const iterations{ std::max<std::size_t>(work_per_point / (children + 1), 20) };
+  std::size_t valid{};
+
+  auto const json{ tub.to_json().value() };
+  auto const json_write{ measure(iterations, [&tub] { std::ignore = tub.to_json(); }) };
+  auto const json_read{ measure(iterations, [&json, &valid] { valid += item::item::from_json(json).has_value() ? 1 : 0; }) };
+
+  std::vector<std::byte> bytes{};
+  auto const binary_write{ measure(iterations, [&tub, &bytes] {
+    bytes.clear();
+    item::binary::encode(tub, bytes);
+  }) };
+  auto const binary_read{ measure(iterations,
+                                  [&bytes, &valid] { valid += item::item::from_binary(bytes).has_value() ? 1 : 0; }) };
+  // what a subscriber interested in one field pays, the weight of the last child
+  auto const view_read{ measure(iterations, [&bytes, &valid] {
+    auto const view{ item::binary::view::parse(bytes) };
+    std::optional<item::item::milligram_64bit> weight{};
+    for (auto const child : view->items()) {
+      weight = child->get<field_e::item_weight>();
+    }
+    valid += view->get<field_e::item_weight>().has_value() && (weight.has_value() || view->items().empty()) ? 1 : 0;
+  }) };
+
+  fmt::print("{:>5} children  json {:>8} bytes  write {:>11.1f} ns  read {:>11.1f} ns\n", children, json.size(), json_write,
+             json_read);
+  fmt::print("{:>5} children  binary {:>6} bytes  write {:>11.1f} ns  read {:>11.1f} ns  view one field {:>11.1f} ns{}\n",
+             children, bytes.size(), binary_write, binary_read, view_read, valid == 3 * iterations ? "" : "  (read failed)");
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  tfc::base::init(argc, argv);
+
+  for (std::size_t const children : { 0, 10, 1000 }) {
+    bench(children);
+  }
+  return 0;
+}
@@ -18,6 +18,9 @@ static_assert(enum_cast("mass") == type_e::_mass);
 static_assert(enum_cast("length") == type_e::_length);
 static_assert(enum_cast("pressure") == type_e::_pressure);
 static_assert(enum_cast("temperature") == type_e::_temperature);
+static_assert(enum_cast("struct") == type_e::_struct);
+static_assert(enum_cast("tfcctl.def.bool.construct") == type_e::_bool);
+static_assert(enum_cast("tfcctl.def.struct.axis") == type_e::_struct);
 
 static_assert(enum_name(type_e::unknown) == "unknown");
 static_assert(enum_name(type_e::_bool) == "bool");
@@ -30,6 +33,7 @@ static_assert(enum_name(type_e::_mass) == "mass");
 static_assert(enum_name(type_e::_length) == "length");
 static_assert(enum_name(type_e::_pressure) == "pressure");
 static_assert(enum_name(type_e::_temperature) == "temperature");
+static_assert(enum_name(type_e::_struct) == "struct");
 
 auto main() -> int {
   return 0;
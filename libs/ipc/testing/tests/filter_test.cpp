@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <chrono>
+#include <functional>
+#include <limits>
 #include <string>
 
 #include <fmt/chrono.h>
@@ -256,6 +259,152 @@ auto main(int, char**) -> int {
     ctx.run_one_for(1ms);
   };
 
+  "filter median"_test = [] {
+    filter<filter_e::median, std::int64_t> const median_test{ .median_window = 3 };
+    std::vector<std::int64_t> outputs{};
+    for (std::int64_t const value : { 1, 5, 2, 8, 3, 3, 9 }) {
+      auto return_value = median_test.process(std::int64_t{ value });
+      expect(return_value.has_value() >> fatal);
+      outputs.emplace_back(return_value.value());
+    }
+    // the window is averaged around the middle while it holds an even number of values
+    expect(outputs == std::vector<std::int64_t>{ 1, 3, 2, 5, 3, 3, 3 });
+  };
+
+  "filter quantile"_test = [] {
+    filter<filter_e::quantile, std::double_t> const quantile_test{ .quantile_window = 10, .quantile = 0.9 };
+    std::expected<std::double_t, std::error_code> return_value{};
+    for (std::int64_t idx = 1; idx <= 25; idx++) {
+      return_value = quantile_test.process(static_cast<std::double_t>(idx));
+    }
+    expect(return_value.has_value() >> fatal);
+    expect(return_value.value() > 23.9 && return_value.value() < 24.1);
+  };
+
+  "filter sliding window moving average"_test = [] {
+    filter<filter_e::sliding_window_moving_average, std::double_t> const average_test{ .moving_average_window = 4 };
+    std::vector<std::double_t> outputs{};
+    for (std::int64_t idx = 1; idx <= 12; idx++) {
+      outputs.emplace_back(average_test.process(static_cast<std::double_t>(idx)).value());
+    }
+    expect(outputs.at(0) > 0.99 && outputs.at(0) < 1.01);
+    expect(outputs.at(3) > 2.49 && outputs.at(3) < 2.51);
+    expect(outputs.at(11) > 10.49 && outputs.at(11) < 10.51);
+  };
+
+  "filter exponential moving average"_test = [] {
+    filter<filter_e::exponential_moving_average, std::int64_t> const average_test{ .alpha = 0.5 };
+    expect(average_test.process(0).value() == 0);
+    expect(average_test.process(100).value() == 50);
+    expect(average_test.process(100).value() == 75);
+  };
+
+  "filter delta"_test = [] {
+    filter<filter_e::delta, std::uint64_t> const delta_test{ .delta = 5 };
+    expect(delta_test.process(0).has_value());
+    expect(delta_test.process(4).error() == std::errc::bad_message);
+    expect(delta_test.process(6).has_value());
+    expect(delta_test.process(2).error() == std::errc::bad_message);
+    expect(delta_test.process(0).has_value());
+  };
+
+  "filter calibrate linear"_test = [] {
+    filter<filter_e::calibrate_linear, std::double_t> calibrate_test{};
+    expect(calibrate_test.process(5).value() > 4.99 && calibrate_test.process(5).value() < 5.01);
+    calibrate_test.calibrate_linear = { { .from = 0, .to = 10 }, { .from = 10, .to = 30 } };
+    auto const return_value{ calibrate_test.process(5) };
+    expect(return_value.value() > 19.99 && return_value.value() < 20.01);
+
+    // the fit is kept until the configuration is read again
+    calibrate_test.calibrate_linear = { { .from = 0, .to = 0 }, { .from = 10, .to = 20 } };
+    calibrate_test.config_changed();
+    expect(calibrate_test.process(5).value() > 9.99 && calibrate_test.process(5).value() < 10.01);
+  };
+
+  "statistical filters saturate integral results"_test = [] {
+    filter<filter_e::calibrate_linear, std::uint64_t> const below_zero{ .calibrate_linear = { { .from = 0, .to = -10 },
+                                                                                              { .from = 10, .to = 0 } } };
+    expect(below_zero.process(5).value() == 0);
+    filter<filter_e::calibrate_linear, std::int64_t> const overflow{ .calibrate_linear = { { .from = 0, .to = 0 },
+                                                                                           { .from = 1, .to = 1e30 } } };
+    expect(overflow.process(1).value() == std::numeric_limits<std::int64_t>::max());
+    expect(overflow.process(-1).value() == std::numeric_limits<std::int64_t>::lowest());
+  };
+
+  "statistical filters pass quantity errors through"_test = [] {
+    using tfc::ipc::details::mass_t;
+    filter<filter_e::median, mass_t> const median_test{ .median_window = 3 };
+    expect(median_test.process(10 * mp_units::si::gram).value().value() == 10 * mp_units::si::gram);
+    mass_t const error{ std::unexpected(tfc::ipc::details::mass_error_e::cell_fault) };
+    expect(median_test.process(mass_t{ error }).value() == error);
+    expect(median_test.process(20 * mp_units::si::gram).value().value() == 15 * mp_units::si::gram);
+  };
+
+  "copied filter starts without state"_test = [] {
+    filter<filter_e::exponential_moving_average, std::int64_t> const average_test{ .alpha = 0.5 };
+    expect(average_test.process(100).value() == 100);
+    auto const copy{ average_test };
+    expect(copy == average_test);
+    expect(copy.process(0).value() == 0);
+    expect(average_test.process(0).value() == 50);
+  };
+
+  "filter throttle"_test = [] {
+    using throttle_filter =
+        filter<filter_e::throttle, std::int64_t, asio::basic_waitable_timer<tfc::testing::clock, tfc::testing::wait_traits>>;
+    asio::io_context ctx{};
+    // the first value completes without waiting, keep the context from running out of work
+    auto const work{ asio::make_work_guard(ctx) };
+    throttle_filter const throttle_test{ .throttle = 42ms };
+    std::vector<std::expected<std::int64_t, std::error_code>> outputs{};
+    auto const process{ [&](std::int64_t value) {
+      throttle_test.async_process(std::move(value), asio::bind_executor(ctx.get_executor(), [&outputs](auto&& result) {
+                                    outputs.emplace_back(std::forward<decltype(result)>(result));
+                                  }));
+    } };
+    process(1);  // passed immediately
+    process(2);  // waits for the end of the period
+    process(3);  // replaces 2
+    ctx.run_for(1ms);
+    expect(outputs.size() == 2 >> fatal);
+    expect(outputs.at(0).value() == 1);
+    expect(outputs.at(1).error() == std::errc::operation_canceled);
+    tfc::testing::clock::set_ticks(tfc::testing::clock::now() + 42ms);
+    ctx.run_for(1ms);
+    expect(outputs.size() == 3 >> fatal);
+    expect(outputs.at(2).value() == 3);
+  };
+
+  "filter throttle average"_test = [] {
+    using throttle_average_filter = filter<filter_e::throttle_average,
+                                           std::double_t,
+                                           asio::basic_waitable_timer<tfc::testing::clock, tfc::testing::wait_traits>>;
+    asio::io_context ctx{};
+    throttle_average_filter const throttle_test{ .throttle_average = 42ms };
+    std::vector<std::expected<std::double_t, std::error_code>> outputs{};
+    for (std::double_t const value : { 1.0, 2.0, 6.0 }) {
+      throttle_test.async_process(std::double_t{ value },
+                                  asio::bind_executor(ctx.get_executor(), [&outputs](auto&& result) {
+                                    outputs.emplace_back(std::forward<decltype(result)>(result));
+                                  }));
+    }
+    ctx.run_for(1ms);
+    expect(outputs.size() == 2 >> fatal);
+    tfc::testing::clock::set_ticks(tfc::testing::clock::now() + 42ms);
+    ctx.run_for(1ms);
+    expect(outputs.size() == 3 >> fatal);
+    expect(outputs.at(2).value() > 2.99 && outputs.at(2).value() < 3.01);
+  };
+
+  "statistical filters are configured by key"_test = [] {
+    auto const config{ glz::read_json<tfc::ipc::filter::config_t<tfc::ipc::details::mass_t>>(
+        R"([{"median_window":7},{"alpha":0.2},{"throttle":100}])") };
+    expect(config.has_value() >> fatal);
+    expect(config->size() == 3 >> fatal);
+    expect(std::get<filter<filter_e::median, tfc::ipc::details::mass_t>>(config->at(0)).median_window == 7);
+    expect(std::holds_alternative<filter<filter_e::exponential_moving_average, tfc::ipc::details::mass_t>>(config->at(1)));
+  };
+
 // reason is pure virtual method call in construction of
 // std::shared_ptr<sdbusplus::asio::connection> connection{ std::make_shared<sdbusplus::asio::connection>(ctx) };
 #ifdef __clang__
@@ -347,6 +496,65 @@ auto main(int, char**) -> int {
       expect(call_count == 2);
     };
   };
+
+  [[maybe_unused]] ut::suite<"filter pipeline"> pipeline = [] {
+    using value_t = std::int64_t;
+    struct pipeline_test {
+      asio::io_context ctx{};
+      std::shared_ptr<sdbusplus::asio::connection> connection{ std::make_shared<sdbusplus::asio::connection>(ctx) };
+      std::vector<value_t> received{};
+      tfc::ipc::filter::filters<value_t,
+                                std::function<void(value_t)>,
+                                tfc::confman::stub_config<tfc::ipc::filter::observable_config_t<value_t>>>
+          filters{ connection, "bar", [this](value_t value) { received.emplace_back(value); } };
+    };
+
+    "synchronous chain is processed within the call"_test = [] {
+      pipeline_test test{};
+      test.filters.config().make_change().value() = { filter<filter_e::offset, value_t>{ .offset = 1 },
+                                                      filter<filter_e::multiply, value_t>{ .multiply = 2 },
+                                                      filter<filter_e::filter_out, value_t>{ .filter_out = 6 } };
+      expect(test.filters.synchronous());
+      for (value_t value{}; value < 5; value++) {
+        test.filters(value_t{ value });
+      }
+      expect(test.received == std::vector<value_t>{ 2, 4, 8, 10 });
+    };
+
+    "asynchronous chain delivers values in order"_test = [] {
+      pipeline_test test{};
+      test.filters.config().make_change().value() = {
+        filter<filter_e::offset, value_t>{ .offset = 1 },
+        filter<filter_e::throttle, value_t, asio::steady_timer>{ .throttle = 0ms },
+      };
+      expect(!test.filters.synchronous());
+      for (value_t value{}; value < 100; value++) {
+        test.filters(value_t{ value });
+      }
+      test.ctx.run_for(10ms);
+      expect(test.received.size() == 100);
+      expect(std::ranges::is_sorted(test.received));
+    };
+
+    "a result completing after a newer value is dropped"_test = [] {
+      pipeline_test test{};
+      test.filters.config().make_change().value() = {
+        filter<filter_e::throttle_average, value_t, asio::steady_timer>{ .throttle_average = 5ms },
+      };
+      // 1 and 3 are averaged at the end of the period, a value set in the meantime is newer
+      test.filters(value_t{ 1 });
+      test.filters(value_t{ 3 });
+      test.filters.set(value_t{ 42 });
+      test.ctx.run_for(20ms);
+      expect(test.received == std::vector<value_t>{ 42 });
+      expect(test.filters.value() == 42);
+
+      // the next period is delivered again
+      test.filters(value_t{ 5 });
+      test.ctx.run_for(20ms);
+      expect(test.received == std::vector<value_t>{ 42, 5 });
+    };
+  };
 #endif
 
   return 0;
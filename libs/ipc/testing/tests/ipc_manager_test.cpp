@@ -1,3 +1,6 @@
+#include <filesystem>
+#include <string>
+
 #include <boost/asio.hpp>
 #include <boost/ut.hpp>
 
@@ -70,6 +73,53 @@ auto main(int argc, char** argv) -> int {
     ut::expect(ipc_manager->get_all_signals()[0].created_by == "sender");
   };
 
+  "ipc_manager connection index and write behind"_test = []() {
+    auto ipc_manager = std::make_unique<manager_t>(true);
+    ipc_manager->set_callback([](std::string_view, std::string_view) {});
+    ipc_manager->register_signal("sender", "first", "", tfc::ipc::details::type_e::_bool);
+    ipc_manager->register_signal("sender", "second", "", tfc::ipc::details::type_e::_bool);
+    ipc_manager->register_slot("receiver", "slot", "", tfc::ipc::details::type_e::_bool);
+    ut::expect(ipc_manager->pending_writes() == 3);
+
+    ipc_manager->connect("slot", "first");
+    auto const slots_json{ ipc_manager->slots_json() };
+    ut::expect(ipc_manager->get_all_connections() == std::map<std::string, std::vector<std::string>>{ { "first", { "slot" } } });
+    ipc_manager->persist();
+    ut::expect(ipc_manager->pending_writes() == 0);
+
+    // moving the slot updates the reverse index and invalidates the cached json
+    ipc_manager->connect("slot", "second");
+    ut::expect(ipc_manager->pending_writes() == 1);
+    ut::expect(ipc_manager->get_all_connections() ==
+               std::map<std::string, std::vector<std::string>>{ { "second", { "slot" } } });
+    ut::expect(ipc_manager->slots_json() != slots_json);
+    ut::expect(ipc_manager->connections_json() == R"({"second":["slot"]})") << ipc_manager->connections_json();
+
+    ipc_manager->disconnect("slot");
+    ut::expect(ipc_manager->get_all_connections().empty());
+    ipc_manager->persist();
+    ut::expect(ipc_manager->pending_writes() == 0);
+  };
+
+  "connections of a signal registered after its slots were loaded"_test = []() {
+    std::string const file{ tfc::ipc_ruler::config_file_name_populate_dir() };
+    std::filesystem::remove(file);
+    {
+      manager_t ipc_manager{};
+      ipc_manager.set_callback([](std::string_view, std::string_view) {});
+      ipc_manager.register_signal("sender", "late", "", tfc::ipc::details::type_e::_bool);
+      ipc_manager.register_slot("receiver", "slot", "", tfc::ipc::details::type_e::_bool);
+      ipc_manager.connect("slot", "late");
+    }
+    // the slot stays connected in the database while its signal is not registered yet after a restart
+    sqlite::database{ file } << "DELETE FROM signals;";
+
+    manager_t ipc_manager{};
+    ut::expect(ipc_manager.connections_json() == "{}") << ipc_manager.connections_json();
+    ipc_manager.register_signal("sender", "late", "", tfc::ipc::details::type_e::_bool);
+    ut::expect(ipc_manager.connections_json() == R"({"late":["slot"]})") << ipc_manager.connections_json();
+  };
+
   "get signals empty"_test = [] {
     test_instance instance{};
     // Check if the correct empty list is reported for signals
@@ -140,6 +190,124 @@ auto main(int argc, char** argv) -> int {
     ut::expect(instance.ran);
   };
 
+  "ipc_manager changes since generation"_test = []() {
+    using tfc::ipc_ruler::change_e;
+    auto ipc_manager = std::make_unique<manager_t>(true);
+    ipc_manager->set_callback([](std::string_view, std::string_view) {});
+    auto const start{ ipc_manager->generation() };
+    ut::expect(ipc_manager->changes_since(start).value().empty());
+    ut::expect(!ipc_manager->changes_since(start + 1).has_value());
+
+    ipc_manager->register_signal("sender", "signal", "", tfc::ipc::details::type_e::_bool);
+    ipc_manager->register_slot("receiver", "slot", "", tfc::ipc::details::type_e::_bool);
+    ipc_manager->connect("slot", "signal");
+    ipc_manager->register_signal("sender", "signal", "", tfc::ipc::details::type_e::_bool);
+    ipc_manager->disconnect("slot");
+    ut::expect(ipc_manager->generation() == start + 5);
+
+    auto const all{ ipc_manager->changes_since(start).value() };
+    ut::expect((all.size() == 5) >> ut::fatal);
+    ut::expect(all[0].kind == change_e::signal_added && all[0].signal_info->name == "signal");
+    ut::expect(all[1].kind == change_e::slot_added && all[1].slot_info->name == "slot");
+    ut::expect(all[2].kind == change_e::connected && all[2].slot_info->connected_to == "signal");
+    ut::expect(all[3].kind == change_e::signal_updated);
+    ut::expect(all[4].kind == change_e::disconnected && all[4].slot_info->connected_to.empty());
+    for (std::size_t idx = 0; idx < all.size(); idx++) {
+      ut::expect(all[idx].generation == start + idx + 1);
+    }
+    auto const tail{ ipc_manager->changes_since(start + 3).value() };
+    ut::expect(tail.size() == 2);
+    ut::expect(tail.front().generation == start + 4);
+
+    // failed connect does not produce a change
+    ipc_manager->connect("slot", "does_not_exist");
+    ut::expect(ipc_manager->generation() == start + 5);
+
+    // older changes are dropped, asking for them requires a new snapshot
+    for (std::size_t idx = 0; idx < manager_t::max_changes; idx++) {
+      ipc_manager->register_signal("sender", "signal", "", tfc::ipc::details::type_e::_bool);
+    }
+    ut::expect(!ipc_manager->changes_since(start).has_value());
+    ut::expect(ipc_manager->changes_since(ipc_manager->generation() - 1).value().size() == 1);
+  };
+
+  "changes are published over dbus"_test = [] {
+    test_instance instance{};
+    std::vector<tfc::ipc_ruler::change> received{};
+    std::uint64_t last_generation{};
+    auto match{ instance.ipc_manager_client.register_changes_callback(
+        [&](std::uint64_t generation, std::vector<tfc::ipc_ruler::change> const& changes) {
+          last_generation = generation;
+          received.insert(received.end(), changes.begin(), changes.end());
+        }) };
+    std::uint64_t start{};
+    instance.ipc_manager_client.generation([&](std::error_code const& err, std::uint64_t generation) {
+      ut::expect(!err);
+      start = generation;
+    });
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+
+    instance.ipc_manager_client.register_signal("changes_signal", "", tfc::ipc::details::type_e::_bool, [](auto const&) {});
+    instance.ipc_manager_client.register_slot("changes_slot", "", tfc::ipc::details::type_e::_bool, [](auto const&) {});
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+    instance.ipc_manager_client.connect("changes_slot", "changes_signal", [](auto const&) {});
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+    ut::expect(received.size() == 3) << received.size();
+    ut::expect(last_generation == start + 3);
+
+    instance.ipc_manager_client.changes_since(
+        start + 1, [&](std::error_code const& err, std::vector<tfc::ipc_ruler::change> const& changes) {
+          ut::expect(!err);
+          ut::expect(changes.size() == 2);
+          instance.ran = true;
+        });
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+    ut::expect(instance.ran);
+  };
+
+  "registrations in the same tick are batched"_test = [] {
+    test_instance instance{};
+    std::size_t answered{};
+    for (auto const* name : { "batch_signal_a", "batch_signal_b", "batch_signal_c" }) {
+      instance.ipc_manager_client.register_signal(name, "", tfc::ipc::details::type_e::_bool,
+                                                  [&answered](const std::error_code& err) {
+                                                    ut::expect(!err) << err.message();
+                                                    answered++;
+                                                  });
+    }
+    instance.ipc_manager_client.register_slot("batch_slot_a", "", tfc::ipc::details::type_e::_bool, [](const auto&) {});
+    instance.ipc_manager_client.register_slot("batch_slot_b", "", tfc::ipc::details::type_e::_bool, [](const auto&) {});
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+    ut::expect(answered == 3);
+    auto const& stats{ instance.ipc_manager_client.registration_stats() };
+    ut::expect(stats.batches == 2) << stats.batches;
+    ut::expect(stats.endpoints == 5) << stats.endpoints;
+    ut::expect(stats.startup_duration.has_value());
+
+    instance.ipc_manager_client.connect_many({ { "batch_slot_a", "batch_signal_a" }, { "batch_slot_b", "batch_signal_b" } },
+                                             [](const std::error_code& err) { ut::expect(!err); });
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+    instance.ipc_manager_client.connections([&instance](auto const& connections) {
+      ut::expect(connections.size() == 2);
+      instance.ran = true;
+    });
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+    ut::expect(instance.ran);
+  };
+
+  "a client destroyed before its registrations are flushed"_test = [] {
+    test_instance instance{};
+    bool answered{ false };
+    {
+      tfc::ipc_ruler::ipc_manager_client client{ instance.ipc_manager_client.connection() };
+      client.register_signal("orphan_signal", "", tfc::ipc::details::type_e::_bool,
+                             [&answered](const std::error_code&) { answered = true; });
+    }
+    // the posted flush runs after the client is gone and does nothing
+    instance.ctx.run_for(std::chrono::milliseconds(5));
+    ut::expect(!answered);
+  };
+
   "connection change subscription"_test = []() {
     test_instance instance{};
 
@@ -1,10 +1,21 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <tfc/ipc.hpp>
 #include <tfc/ipc/details/dbus_client_iface_mock.hpp>
 #include <tfc/ipc/packet.hpp>
 #include <tfc/progbase.hpp>
+#include <tfc/stx/to_tuple.hpp>
 
 #include <fmt/chrono.h>
 #include <fmt/core.h>
@@ -13,12 +24,60 @@
 
 namespace asio = boost::asio;
 
+namespace {
+std::atomic<std::size_t> allocations{};
+}  // namespace
+
+// every allocation of the test is counted, see "steady state send does not allocate"
+auto operator new(std::size_t size) -> void* {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr{ std::malloc(std::max<std::size_t>(size, 1)) }) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
 template <typename type_decl>
 struct data_t {
   using type_description = type_decl;
   type_decl::value_t value{};
 };
 
+struct axis_state {
+  std::int64_t position{};
+  double velocity{};
+  std::uint16_t error{};
+  constexpr auto operator==(axis_state const&) const noexcept -> bool = default;
+  static constexpr auto dbus_reflection{ [](auto&& self) {
+    return tfc::stx::to_tuple(std::forward<decltype(self)>(self));
+  } };
+};
+
+// same size as axis_state, other member types
+struct axis_command {
+  std::int64_t position{};
+  std::int64_t velocity{};
+  std::uint16_t error{};
+  constexpr auto operator==(axis_command const&) const noexcept -> bool = default;
+  static constexpr auto dbus_reflection{ [](auto&& self) {
+    return tfc::stx::to_tuple(std::forward<decltype(self)>(self));
+  } };
+};
+
+struct axis_trace {
+  std::array<axis_state, 8> samples{};
+  constexpr auto operator==(axis_trace const&) const noexcept -> bool = default;
+  static constexpr auto dbus_reflection{ [](auto&& self) {
+    return tfc::stx::to_tuple(std::forward<decltype(self)>(self));
+  } };
+};
+
 auto main(int argc, char** argv) -> int {
   tfc::base::init(argc, argv);
 
@@ -89,6 +148,143 @@ auto main(int argc, char** argv) -> int {
     };
   };
 
+  "packet wire versions"_test = [] {
+    using tfc::ipc::details::version_e;
+    using tfc::ipc::details::wire_format;
+    using mass_packet_t = packet<tfc::ipc::details::mass_t, type_e::_mass>;
+    constexpr std::array formats{ wire_format{ .version = version_e::v0, .crc = false },
+                                  wire_format{ .version = version_e::v1, .crc = false },
+                                  wire_format{ .version = version_e::v1, .crc = true } };
+    for (auto const format : formats) {
+      std::vector<std::byte> serialized{};
+      expect(!packet<bool, type_e::_bool>::serialize(true, serialized, format) >> fatal);
+      expect(packet<bool, type_e::_bool>::deserialize(std::span{ serialized }).value() == true);
+
+      serialized.clear();
+      expect(!mass_packet_t::serialize(1337 * mp_units::si::gram, serialized, format) >> fatal);
+      expect(mass_packet_t::deserialize(std::span{ serialized }).value() == 1337 * mp_units::si::gram);
+
+      serialized.clear();
+      tfc::ipc::details::mass_t const error{ std::unexpected(tfc::ipc::details::mass_error_e::cell_fault) };
+      expect(!mass_packet_t::serialize(error, serialized, format) >> fatal);
+      expect(mass_packet_t::deserialize(std::span{ serialized }).value() == error);
+
+      // varint length over multiple bytes
+      serialized.clear();
+      std::string const long_string(70000, 'x');
+      expect(!packet<std::string, type_e::_string>::serialize(long_string, serialized, format) >> fatal);
+      expect(packet<std::string, type_e::_string>::deserialize(std::span{ serialized }).value() == long_string);
+    }
+
+    std::vector<std::byte> serialized{};
+    expect(!packet<bool, type_e::_bool>::serialize(true, serialized) >> fatal);
+    expect(serialized.front() == std::byte{ std::to_underlying(version_e::v0) }) << "v0 unless asked for v1";
+    serialized.clear();
+    expect(!packet<bool, type_e::_bool>::serialize(true, serialized, formats[1]) >> fatal);
+    expect(serialized.size() == 5) << "v1 bool is 4 bytes of header and 1 byte of value";
+
+    // corrupted payload is rejected when the crc is present
+    serialized.clear();
+    expect(!packet<std::int64_t, type_e::_int64_t>::serialize(42, serialized, formats[2]) >> fatal);
+    serialized[5] ^= std::byte{ 0x10 };
+    expect(!packet<std::int64_t, type_e::_int64_t>::deserialize(std::span{ serialized }).has_value());
+
+    // wrong type and unknown version
+    serialized.clear();
+    expect(!packet<bool, type_e::_bool>::serialize(true, serialized) >> fatal);
+    expect(!packet<std::int64_t, type_e::_int64_t>::deserialize(std::span{ serialized }).has_value());
+    serialized[0] = std::byte{ 0xff };
+    expect(!packet<bool, type_e::_bool>::deserialize(std::span{ serialized }).has_value());
+
+    std::string_view constexpr check{ "123456789" };
+    expect(tfc::ipc::details::crc32c::compute(std::as_bytes(std::span{ check })) == 0xe3069283);
+  };
+
+  "record packets"_test = [] {
+    using tfc::ipc::details::schema_hash_v;
+    using tfc::ipc::details::version_e;
+    using tfc::ipc::details::wire_format;
+    static_assert(tfc::ipc::details::concepts::is_record<axis_state>);
+    static_assert(!tfc::ipc::details::concepts::is_record<std::string>);
+    static_assert(schema_hash_v<axis_state> != schema_hash_v<axis_command>);
+    static_assert(sizeof(axis_state) == sizeof(axis_command));
+
+    using state_packet_t = packet<axis_state, type_e::_struct>;
+    using trace_packet_t = packet<axis_trace, type_e::_struct>;
+    axis_state const state{ .position = -1337, .velocity = 4.2, .error = 7 };
+    axis_trace trace{};
+    trace.samples.back() = state;
+    for (auto const format : { wire_format{}, wire_format{ .version = version_e::v1 },
+                               wire_format{ .version = version_e::v1, .crc = true } }) {
+      std::vector<std::byte> serialized{};
+      expect(!state_packet_t::serialize(state, serialized, format) >> fatal);
+      expect(state_packet_t::deserialize(std::span{ serialized }).value() == state);
+
+      // more than 127 bytes, two byte varint
+      serialized.clear();
+      expect(!trace_packet_t::serialize(trace, serialized, format) >> fatal);
+      expect(trace_packet_t::deserialize(std::span{ serialized }).value() == trace);
+    }
+
+    std::vector<std::byte> serialized{};
+    expect(!state_packet_t::serialize(state, serialized, wire_format{ .version = version_e::v1 }) >> fatal);
+    static_assert(tfc::ipc::details::packed_size_v<axis_state> == 18);
+    expect(serialized.size() == 4 + sizeof(std::uint64_t) + 18)
+        << "v1 record is 4 bytes of header, the schema hash and the members without padding";
+
+    // the padding of the struct is not sent, whatever it holds
+    alignas(axis_state) std::array<std::byte, sizeof(axis_state)> storage{};
+    storage.fill(std::byte{ 0xff });
+    auto* const dirty{ new (storage.data()) axis_state };
+    dirty->position = state.position;
+    dirty->velocity = state.velocity;
+    dirty->error = state.error;
+    std::vector<std::byte> from_dirty{};
+    expect(!state_packet_t::serialize(*dirty, from_dirty, wire_format{ .version = version_e::v1 }) >> fatal);
+    expect(from_dirty == serialized);
+
+    // a record of another layout is rejected although its size matches
+    auto const mismatch{ packet<axis_command, type_e::_struct>::deserialize(std::span{ serialized }) };
+    expect(!mismatch.has_value() >> fatal);
+    expect(mismatch.error() == std::make_error_code(std::errc::wrong_protocol_type));
+  };
+
+  "steady state send does not allocate"_test = [] {
+    asio::io_context ctx;
+    auto sender = tfc::ipc::details::mass_signal_ptr::element_type::create(ctx, "steady_mass").value();
+    auto json_sender = tfc::ipc::details::json_signal_ptr::element_type::create(ctx, "steady_json").value();
+    std::string const payload(4096, 'x');
+    expect(!sender->send(1 * mp_units::si::gram));
+    expect(!json_sender->send(payload));
+    auto const warm_allocations{ sender->send_buffer_allocations() };
+    auto const warm_json_allocations{ json_sender->send_buffer_allocations() };
+    // no expect inside the measured loop, the reporter may allocate
+    bool failed{ false };
+    auto const before{ allocations.load() };
+    for (std::int64_t idx = 0; idx < 1000; idx++) {
+      failed |= static_cast<bool>(sender->send(idx * mp_units::si::gram));
+      failed |= static_cast<bool>(json_sender->send(payload));
+    }
+    auto const allocated{ allocations.load() - before };
+    expect(!failed);
+    expect(allocated == 0) << "the synchronous send path allocated " << allocated << " times";
+    expect(sender->send_buffer_allocations() == warm_allocations);
+    expect(json_sender->send_buffer_allocations() == warm_json_allocations);
+
+    std::size_t completed{};
+    for (std::int64_t idx = 0; idx < 1000; idx++) {
+      sender->async_send(idx * mp_units::si::gram, [&completed](std::error_code const& err, std::size_t) {
+        expect(!err);
+        completed++;
+      });
+      ctx.run_one_for(std::chrono::milliseconds(100));
+    }
+    ctx.run_for(std::chrono::milliseconds(5));
+    expect(completed == 1000);
+    // a single in flight send reuses the same buffer, the asio and azmq operation state is allocated by them
+    expect(sender->send_buffer_allocations() == warm_allocations);
+  };
+
   "ipc stop receiver"_test = [] {
     asio::io_context ctx;
     auto sender = tfc::ipc::details::uint_signal_ptr::element_type::create(ctx, "name").value();
@@ -136,6 +332,268 @@ auto main(int argc, char** argv) -> int {
     expect(receiver_called);
   };
 
+  "record signal to slot"_test = [] {
+    asio::io_context ctx;
+    using type_state = tfc::ipc::details::type_record<axis_state>;
+    auto sender = tfc::ipc::details::signal<type_state>::create(ctx, "axis").value();
+    auto receiver = tfc::ipc::details::slot_callback<type_state>::create(ctx, "axis");
+    std::optional<axis_state> received{};
+    receiver->connect(sender->full_name(), [&ctx, &received](axis_state const& value) {
+      received = value;
+      ctx.stop();
+    });
+    asio::steady_timer timer{ ctx };
+    timer.expires_after(std::chrono::milliseconds(1));
+    timer.async_wait([&sender](auto) { sender->send(axis_state{ .position = 1, .velocity = 2.5, .error = 3 }); });
+
+    ctx.run_for(std::chrono::seconds(1));
+    expect(received == axis_state{ .position = 1, .velocity = 2.5, .error = 3 });
+  };
+
+  "receive value larger than 4 KiB"_test = [] {
+    asio::io_context ctx;
+    auto sender = tfc::ipc::details::json_signal_ptr::element_type::create(ctx, "large_json").value();
+    auto receiver = tfc::ipc::details::json_slot_cb_ptr::element_type::create(ctx, "large_json");
+    std::string const payload{ fmt::format(R"({{"pad":"{}"}})", std::string(64 * 1024, 'x')) };
+    std::optional<std::string> received{};
+    receiver->connect(sender->full_name(), [&ctx, &received](std::string const& value) {
+      received = value;
+      ctx.stop();
+    });
+    asio::steady_timer timer{ ctx };
+    timer.expires_after(std::chrono::milliseconds(10));
+    timer.async_wait([&sender, &payload](auto) { sender->send(payload); });
+    ctx.run_for(std::chrono::seconds(1));
+    expect(received.has_value() >> fatal);
+    expect(received.value() == payload);
+  };
+
+  "shm transport"_test = [] {
+    using tfc::ipc::details::transport_e;
+    asio::io_context ctx;
+    auto sender = tfc::ipc::details::string_signal_ptr::element_type::create(ctx, "shm", transport_e::shm).value();
+    // published before the slot attaches, the segment keeps the last value for late joiners
+    expect(!sender->send("first"));
+    std::vector<std::string> received{};
+    auto receiver = tfc::ipc::details::string_slot_cb_ptr::element_type::create(ctx, "shm", transport_e::shm);
+    expect(!receiver->connect(sender->full_name(), [&ctx, &received](std::string const& value) {
+      received.emplace_back(value);
+      if (received.size() == 2) {
+        ctx.stop();
+      }
+    }));
+    asio::steady_timer timer{ ctx };
+    timer.expires_after(std::chrono::milliseconds(10));
+    timer.async_wait([&sender](auto) { sender->send(std::string(8192, 'x')); });
+    ctx.run_for(std::chrono::seconds(1));
+    expect((received.size() == 2) >> fatal);
+    expect(received[0] == "first");
+    expect(received[1] == std::string(8192, 'x'));
+
+    // the reader thread sleeps on the futex by now, stopping it wakes it instead of waiting out the poll interval
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto const stop_start{ std::chrono::steady_clock::now() };
+    receiver->disconnect(sender->full_name());
+    expect(std::chrono::steady_clock::now() - stop_start < std::chrono::milliseconds(25));
+  };
+
+  "late joiners receive only the last value"_test = [] {
+    asio::io_context ctx;
+    auto sender = tfc::ipc::details::uint_signal_ptr::element_type::create(ctx, "late_joiner").value();
+    expect(!sender->send(1));
+    expect(!sender->send(2));
+
+    auto const connect{ [&ctx, &sender](std::vector<std::uint64_t>& received) {
+      auto receiver = tfc::ipc::details::uint_slot_cb_ptr::element_type::create(ctx, "late_joiner");
+      expect(!receiver->connect(sender->full_name(), [&received](std::uint64_t value) { received.emplace_back(value); }));
+      return receiver;
+    } };
+    std::vector<std::uint64_t> first{};
+    auto first_receiver{ connect(first) };
+    ctx.run_for(std::chrono::milliseconds(20));
+    expect(first == std::vector<std::uint64_t>{ 2 });
+
+    // a second subscriber joining does not replay the value to the first one
+    std::vector<std::uint64_t> second{};
+    auto second_receiver{ connect(second) };
+    ctx.run_for(std::chrono::milliseconds(20));
+    expect(second == std::vector<std::uint64_t>{ 2 });
+    expect(first == std::vector<std::uint64_t>{ 2 });
+
+    // a value sent after the welcome was set is what the next joiner receives
+    expect(!sender->send(3));
+    ctx.run_for(std::chrono::milliseconds(20));
+    std::vector<std::uint64_t> third{};
+    auto third_receiver{ connect(third) };
+    ctx.run_for(std::chrono::milliseconds(20));
+    expect(third == std::vector<std::uint64_t>{ 3 });
+    expect(first == std::vector<std::uint64_t>{ 2, 3 });
+  };
+
+  "signals send v0 until every subscriber advertises v1"_test = [] {
+    using tfc::ipc::details::version_e;
+    asio::io_context ctx;
+    auto sender = tfc::ipc::details::uint_signal_ptr::element_type::create(ctx, "negotiate").value();
+    expect(sender->effective_wire_format().version == version_e::v0);
+
+    std::vector<std::uint64_t> received{};
+    auto receiver = tfc::ipc::details::uint_slot_cb_ptr::element_type::create(ctx, "negotiate");
+    expect(!receiver->connect(sender->full_name(), [&received](std::uint64_t value) { received.emplace_back(value); }));
+    ctx.run_for(std::chrono::milliseconds(20));
+    expect(sender->effective_wire_format().version == version_e::v1);
+
+    {
+      // a subscriber of an older release only subscribes to ""
+      azmq::sub_socket legacy{ ctx };
+      legacy.connect(sender->endpoint());
+      legacy.set_option(azmq::socket::subscribe(""));
+      ctx.run_for(std::chrono::milliseconds(20));
+      expect(sender->effective_wire_format().version == version_e::v0);
+
+      expect(!sender->send(7));
+      ctx.run_for(std::chrono::milliseconds(20));
+      std::array<std::byte, 64> buffer{};
+      boost::system::error_code code{};
+      auto const size{ legacy.receive(asio::buffer(buffer), ZMQ_DONTWAIT, code) };
+      expect((!code && size > 0) >> fatal);
+      expect(buffer.front() == std::byte{ std::to_underlying(version_e::v0) });
+      expect(received == std::vector<std::uint64_t>{ 7 });
+    }
+
+    // the closed pipe unsubscribes
+    ctx.run_for(std::chrono::milliseconds(20));
+    expect(sender->effective_wire_format().version == version_e::v1);
+    expect(!sender->send(8));
+    ctx.run_for(std::chrono::milliseconds(20));
+    expect(received == std::vector<std::uint64_t>{ 7, 8 });
+  };
+
+  "reconnect storm of 500 slots"_test = [] {
+    constexpr std::size_t slot_count{ 500 };
+    asio::io_context ctx;
+    auto sender = tfc::ipc::details::uint_signal_ptr::element_type::create(ctx, "storm").value();
+    expect(!sender->send(42));
+
+    std::vector<std::shared_ptr<tfc::ipc::details::slot_callback<tfc::ipc::details::type_uint>>> receivers{};
+    receivers.reserve(slot_count);
+    // deliveries per slot, a joiner must not make the signal send again to slots already connected
+    std::vector<std::size_t> deliveries(slot_count);
+    std::size_t received{};
+    auto const start{ std::chrono::steady_clock::now() };
+    for (std::size_t idx = 0; idx < slot_count; idx++) {
+      receivers.emplace_back(tfc::ipc::details::uint_slot_cb_ptr::element_type::create(ctx, "storm"));
+      expect(!receivers.back()->connect(sender->full_name(), [&deliveries, &received, idx](std::uint64_t value) {
+        expect(value == 42);
+        deliveries[idx]++;
+        received++;
+      }));
+    }
+    auto const deadline{ start + std::chrono::seconds(10) };
+    while (received < slot_count && std::chrono::steady_clock::now() < deadline) {
+      ctx.run_one_for(std::chrono::milliseconds(10));
+    }
+    auto const elapsed{ std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start) };
+    fmt::println("reconnect storm of {} slots took {}", slot_count, elapsed);
+    expect(received == slot_count) << "received" << received << "of" << slot_count;
+
+    // nothing more arrives once every slot got the last value
+    ctx.run_for(std::chrono::milliseconds(50));
+    expect(received == slot_count) << "received" << received << "of" << slot_count;
+    expect(std::ranges::all_of(deliveries, [](std::size_t count) { return count == 1; }));
+  };
+
+  "dbus mirror policy"_test = [] {
+    using tfc::ipc::details::mirror_e;
+    using tfc::ipc::details::mirror_policy;
+    auto ctx{ asio::io_context() };
+    tfc::ipc_ruler::ipc_manager_client_mock ipc_client{ ctx };
+    tfc::ipc::signal<tfc::ipc::details::type_uint, tfc::ipc_ruler::ipc_manager_client_mock&> sender{ ctx, ipc_client,
+                                                                                                    "mirrored" };
+    for (std::uint64_t idx = 0; idx < 10; idx++) {
+      expect(!sender.send(idx));
+    }
+    expect(sender.dbus_suppressed() == 0);
+
+    sender.set_dbus_mirror({ .mode = mirror_e::property_only });
+    for (std::uint64_t idx = 0; idx < 10; idx++) {
+      expect(!sender.send(idx));
+    }
+    expect(sender.dbus_suppressed() == 10);
+
+    sender.set_dbus_mirror(mirror_policy::max_rate(1.0));
+    for (std::uint64_t idx = 0; idx < 10; idx++) {
+      expect(!sender.send(idx));
+    }
+    // first value is emitted, the last one is pending and the rest are coalesced
+    expect(sender.dbus_suppressed() == 18);
+
+    // the pending value is dropped when mirroring is turned off
+    sender.set_dbus_mirror({ .mode = mirror_e::off });
+    expect(sender.dbus_suppressed() == 19);
+    expect(!sender.send(42));
+    expect(sender.dbus_suppressed() == 20);
+
+    expect(boost::ut::throws([] { mirror_policy::max_rate(0.0); }));
+    expect(boost::ut::throws([] { mirror_policy::max_rate(-1.0); }));
+  };
+
+  "a moved signal keeps its pending dbus mirror"_test = [] {
+    using tfc::ipc::details::mirror_policy;
+    auto ctx{ asio::io_context() };
+    tfc::ipc_ruler::ipc_manager_client_mock ipc_client{ ctx };
+    using signal_t = tfc::ipc::signal<tfc::ipc::details::type_uint, tfc::ipc_ruler::ipc_manager_client_mock&>;
+    auto sender{ std::make_unique<signal_t>(ctx, ipc_client, "moved_mirror") };
+    sender->set_dbus_mirror(mirror_policy::max_rate(100.0));
+    expect(!sender->send(1));
+    expect(!sender->send(2));  // pending on the rate timer
+    expect(sender->dbus_emitted() == 1);
+    signal_t moved{ std::move(*sender) };
+    sender.reset();
+    ctx.run_for(std::chrono::milliseconds(30));
+    // the value coalesced before the move is emitted by the timer of the moved signal
+    expect(moved.dbus_emitted() == 2);
+    expect(moved.dbus_suppressed() == 0);
+    expect(!moved.send(3));
+    expect(moved.dbus_emitted() == 3);
+  };
+
+  "dbus mirror policy of the process"_test = [&argc, &argv] {
+    using tfc::ipc::details::mirror_e;
+    auto ctx{ asio::io_context() };
+    tfc::ipc_ruler::ipc_manager_client_mock ipc_client{ ctx };
+    using signal_t = tfc::ipc::signal<tfc::ipc::details::type_uint, tfc::ipc_ruler::ipc_manager_client_mock&>;
+    using slot_t = tfc::ipc::slot<tfc::ipc::details::type_uint, tfc::ipc_ruler::ipc_manager_client_mock&>;
+
+    std::array<char const*, 6> const rate_limited{ argv[0], "--dbus-mirror", "rate_limited", "--dbus-mirror-rate", "4",
+                                                   nullptr };
+    tfc::base::init(5, rate_limited.data());
+    {
+      signal_t sender{ ctx, ipc_client, "process_mirror" };
+      slot_t receiver{ ctx, ipc_client, "process_mirror", "desc", [](auto const&) {} };
+      expect(sender.dbus_mirror().mode == mirror_e::rate_limited);
+      expect(sender.dbus_mirror().min_interval == std::chrono::milliseconds(250));
+      expect(receiver.dbus_mirror().mode == mirror_e::rate_limited);
+      // a signal still overrides the process wide policy
+      sender.set_dbus_mirror({ .mode = mirror_e::off });
+      expect(sender.dbus_mirror().mode == mirror_e::off);
+    }
+
+    std::array<char const*, 4> const property_only{ argv[0], "--dbus-mirror", "property_only", nullptr };
+    tfc::base::init(3, property_only.data());
+    {
+      signal_t sender{ ctx, ipc_client, "process_mirror" };
+      expect(!sender.send(1));
+      expect(sender.dbus_emitted() == 0);
+      expect(sender.dbus_suppressed() == 1);
+    }
+
+    std::array<char const*, 4> const unknown{ argv[0], "--dbus-mirror", "sometimes", nullptr };
+    tfc::base::init(3, unknown.data());
+    expect(boost::ut::throws([&] { signal_t{ ctx, ipc_client, "process_mirror" }; }));
+
+    tfc::base::init(argc, argv);
+  };
+
   "code_example"_test = []() {
     auto ctx{ asio::io_context() };
     auto sender{ tfc::ipc::details::string_signal_ptr::element_type::create(ctx, "name").value() };
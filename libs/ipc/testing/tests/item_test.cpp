@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <boost/ut.hpp>
+
+#include <tfc/ipc/item.hpp>
+#include <tfc/ipc/item_binary.hpp>
+#include <tfc/progbase.hpp>
+
+namespace ut = boost::ut;
+namespace item = tfc::ipc::item;
+
+using ut::operator""_test;
+using ut::operator>>;
+using ut::expect;
+using ut::fatal;
+using item::binary::field_e;
+
+namespace {
+auto make_tub(std::size_t children) -> item::item {
+  auto tub{ item::make() };
+  tub.barcode = "5701234567890";
+  tub.category = item::details::category_e::tub;
+  tub.fao_species = item::fao::atlantic_cod;
+  tub.item_weight = std::int64_t{ 25000000 } * item::item::milligram_64bit::reference;
+  tub.color = item::details::color{ .red = 10, .green = 20, .blue = 30 };
+  tub.quality = item::details::quality_e::superior;
+  tub.supplier = item::details::supplier{ .name = "Vessel", .contact_info = "+354 000 0000", .country = "IS" };
+  tub.destination = item::details::destination{};
+  auto& fishes{ tub.items.emplace() };
+  for (std::size_t idx = 0; idx < children; idx++) {
+    auto& fish{ fishes.emplace_back(item::make()) };
+    fish.fao_species = item::fao::haddock;
+    fish.item_weight = static_cast<std::int64_t>(1000 + idx) * item::item::milligram_64bit::reference;
+  }
+  return tub;
+}
+}  // namespace
+
+auto main(int argc, char** argv) -> int {
+  tfc::base::init(argc, argv);
+
+  "binary round trip keeps absent fields absent"_test = [] {
+    auto const tub{ make_tub(3) };
+    auto const bytes{ tub.to_binary() };
+    auto const view{ item::binary::view::parse(bytes) };
+    expect(view.has_value() >> fatal);
+    auto const decoded{ view->to_item() };
+    expect(decoded.has_value() >> fatal);
+    expect(decoded.value() == tub);
+    expect(!decoded->qr_code.has_value());
+    expect(!decoded->batch_id.has_value());
+
+    auto const received{ item::item::from_binary(bytes) };
+    expect(received.has_value() >> fatal);
+    expect(received->items == tub.items);
+    expect(received->last_exchange >= tub.last_exchange) << "receiving an item updates its last exchange";
+  };
+
+  "binary view reads fields lazily"_test = [] {
+    auto const tub{ make_tub(10) };
+    auto const bytes{ tub.to_binary() };
+    auto const view{ item::binary::view::parse(bytes) };
+    expect(view.has_value() >> fatal);
+    expect(view->get<field_e::barcode>() == std::string_view{ "5701234567890" });
+    expect(view->get<field_e::item_weight>() == tub.item_weight);
+    expect(view->get<field_e::supplier>() == tub.supplier);
+    expect(!view->has(field_e::qr_code));
+    expect(!view->get<field_e::qr_code>().has_value());
+
+    auto const children{ view->items() };
+    expect(children.size() == 10);
+    std::size_t idx{};
+    for (auto const child : children) {
+      expect(child.has_value() >> fatal);
+      expect(child->get<field_e::item_weight>() == tub.items->at(idx).item_weight);
+      expect(child->items().empty());
+      idx++;
+    }
+    expect(idx == 10);
+  };
+
+  "binary encoding is smaller than json"_test = [] {
+    auto const tub{ make_tub(10) };
+    expect(tub.to_binary().size() < tub.to_json().value().size());
+    item::item const empty{};
+    expect(empty.to_binary().size() == item::binary::header_size);
+  };
+
+  "malformed binary is rejected"_test = [] {
+    auto bytes{ make_tub(2).to_binary() };
+    for (std::size_t size = 0; size < bytes.size(); size++) {
+      expect(!item::item::from_binary(std::span{ bytes }.first(size)).has_value()) << "truncated to" << size;
+    }
+    bytes.front() = std::byte{ 0xff };
+    expect(item::binary::view::parse(bytes).error() == std::make_error_code(std::errc::protocol_not_supported));
+  };
+
+  return 0;
+}
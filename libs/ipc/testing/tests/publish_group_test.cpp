@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdint>
+#include <system_error>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/ut.hpp>
+
+#include <tfc/ipc/publish_group.hpp>
+
+namespace asio = boost::asio;
+namespace ut = boost::ut;
+
+using ut::operator""_test;
+using ut::expect;
+
+namespace {
+template <typename value_type>
+struct fake_signal {
+  using value_t = value_type;
+  auto send(value_t const& value) -> std::error_code {
+    sent.emplace_back(value);
+    return error;
+  }
+  std::vector<value_t> sent{};
+  std::error_code error{};
+};
+}  // namespace
+
+auto main() -> int {
+  "flush publishes staged values once"_test = [] {
+    asio::io_context ctx{};
+    tfc::ipc::publish_group group{ ctx };
+    fake_signal<bool> first{};
+    fake_signal<double> second{};
+    auto& staged_first{ group.add(first) };
+    auto& staged_second{ group.add(second) };
+    staged_first.stage(true);
+    staged_second.stage(1.0);
+    staged_second.stage(2.0);
+    expect(group.pending() == 2);
+    expect(first.sent.empty() && second.sent.empty());
+    expect(!group.flush());
+    expect(first.sent == std::vector{ true });
+    expect(second.sent == std::vector{ 2.0 });
+    expect(group.pending() == 0);
+    expect(group.metrics().batches == 1);
+    expect(group.metrics().values == 2);
+    expect(group.metrics().coalesced == 1);
+    expect(group.metrics().largest_batch == 2);
+    // nothing staged, nothing sent
+    expect(!group.flush());
+    expect(group.metrics().batches == 1);
+  };
+
+  "errors are reported and counted"_test = [] {
+    asio::io_context ctx{};
+    tfc::ipc::publish_group group{ ctx };
+    fake_signal<bool> failing{ .error = std::make_error_code(std::errc::value_too_large) };
+    fake_signal<bool> working{};
+    group.add(failing).stage(true);
+    group.add(working).stage(true);
+    expect(group.flush() == std::errc::value_too_large);
+    expect(working.sent.size() == 1);
+    expect(group.metrics().errors == 1);
+  };
+
+  "unflushed batch is published after max latency"_test = [] {
+    asio::io_context ctx{};
+    tfc::ipc::publish_group group{ ctx, std::chrono::milliseconds(2) };
+    fake_signal<std::uint64_t> signal{};
+    group.add(signal).stage(42);
+    ctx.run_for(std::chrono::milliseconds(20));
+    expect(signal.sent == std::vector<std::uint64_t>{ 42 });
+    expect(group.metrics().deadline_flushes == 1);
+  };
+
+  "a flushed batch does not leave the deadline armed"_test = [] {
+    asio::io_context ctx{};
+    tfc::ipc::publish_group group{ ctx, std::chrono::milliseconds(2) };
+    fake_signal<std::uint64_t> signal{};
+    auto& staged{ group.add(signal) };
+    staged.stage(1);
+    expect(!group.flush());
+    // only the cancelled wait completes, no timer expiry
+    expect(ctx.run_for(std::chrono::milliseconds(20)) == 1);
+    expect(group.metrics().deadline_flushes == 0);
+
+    // the next batch gets a full max latency of its own
+    ctx.restart();
+    staged.stage(2);
+    ctx.run_for(std::chrono::milliseconds(20));
+    expect(signal.sent == std::vector<std::uint64_t>{ 1, 2 });
+    expect(group.metrics().deadline_flushes == 1);
+  };
+
+  return 0;
+}
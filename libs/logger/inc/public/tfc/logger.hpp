@@ -63,43 +63,63 @@ public:
   // clang-format off
   template <lvl_e log_level, typename t1>
   void log(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    }
   }
   template <lvl_e log_level, typename t1, typename t2>
   void log(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    }
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3>
   void log(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    }
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4>
   void log(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    }
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5>
   void log(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    }
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void log(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    }
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void log(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    }
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void log(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    }
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void log(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    }
   }
   template <lvl_e log_level, typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
   void log(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    if (is_enabled(log_level)) {
+      log_(log_level, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    }
   }
 
   void trace(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -107,43 +127,63 @@ public:
   }
   template <typename t1>
   void trace(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    }
   }
   template <typename t1, typename t2>
   void trace(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3>
   void trace(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void trace(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void trace(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void trace(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void trace(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void trace(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void trace(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
   void trace(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    if (is_enabled(lvl_e::trace)) {
+      log_(lvl_e::trace, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    }
   }
 
   void debug(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -151,43 +191,63 @@ public:
   }
   template <typename t1>
   void debug(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    }
   }
   template <typename t1, typename t2>
   void debug(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3>
   void debug(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void debug(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void debug(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void debug(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void debug(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void debug(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void debug(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
   void debug(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    if (is_enabled(lvl_e::debug)) {
+      log_(lvl_e::debug, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    }
   }
 
   void info(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -195,43 +255,63 @@ public:
   }
   template <typename t1>
   void info(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    }
   }
   template <typename t1, typename t2>
   void info(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3>
   void info(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void info(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void info(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void info(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void info(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void info(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void info(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
   void info(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    if (is_enabled(lvl_e::info)) {
+      log_(lvl_e::info, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    }
   }
 
   void warn(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -239,43 +319,63 @@ public:
   }
   template <typename t1>
   void warn(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    }
   }
   template <typename t1, typename t2>
   void warn(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3>
   void warn(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void warn(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void warn(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void warn(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void warn(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void warn(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void warn(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
   void warn(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    if (is_enabled(lvl_e::warn)) {
+      log_(lvl_e::warn, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    }
   }
 
   void error(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -283,43 +383,63 @@ public:
   }
   template <typename t1>
   void error(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    }
   }
   template <typename t1, typename t2>
   void error(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3>
   void error(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void error(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void error(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void error(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void error(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void error(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void error(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
   void error(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    if (is_enabled(lvl_e::error)) {
+      log_(lvl_e::error, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    }
   }
 
   void critical(std::string_view msg, std::source_location loc = std::source_location::current()) const {
@@ -327,43 +447,63 @@ public:
   }
   template <typename t1>
   void critical(fmt::format_string<t1> msg, t1&& p1, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1)), loc);
+    }
   }
   template <typename t1, typename t2>
   void critical(fmt::format_string<t1, t2> msg, t1&& p1, t2&& p2, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3>
   void critical(fmt::format_string<t1, t2, t3> msg, t1&& p1, t2&& p2, t3&& p3, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4>
   void critical(fmt::format_string<t1, t2, t3, t4> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5>
   void critical(fmt::format_string<t1, t2, t3, t4, t5> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6>
   void critical(fmt::format_string<t1, t2, t3, t4, t5, t6> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7>
   void critical(fmt::format_string<t1, t2, t3, t4, t5, t6, t7> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8>
   void critical(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9>
   void critical(fmt::format_string<t1, t2, t3, t4, t5, t6, t7, t8, t9> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9)), loc);
+    }
   }
   template <typename t1, typename t2, typename t3, typename t4, typename t5, typename t6, typename t7, typename t8, typename t9, typename t10>
   void critical(fmt::format_string<t1, t2, t3, t4, t4, t5, t6, t7, t8, t9, t10> msg, t1&& p1, t2&& p2, t3&& p3, t4&& p4, t5&& p5, t6&& p6, t7&& p7, t8&& p8, t9&& p9, t10&& p10, std::source_location loc = std::source_location::current()) const {
-    log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    if (is_enabled(lvl_e::critical)) {
+      log_(lvl_e::critical, fmt::vformat(msg, fmt::make_format_args(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10)), loc);
+    }
   }
 
   /**
@@ -372,6 +512,13 @@ public:
    * */
   void set_loglevel(lvl_e log_level);
 
+  /**
+   * @brief Check if messages of a level are emitted
+   * The formatting overloads check it before formatting, so arguments are only formatted for emitted messages.
+   * @param log_level level to check
+   * */
+  [[nodiscard]] auto is_enabled(lvl_e log_level) const noexcept -> bool;
+
 private:
   /**
    * @brief Log messages
@@ -71,3 +71,6 @@ void tfc::logger::logger::log_(lvl_e log_lvl, std::string_view msg, std::source_
 void tfc::logger::logger::set_loglevel(tfc::logger::lvl_e log_level) {
   async_logger_->set_level(static_cast<spdlog::level::level_enum>(log_level));
 }
+auto tfc::logger::logger::is_enabled(tfc::logger::lvl_e log_level) const noexcept -> bool {
+  return async_logger_->should_log(static_cast<spdlog::level::level_enum>(log_level));
+}
@@ -1,10 +1,22 @@
 #include <boost/ut.hpp>
+#include <cstddef>
 #include <string_view>
 #include "tfc/logger.hpp"
 #include "tfc/progbase.hpp"
 
 using std::string_view_literals::operator""sv;
 
+namespace {
+/// \brief counts how often it is formatted
+struct format_counter {
+  std::size_t& count;
+};
+auto format_as(format_counter const& value) -> std::string_view {
+  value.count++;
+  return "counted";
+}
+}  // namespace
+
 auto main(int argc, char** argv) -> int {
   using boost::ut::operator""_test;
   using boost::ut::expect;
@@ -29,4 +41,26 @@ auto main(int argc, char** argv) -> int {
 
     expect(true);
   };
+
+  "is enabled follows the log level"_test = [] {
+    tfc::logger::logger foo("key");
+    foo.set_loglevel(tfc::logger::lvl_e::info);
+    expect(!foo.is_enabled(tfc::logger::lvl_e::trace));
+    expect(foo.is_enabled(tfc::logger::lvl_e::info));
+    expect(foo.is_enabled(tfc::logger::lvl_e::error));
+    foo.set_loglevel(tfc::logger::lvl_e::trace);
+    expect(foo.is_enabled(tfc::logger::lvl_e::trace));
+  };
+
+  "disabled messages are not formatted"_test = [] {
+    tfc::logger::logger foo("key");
+    foo.set_loglevel(tfc::logger::lvl_e::info);
+    std::size_t count{};
+    foo.trace("{}", format_counter{ count });
+    foo.debug("{}", format_counter{ count });
+    foo.log<tfc::logger::lvl_e::debug>("{}", format_counter{ count });
+    expect(count == 0);
+    foo.info("{}", format_counter{ count });
+    expect(count == 1);
+  };
 }
@@ -46,6 +46,14 @@ void init(int argc, char const* const* argv);
 /// \return log level
 [[nodiscard]] auto get_log_lvl() noexcept -> tfc::logger::lvl_e;
 
+/// \brief default value is "every_value"
+/// \return how signals and slots of the process mirror values on D-Bus, see tfc::ipc::details::process_mirror_policy
+[[nodiscard]] auto get_dbus_mirror() noexcept -> std::string_view;
+
+/// \brief default value is 10
+/// \return maximum D-Bus signals per second of each signal and slot when the mirror is rate_limited
+[[nodiscard]] auto get_dbus_mirror_rate() noexcept -> double;
+
 /// \return boost variables map if needed to get custom parameters from description
 [[nodiscard]] auto get_map() noexcept -> boost::program_options::variables_map const&;
 
@@ -58,6 +66,15 @@ void init(int argc, char const* const* argv);
 /// \return <config_directory><exe_name>/<proc_name>/<filename>.<file_extension>
 [[nodiscard]] auto make_config_file_name(std::string_view filename, std::string_view extension) -> std::filesystem::path;
 
+/// \return State directory path, for data a process keeps across restarts which is not configuration
+/// default return value is /var/lib/tfc/
+/// \note can be changed by providing environment variable STATE_DIRECTORY
+/// Refer to https://www.freedesktop.org/software/systemd/man/systemd.exec.html#%24RUNTIME_DIRECTORY
+[[nodiscard]] auto get_state_directory() -> std::filesystem::path;
+
+/// \return <state_directory><exe_name>/<proc_name>/<filename>.<file_extension>
+[[nodiscard]] auto make_state_file_name(std::string_view filename, std::string_view extension) -> std::filesystem::path;
+
 /// \brief supposed to be used by logger library to indicate log to terminal is enabled
 [[nodiscard]] auto is_stdout_enabled() noexcept -> bool;
 
@@ -34,6 +34,8 @@ public:
     id_ = vm_["id"].as<std::string>();
     stdout_ = vm_["stdout"].as<bool>();
     noeffect_ = vm_["noeffect"].as<bool>();
+    dbus_mirror_ = vm_["dbus-mirror"].as<std::string>();
+    dbus_mirror_rate_ = vm_["dbus-mirror-rate"].as<double>();
     if (vm_["version"].as<bool>()) {
       std::stringstream out;
       desc.print(out);
@@ -70,6 +72,8 @@ public:
   [[nodiscard]] auto get_stdout() const noexcept -> bool { return stdout_; }
   [[nodiscard]] auto get_noeffect() const noexcept -> bool { return noeffect_; }
   [[nodiscard]] auto get_log_lvl() const noexcept -> logger::lvl_e { return log_level_; }
+  [[nodiscard]] auto get_dbus_mirror() const noexcept -> std::string_view { return dbus_mirror_; }
+  [[nodiscard]] auto get_dbus_mirror_rate() const noexcept -> double { return dbus_mirror_rate_; }
 
 private:
   options() = default;
@@ -77,6 +81,8 @@ private:
   bool stdout_{ false };
   std::string id_{};
   std::string exe_name_{};
+  std::string dbus_mirror_{ "every_value" };
+  double dbus_mirror_rate_{ 10.0 };
   bpo::variables_map vm_{};
   logger::lvl_e log_level_{};
   std::string extra_description_{};
@@ -101,6 +107,10 @@ auto default_description() -> boost::program_options::options_description {
       "noeffect", bpo::bool_switch()->default_value(false), "Process will not send any IPCs.")(
       "stdout", bpo::bool_switch()->default_value(false), "Logs displayed both in terminal and journal.")(
       "log-level", bpo::value<std::string>()->default_value("info"), fmt::format("Set log level ({})", help_text).c_str())(
+      "dbus-mirror", bpo::value<std::string>()->default_value("every_value"),
+      "How signals and slots of the process mirror values on D-Bus (every_value rate_limited property_only off).")(
+      "dbus-mirror-rate", bpo::value<double>()->default_value(10.0),
+      "Maximum D-Bus signals per second of each signal and slot when --dbus-mirror is rate_limited.")(
       "version,v", bpo::bool_switch()->default_value(false), "Print version information");
   return description;
 }
@@ -129,6 +139,14 @@ auto get_log_lvl() noexcept -> tfc::logger::lvl_e {
   return options::instance().get_log_lvl();
 }
 
+auto get_dbus_mirror() noexcept -> std::string_view {
+  return options::instance().get_dbus_mirror();
+}
+
+auto get_dbus_mirror_rate() noexcept -> double {
+  return options::instance().get_dbus_mirror_rate();
+}
+
 auto get_map() noexcept -> boost::program_options::variables_map const& {
   return options::instance().get_map();
 }
@@ -149,6 +167,22 @@ auto make_config_file_name(std::string_view filename, std::string_view extension
   return config_dir / get_exe_name() / get_proc_name() / filename_path;
 }
 
+auto get_state_directory() -> std::filesystem::path {
+  if (auto const* state_dir{ std::getenv("STATE_DIRECTORY") }) {
+    return std::filesystem::path{ state_dir };
+  }
+  return std::filesystem::path{ "/var/lib/tfc/" };
+}
+
+auto make_state_file_name(std::string_view filename, std::string_view extension) -> std::filesystem::path {
+  auto state_dir{ get_state_directory() };
+  std::string filename_path{ filename };
+  if (!extension.empty()) {
+    filename_path.append(".").append(extension);
+  }
+  return state_dir / get_exe_name() / get_proc_name() / filename_path;
+}
+
 auto is_stdout_enabled() noexcept -> bool {
   return options::instance().get_stdout();
 }
@@ -1,3 +1,5 @@
+#include <cstdlib>
+
 #include <boost/program_options.hpp>
 #include <boost/ut.hpp>
 #include <tfc/progbase.hpp>
@@ -44,6 +46,29 @@ auto main(int argc, char** argv) -> int {
     expect(tfc::base::is_noeffect_enabled());
   };
 
+  "default_dbus_mirror"_test = [&argc, &argv]() {
+    tfc::base::init(argc, argv, tfc::base::default_description());
+    expect(tfc::base::get_dbus_mirror() == "every_value");
+    expect(tfc::base::get_dbus_mirror_rate() == 10.0);
+  };
+  "dbus_mirror"_test = []() {
+    constexpr std::array<const char*, 6> argv_test(
+        { "foo", "--dbus-mirror", "rate_limited", "--dbus-mirror-rate", "2.5", nullptr });
+    tfc::base::init(5, argv_test.data(), tfc::base::default_description());
+    expect(tfc::base::get_dbus_mirror() == "rate_limited");
+    expect(tfc::base::get_dbus_mirror_rate() == 2.5);
+  };
+
+  "state_file_name"_test = []() {
+    constexpr std::array<const char*, 4> argv_test({ "foo", "--id", "bar", nullptr });
+    tfc::base::init(3, argv_test.data(), tfc::base::default_description());
+    unsetenv("STATE_DIRECTORY");
+    expect(tfc::base::make_state_file_name("buffer", "") == "/var/lib/tfc/foo/bar/buffer");
+    setenv("STATE_DIRECTORY", "/tmp/state", 1);
+    expect(tfc::base::make_state_file_name("buffer", "log") == "/tmp/state/foo/bar/buffer.log");
+    unsetenv("STATE_DIRECTORY");
+  };
+
   "custom_options"_test = []() {
     constexpr std::array<const char*, 4> argv_test({ "foo", "--bar", "value", nullptr });
     auto desc{ tfc::base::default_description() };